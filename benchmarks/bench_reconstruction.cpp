@@ -0,0 +1,519 @@
+#include "DelimiterScanner.hpp"
+#include "OrderIndex.hpp"
+#include "CsvReader.hpp"
+#include "CsvWriter.hpp"
+#include "BinaryMbpWriter.hpp"
+#include "BinaryMbpReader.hpp"
+#include "Utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @file bench_reconstruction.cpp
+ * @brief Microbenchmarks for the reconstruction pipeline
+ * 
+ * Each benchmark runs against an in-memory copy of an MBO file (mbo.csv by
+ * default) repeated until it is large enough to swamp the caches, and
+ * reports throughput next to the implementation it is meant to replace.
+ * 
+ * Usage: ./run_benchmarks [input_mbo.csv]
+ */
+
+namespace {
+
+// Target size of the in-memory benchmark input
+constexpr size_t BENCH_INPUT_BYTES = 64 * 1024 * 1024;
+
+// Keeps results observable so the optimizer cannot drop the work
+volatile size_t bench_sink = 0;
+
+// Order index churn: resting orders kept live, and add+cancel+lookup rounds
+constexpr size_t INDEX_LIVE_ORDERS = 200000;
+constexpr size_t INDEX_CHURN_ROUNDS = 4000000;
+
+// Order index growth: keys inserted from empty, timed in batches
+constexpr size_t INDEX_GROWTH_KEYS = 4000000;
+constexpr size_t INDEX_GROWTH_BATCH = 1024;
+
+// MBP output: rows from the input file, repeated up to this count
+constexpr size_t OUTPUT_BENCH_ROWS = 500000;
+
+// Book depth: input events replayed (whole passes over the file) up to this count
+constexpr size_t DEPTH_BENCH_EVENTS = 2000000;
+
+// Writers are timed against the null device, so disk writeback does not
+// drown out the formatting cost
+#ifdef _WIN32
+const char* const NULL_DEVICE = "NUL";
+#else
+const char* const NULL_DEVICE = "/dev/null";
+#endif
+
+/**
+ * @brief Load the MBO file and repeat its data lines up to BENCH_INPUT_BYTES
+ */
+std::string load_bench_input(const std::string& filename) {
+    std::ifstream input(filename, std::ios::in | std::ios::binary);
+    if (!input.is_open()) {
+        return "";
+    }
+    
+    std::ostringstream contents;
+    contents << input.rdbuf();
+    std::string file_data = contents.str();
+    
+    size_t header_end = file_data.find('\n');
+    if (header_end == std::string::npos) {
+        return file_data;
+    }
+    
+    std::string body = file_data.substr(header_end + 1);
+    std::string result = file_data.substr(0, header_end + 1);
+    result.reserve(BENCH_INPUT_BYTES + file_data.size());
+    
+    while (!body.empty() && result.size() < BENCH_INPUT_BYTES) {
+        result += body;
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Print one benchmark result line in GB/s
+ */
+void report_throughput(const std::string& name, size_t bytes, double elapsed_ms) {
+    double gb_per_sec = elapsed_ms > 0.0 ? (bytes / 1e9) / (elapsed_ms / 1000.0) : 0.0;
+    std::cout << "  " << std::left << std::setw(32) << name << std::right
+              << std::fixed << std::setprecision(3) << std::setw(10) << elapsed_ms << " ms  "
+              << std::setprecision(2) << std::setw(8) << gb_per_sec << " GB/s" << std::endl;
+}
+
+/**
+ * @brief Print one benchmark result line in millions of operations per second
+ */
+void report_rate(const std::string& name, size_t operations, double elapsed_ms) {
+    double mops = elapsed_ms > 0.0 ? (operations / 1e6) / (elapsed_ms / 1000.0) : 0.0;
+    std::cout << "  " << std::left << std::setw(32) << name << std::right
+              << std::fixed << std::setprecision(3) << std::setw(10) << elapsed_ms << " ms  "
+              << std::setprecision(2) << std::setw(8) << mops << " Mops/s" << std::endl;
+}
+
+/**
+ * @brief Deterministic xorshift generator so both containers see the same keys
+ */
+struct BenchRandom {
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+/**
+ * @brief Adapter giving std::unordered_map the OrderIndex interface
+ */
+struct UnorderedMapIndex {
+    std::unordered_map<uint64_t, uint32_t> map;
+    
+    uint32_t* find(uint64_t key) {
+        auto iter = map.find(key);
+        return iter != map.end() ? &iter->second : nullptr;
+    }
+    void insert_or_assign(uint64_t key, uint32_t value) { map[key] = value; }
+    bool erase(uint64_t key) { return map.erase(key) != 0; }
+    size_t size() const { return map.size(); }
+};
+
+/**
+ * @brief Add/cancel churn at a steady number of live orders
+ * Each round adds a new order, looks up a live one and cancels a random live one
+ */
+template <typename IndexT>
+void bench_index_churn(const std::string& name) {
+    IndexT index;
+    BenchRandom random;
+    std::vector<uint64_t> live_ids;
+    live_ids.reserve(INDEX_LIVE_ORDERS);
+    
+    // Order ids increase with small random gaps, like exchange-assigned ids
+    uint64_t next_id = 7000000000000000000ULL;
+    for (size_t i = 0; i < INDEX_LIVE_ORDERS; ++i) {
+        next_id += 1 + random.next() % 64;
+        index.insert_or_assign(next_id, static_cast<uint32_t>(i));
+        live_ids.push_back(next_id);
+    }
+    
+    Utils::Timer timer("");
+    size_t hits = 0;
+    
+    for (size_t round = 0; round < INDEX_CHURN_ROUNDS; ++round) {
+        next_id += 1 + random.next() % 64;
+        index.insert_or_assign(next_id, static_cast<uint32_t>(round));
+        
+        size_t victim = random.next() % live_ids.size();
+        hits += index.find(live_ids[random.next() % live_ids.size()]) != nullptr;
+        index.erase(live_ids[victim]);
+        live_ids[victim] = next_id;
+    }
+    
+    bench_sink = hits + index.size();
+    report_rate(name, INDEX_CHURN_ROUNDS * 3, timer.elapsed_ms());
+}
+
+/**
+ * @brief Insert keys from empty and report batch latency (rehash pauses)
+ * Prints the p99 and the worst batch; the worst one is where a rehash lands
+ */
+template <typename IndexT>
+void bench_index_growth(const std::string& name) {
+    IndexT index;
+    BenchRandom random;
+    uint64_t next_id = 7000000000000000000ULL;
+    std::vector<double> batch_us;
+    batch_us.reserve(INDEX_GROWTH_KEYS / INDEX_GROWTH_BATCH + 1);
+    
+    Utils::Timer timer("");
+    
+    for (size_t inserted = 0; inserted < INDEX_GROWTH_KEYS; inserted += INDEX_GROWTH_BATCH) {
+        Utils::Timer batch_timer("");
+        for (size_t i = 0; i < INDEX_GROWTH_BATCH; ++i) {
+            next_id += 1 + random.next() % 64;
+            index.insert_or_assign(next_id, static_cast<uint32_t>(inserted + i));
+        }
+        batch_us.push_back(batch_timer.elapsed_ms() * 1000.0);
+    }
+    
+    double elapsed_ms = timer.elapsed_ms();
+    bench_sink = index.size();
+    report_rate(name, INDEX_GROWTH_KEYS, elapsed_ms);
+    
+    std::sort(batch_us.begin(), batch_us.end());
+    std::cout << "    " << INDEX_GROWTH_BATCH << "-insert batch: p99 " << std::fixed << std::setprecision(1)
+              << batch_us[batch_us.size() * 99 / 100] << " us, max " << batch_us.back() << " us" << std::endl;
+}
+
+/**
+ * @brief Churn and growth for one index type
+ * Runs in a process of its own (see bench_order_index)
+ */
+template <typename IndexT>
+void bench_one_order_index(const std::string& name) {
+    bench_index_churn<IndexT>("churn " + name);
+    bench_index_growth<IndexT>("growth " + name);
+}
+
+/**
+ * @brief Order index: std::unordered_map vs flat Robin Hood OrderIndex
+ * 
+ * Each index is measured in a fresh child process (this binary, run with
+ * --order-index=NAME). In one process the second run inherits the heap
+ * and page mappings the first one left behind, and its growth pauses
+ * measure that allocator state rather than the index.
+ */
+void bench_order_index(const std::string& program_path) {
+    std::cout << "\n=== Order Index (" << INDEX_LIVE_ORDERS << " live orders) ===" << std::endl;
+    
+    for (const char* index_name : {"map", "flat"}) {
+        std::string command = "\"" + program_path + "\" --order-index=" + index_name;
+        std::cout.flush();
+        if (std::system(command.c_str()) != 0) {
+            std::cerr << "Error: Order index benchmark '" << index_name << "' failed" << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief Delimiter scanning: legacy istringstream splitter vs SIMD kernels
+ */
+void bench_delimiter_scanning(const std::string& input) {
+    std::cout << "\n=== Delimiter Scanning (" << input.size() / (1024 * 1024) << " MB) ===" << std::endl;
+    std::cout << "Detected kernel: " << DelimiterScanner::kernel_name(DelimiterScanner::detect_kernel())
+              << std::endl;
+    
+    // Baseline: the getline + istringstream splitting CsvReader uses
+    {
+        Utils::Timer timer("");
+        std::istringstream lines(input);
+        std::string line;
+        std::string field;
+        std::vector<std::string> split_buffer;
+        size_t fields = 0;
+        
+        while (std::getline(lines, line)) {
+            split_buffer.clear();
+            std::istringstream iss(line);
+            while (std::getline(iss, field, ',')) {
+                split_buffer.push_back(field);
+            }
+            fields += split_buffer.size();
+        }
+        
+        bench_sink = fields;
+        report_throughput("legacy istringstream splitter", input.size(), timer.elapsed_ms());
+    }
+    
+    // Raw kernels: offsets for the whole buffer in one pass
+    const DelimiterScanner::Kernel kernels[] = {
+        DelimiterScanner::Kernel::SCALAR,
+        DelimiterScanner::Kernel::SSE42,
+        DelimiterScanner::Kernel::AVX2
+    };
+    
+    std::vector<uint32_t> offsets;
+    offsets.reserve(input.size() / 4);
+    
+    for (DelimiterScanner::Kernel kernel : kernels) {
+        if (!DelimiterScanner::is_kernel_supported(kernel)) {
+            std::cout << "  " << DelimiterScanner::kernel_name(kernel) << ": not supported on this CPU" << std::endl;
+            continue;
+        }
+        
+        offsets.clear();
+        Utils::Timer timer("");
+        DelimiterScanner::find_delimiters(input.data(), input.size(), offsets, kernel);
+        bench_sink = offsets.size();
+        report_throughput(std::string("find_delimiters ") + DelimiterScanner::kernel_name(kernel),
+                          input.size(), timer.elapsed_ms());
+    }
+    
+    // Full line + field cutting as done by MappedCsvReader
+    {
+        Utils::Timer timer("");
+        DelimiterScanner::RecordCursor cursor(input.data(), input.data() + input.size());
+        std::string_view line;
+        std::string_view fields[32];
+        size_t field_count = 0;
+        size_t fields_total = 0;
+        
+        while (cursor.next(line, fields, 32, field_count)) {
+            fields_total += field_count;
+        }
+        
+        bench_sink = fields_total;
+        report_throughput("RecordCursor lines + fields", input.size(), timer.elapsed_ms());
+    }
+}
+
+/**
+ * @brief MBP output: CSV text vs binary columns, and reading the binary file back
+ * Rows come from running the input file through an OrderBook. The readers
+ * map a real file, written (untimed) once the writers have been measured.
+ */
+void bench_mbp_output(const std::string& input_filename) {
+    std::vector<OrderBook::MBPRow> rows;
+    {
+        CsvReader reader(input_filename);
+        CsvReader::ParseResult parsed = reader.parse_all_orders();
+        OrderBook book(DEFAULT_LADDER, false);
+        for (const Order& order : parsed.orders) {
+            if (const OrderBook::MBPRow* row = book.process_order(order)) {
+                rows.push_back(*row);
+            }
+        }
+    }
+    if (rows.empty()) {
+        return;
+    }
+    
+    size_t source_rows = rows.size();
+    while (rows.size() < OUTPUT_BENCH_ROWS) {
+        rows.push_back(rows[rows.size() % source_rows]);
+    }
+    
+    std::cout << "\n=== MBP Output (" << rows.size() << " rows) ===" << std::endl;
+    
+    const std::string binary_filename = "bench_output.bin";
+    size_t csv_bytes = 0;
+    size_t binary_bytes = 0;
+    
+    {
+        Utils::Timer timer("");
+        CsvWriter writer(NULL_DEVICE, MbpOutputMode::FULL);
+        writer.write_header();
+        for (const auto& row : rows) {
+            writer.write_mbp_row(row);
+        }
+        writer.close();
+        csv_bytes = writer.get_write_result().bytes_written;
+        report_throughput("CsvWriter full rows", csv_bytes, timer.elapsed_ms());
+    }
+    
+    {
+        Utils::Timer timer("");
+        BinaryMbpWriter writer(NULL_DEVICE);
+        for (const auto& row : rows) {
+            writer.write_mbp_row(row);
+        }
+        writer.close();
+        binary_bytes = writer.get_bytes_written();
+        report_throughput("BinaryMbpWriter columns", binary_bytes, timer.elapsed_ms());
+    }
+    
+    {
+        BinaryMbpWriter writer(binary_filename);
+        for (const auto& row : rows) {
+            writer.write_mbp_row(row);
+        }
+        if (!writer.close()) {
+            return;
+        }
+    }
+    
+    // Reference point: copying the same number of bytes
+    {
+        std::vector<char> source(binary_bytes, 1);
+        std::vector<char> target(binary_bytes);
+        Utils::Timer timer("");
+        std::memcpy(target.data(), source.data(), binary_bytes);
+        bench_sink = static_cast<size_t>(target[binary_bytes / 2]);
+        report_throughput("memcpy (same bytes)", binary_bytes, timer.elapsed_ms());
+    }
+    
+    {
+        Utils::Timer timer("");
+        BinaryMbpReader reader(binary_filename);
+        OrderBook::MBPRow row;
+        size_t checksum = 0;
+        for (size_t block = 0; block < reader.get_block_count(); ++block) {
+            for (size_t i = 0; i < reader.get_block(block).row_count(); ++i) {
+                reader.read_row(block, i, row);
+                checksum += row.bid_levels[0].size;
+            }
+        }
+        bench_sink = checksum;
+        report_throughput("BinaryMbpReader rows", binary_bytes, timer.elapsed_ms());
+    }
+    
+    {
+        BinaryMbpReader reader(binary_filename);
+        Utils::Timer timer("");
+        uint64_t checksum = 0;
+        size_t row_count = 0;
+        for (size_t block = 0; block < reader.get_block_count(); ++block) {
+            const uint64_t* prices = reader.column<uint64_t>(block, BinaryMbpWriter::BID_PRICE);
+            for (size_t i = 0; i < reader.get_block(block).row_count(); ++i) {
+                checksum += prices[i];
+            }
+            row_count += reader.get_block(block).row_count();
+        }
+        bench_sink = static_cast<size_t>(checksum);
+        report_throughput("BinaryMbpReader bid_px_00 scan", row_count * sizeof(uint64_t), timer.elapsed_ms());
+    }
+    
+    std::cout << "  File size: " << csv_bytes / 1024 << " KB as CSV, "
+              << binary_bytes / 1024 << " KB binary" << std::endl;
+    
+    std::remove(binary_filename.c_str());
+}
+
+/**
+ * @brief Replay orders through a book of the given depth and write its rows
+ * @return Elapsed milliseconds for book updates plus CSV formatting
+ */
+template <int Depth>
+double bench_book_depth(const std::string& name, const std::vector<CompactOrder>& orders, size_t passes) {
+    BasicOrderBook<Depth> book(DEFAULT_LADDER, false);
+    BasicCsvWriter<Depth> writer(NULL_DEVICE, MbpOutputMode::FULL);
+    writer.write_header();
+    
+    Utils::Timer timer("");
+    for (size_t pass = 0; pass < passes; ++pass) {
+        // Each pass starts with the file's own R, which empties the book
+        for (const CompactOrder& order : orders) {
+            if (const auto* row = book.process_order(order)) {
+                writer.write_mbp_row(*row);
+            }
+        }
+    }
+    writer.flush();
+    double elapsed_ms = timer.elapsed_ms();
+    
+    report_rate(name, orders.size() * passes, elapsed_ms);
+    std::cout << "    " << writer.get_write_result().rows_written << " rows, "
+              << writer.get_write_result().bytes_written / 1024 << " KB" << std::endl;
+    return elapsed_ms;
+}
+
+/**
+ * @brief Reconstruction cost by output depth: full MBP-10 vs the BBO (MBP-1) fast path
+ * Times book updates plus row formatting to the null device, the work a
+ * top-of-book consumer would otherwise pay for in full
+ */
+void bench_bbo_vs_mbp10(const std::string& input_filename) {
+    std::vector<CompactOrder> orders;
+    {
+        CsvReader reader(input_filename);
+        CsvReader::ParseResult parsed = reader.parse_all_orders();
+        orders.reserve(parsed.orders.size());
+        CompactOrder compact;
+        for (const Order& order : parsed.orders) {
+            if (!CompactOrder::from_order(order, compact)) {
+                std::cout << "\nSkipping book depth benchmark: input does not fit compact records" << std::endl;
+                return;
+            }
+            orders.push_back(compact);
+        }
+    }
+    if (orders.empty()) {
+        return;
+    }
+    
+    size_t passes = (DEPTH_BENCH_EVENTS + orders.size() - 1) / orders.size();
+    std::cout << "\n=== Book Depth (" << orders.size() * passes << " events) ===" << std::endl;
+    
+    double mbp10_ms = bench_book_depth<Utils::MAX_DEPTH>("MBP-10 book + CSV rows", orders, passes);
+    double bbo_ms = bench_book_depth<1>("BBO book + CSV rows", orders, passes);
+    
+    std::cout << "  BBO speedup over MBP-10: " << std::fixed << std::setprecision(2)
+              << (bbo_ms > 0.0 ? mbp10_ms / bbo_ms : 0.0) << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // Child process of bench_order_index: one index type only
+    if (argc >= 2 && std::string(argv[1]).rfind("--order-index=", 0) == 0) {
+        std::string index_name = std::string(argv[1]).substr(14);
+        if (index_name == "map") {
+            bench_one_order_index<UnorderedMapIndex>("std::unordered_map");
+        } else if (index_name == "flat") {
+            bench_one_order_index<OrderIndex>("OrderIndex");
+        } else {
+            std::cerr << "Error: Unknown order index '" << index_name << "'" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    
+    std::string input_filename = argc >= 2 ? argv[1] : "mbo.csv";
+    
+    std::cout << "=============================================" << std::endl;
+    std::cout << "   MBP-10 Reconstruction Benchmarks          " << std::endl;
+    std::cout << "=============================================" << std::endl;
+    std::cout << "Input: " << input_filename << std::endl;
+    
+    std::string input = load_bench_input(input_filename);
+    if (input.empty()) {
+        std::cerr << "Error: Cannot read benchmark input '" << input_filename << "'" << std::endl;
+        return 1;
+    }
+    
+    bench_delimiter_scanning(input);
+    bench_order_index(argv[0]);
+    bench_mbp_output(input_filename);
+    bench_bbo_vs_mbp10(input_filename);
+    
+    return 0;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "BinaryMboWriter.hpp"
+#include "CsvReader.hpp"
+#include "MappedFile.hpp"
+#include "Order.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Memory-mapped reader for the binary MBO record stream
+ * 
+ * Drop-in alternative to CsvReader/MappedCsvReader for files written by
+ * BinaryMboWriter. Records are fixed-width structs read straight out of
+ * the mapping, so producing an Order is a handful of field copies with
+ * no delimiter scanning or number parsing. Records of an unknown rtype
+ * are stepped over using their length prefix.
+ */
+class BinaryMboReader {
+public:
+    using ParseResult = CsvReader::ParseResult;
+
+private:
+    MappedFile mapped_file;
+    const BinaryMboWriter::FileHeader* file_header;
+    
+    // instrument_id -> symbol id in this process's SymbolTable
+    std::unordered_map<uint32_t, uint32_t> instrument_symbols;
+    
+    size_t skipped_records;         // Records of another rtype, stepped over
+
+public:
+    /**
+     * @brief Constructor maps the file and validates its header and symbol table
+     * @param filename Binary MBO file
+     */
+    explicit BinaryMboReader(const std::string& filename);
+    
+    BinaryMboReader(const BinaryMboReader&) = delete;
+    BinaryMboReader& operator=(const BinaryMboReader&) = delete;
+    
+    /**
+     * @brief Check if the file was mapped and is a complete binary MBO file
+     */
+    bool is_open() const { return file_header != nullptr; }
+    
+    size_t get_file_size() const { return mapped_file.size(); }
+    
+    uint64_t get_record_count() const { return file_header->record_count; }
+    
+    size_t get_skipped_records() const { return skipped_records; }
+    
+    /**
+     * @brief Check whether a file starts with the binary MBO magic
+     */
+    static bool is_binary_mbo_file(const std::string& filename);
+    
+    /**
+     * @brief Decode every record into memory
+     * @return ParseResult containing orders and parsing metadata
+     */
+    ParseResult parse_all_orders();
+    
+    /**
+     * @brief Decode records in chunks of chunk_size orders
+     * @param callback Receives each chunk in file order
+     * @return Overall parsing statistics (orders are not retained)
+     */
+    ParseResult parse_in_chunks(size_t chunk_size,
+                                std::function<void(const std::vector<Order>&)> callback);
+
+private:
+    /**
+     * @brief Validate the header and load the symbol table
+     * @return false (logged) if the file is truncated or not in this format
+     */
+    bool index_file();
+    
+    /**
+     * @brief Decode the next MBO record at cursor into order
+     * @return false at the end of the records (or on a corrupt length prefix)
+     */
+    bool next_order(size_t& cursor, Order& order, ParseResult& result);
+};
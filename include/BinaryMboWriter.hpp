@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Order.hpp"
+#include <string>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Writer for the binary MBO record stream
+ * 
+ * Stores MBO events as fixed-width little-endian records instead of CSV
+ * lines, so they can be fed to the order book with no text parsing:
+ * 
+ *   FileHeader                      32 bytes, patched with the totals on close
+ *   record 0 .. record N-1          RecordHeader + body, length-prefixed
+ *   symbol table                    u32 entry count, then (u32 instrument_id, u32 length, bytes)
+ * 
+ * Every record starts with a RecordHeader whose length byte gives the
+ * record size in 4-byte words, so a reader can step over record types it
+ * does not know. MBO events are MboRecord (rtype RTYPE_MBO), laid out like
+ * the Databento DBN MboMsg. Prices are price_scaled (price * 1e9) and
+ * timestamps are int64 nanoseconds. BinaryMboReader maps the file and
+ * decodes it in place.
+ */
+class BinaryMboWriter {
+public:
+    static constexpr char MAGIC[8] = {'M', 'B', 'O', 'R', 'E', 'C', '\0', '\0'};
+    static constexpr uint16_t FORMAT_VERSION = 1;
+    static constexpr uint8_t RTYPE_MBO = 160;
+    static constexpr size_t RECORD_LENGTH_UNIT = 4;     // RecordHeader::length is in 4-byte words
+    
+    /**
+     * @brief File header; record count and symbol table offset are 0 until close()
+     */
+    struct FileHeader {
+        char magic[8];
+        uint16_t version;
+        uint16_t reserved;
+        uint32_t reserved2;
+        uint64_t record_count;
+        uint64_t symbol_table_offset;   // File offset of the symbol table, also the end of the records
+    };
+    
+    /**
+     * @brief Common prefix of every record
+     */
+    struct RecordHeader {
+        uint8_t length;                 // Record size in RECORD_LENGTH_UNIT words, header included
+        uint8_t rtype;
+        uint16_t publisher_id;
+        uint32_t instrument_id;
+        int64_t ts_event;
+    };
+    
+    /**
+     * @brief One MBO event (rtype RTYPE_MBO)
+     */
+    struct MboRecord {
+        RecordHeader header;
+        uint64_t order_id;
+        int64_t price;                  // price_scaled
+        uint32_t size;
+        uint8_t flags;
+        uint8_t channel_id;
+        char action;
+        char side;
+        int64_t ts_recv;
+        int32_t ts_in_delta;
+        uint32_t sequence;
+    };
+
+private:
+    std::string output_filename;
+    std::ofstream output_stream;
+    
+    static constexpr size_t WRITE_BUFFER_SIZE = 1024 * 1024;
+    std::unique_ptr<char[]> write_buffer;
+    
+    FileHeader file_header;
+    
+    // instrument_id -> symbol id of the first event seen for it, for the symbol table
+    std::unordered_map<uint32_t, uint32_t> instrument_symbols;
+    
+    uint64_t bytes_written;
+    bool closed;
+
+public:
+    /**
+     * @brief Constructor creates the file and writes a placeholder header
+     * @param filename Output path
+     */
+    explicit BinaryMboWriter(const std::string& filename);
+    
+    /**
+     * @brief Destructor closes the file if close() was not called
+     */
+    ~BinaryMboWriter();
+    
+    BinaryMboWriter(const BinaryMboWriter&) = delete;
+    BinaryMboWriter& operator=(const BinaryMboWriter&) = delete;
+    
+    bool is_open() const;
+    
+    const std::string& get_filename() const { return output_filename; }
+    
+    /**
+     * @brief Append one order as an MboRecord
+     * The record shares CompactOrder's field widths; an order that does not
+     * fit them (CompactOrder::fits) is rejected
+     * 
+     * @return true if the record was written
+     */
+    bool write_order(const Order& order);
+    
+    /**
+     * @brief Write the symbol table and patch the header
+     * @return true if the file is complete
+     */
+    bool close();
+    
+    uint64_t get_record_count() const { return file_header.record_count; }
+    
+    uint64_t get_bytes_written() const { return bytes_written; }
+    
+    /**
+     * @brief Convert an MBO CSV file into a binary MBO record file
+     * 
+     * Only rows that parse and validate are written, so reading the
+     * result yields exactly the orders the CSV readers produce.
+     * 
+     * @param csv_filename MBO CSV file to read
+     * @param output_filename Binary file to write
+     * @return Number of records written, or -1 on error
+     */
+    static long long convert_csv(const std::string& csv_filename, const std::string& output_filename);
+
+private:
+    bool write_symbol_table();
+    
+    bool write_bytes(const void* data, size_t length);
+};
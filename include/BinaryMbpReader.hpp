@@ -0,0 +1,102 @@
+#pragma once
+
+#include "BinaryMbpWriter.hpp"
+#include "MappedFile.hpp"
+#include "OrderBook.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Memory-mapped reader for the binary columnar MBP-10 format
+ * 
+ * Maps a BinaryMbpWriter file and indexes its blocks once; after that
+ * every column is a typed pointer straight into the mapping, so scanning
+ * a column costs no more than reading the memory. Block min/max
+ * timestamps let callers jump to a time range without touching the
+ * blocks before it.
+ */
+class BinaryMbpReader {
+public:
+    using Column = BinaryMbpWriter::Column;
+    
+    /**
+     * @brief One block: its header and the start of each of its columns
+     */
+    struct Block {
+        const BinaryMbpWriter::BlockHeader* header;
+        const char* columns[BinaryMbpWriter::COLUMN_COUNT];
+        
+        size_t row_count() const { return header->row_count; }
+    };
+
+private:
+    MappedFile mapped_file;
+    const BinaryMbpWriter::FileHeader* file_header;
+    std::vector<Block> blocks;
+    
+    // File symbol id -> id in this process's SymbolTable
+    std::unordered_map<uint32_t, uint32_t> symbol_ids;
+
+public:
+    /**
+     * @brief Constructor maps the file and validates its header and block layout
+     * @param filename Binary MBP file
+     */
+    explicit BinaryMbpReader(const std::string& filename);
+    
+    BinaryMbpReader(const BinaryMbpReader&) = delete;
+    BinaryMbpReader& operator=(const BinaryMbpReader&) = delete;
+    
+    /**
+     * @brief Check if the file was mapped and is a complete binary MBP file
+     */
+    bool is_open() const { return file_header != nullptr; }
+    
+    uint64_t get_row_count() const { return file_header->row_count; }
+    
+    size_t get_block_count() const { return blocks.size(); }
+    
+    const BinaryMbpWriter::FileHeader& get_file_header() const { return *file_header; }
+    
+    const Block& get_block(size_t block) const { return blocks[block]; }
+    
+    /**
+     * @brief Typed view of one column of a block
+     * T must have the column's width (see BinaryMbpWriter::Column)
+     */
+    template <typename T>
+    const T* column(size_t block, size_t column_id) const {
+        return reinterpret_cast<const T*>(blocks[block].columns[column_id]);
+    }
+    
+    /**
+     * @brief First block that may hold a row with ts_event >= timestamp_ns
+     * @return get_block_count() if every row is earlier
+     */
+    size_t find_block(int64_t timestamp_ns) const;
+    
+    /**
+     * @brief Reassemble one row of a block into an MBPRow
+     * The symbol id is translated into this process's SymbolTable
+     */
+    void read_row(size_t block, size_t row, OrderBook::MBPRow& mbp_row) const;
+    
+    /**
+     * @brief Convert a whole binary file back into a standard MBP-10 CSV file
+     * 
+     * @param binary_filename Binary MBP file to read
+     * @param output_filename Full MBP-10 CSV file to write
+     * @return Number of rows written, or -1 on error
+     */
+    static long long expand_to_csv(const std::string& binary_filename, const std::string& output_filename);
+
+private:
+    /**
+     * @brief Validate the header, index the blocks and load the symbol table
+     * @return false (logged) if the file is truncated or not in this format
+     */
+    bool index_file();
+};
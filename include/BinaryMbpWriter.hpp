@@ -0,0 +1,202 @@
+#pragma once
+
+#include "OrderBook.hpp"
+#include "Utils.hpp"
+#include <string>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Writer for the binary columnar MBP-10 format
+ * 
+ * Stores MBP rows as fixed-width little-endian columns instead of text:
+ * 
+ *   FileHeader                      64 bytes, patched with the totals on close
+ *   block 0 .. block N-1            BlockHeader, then one array per Column
+ *   symbol table                    u32 entry count, then (u32 id, u32 length, bytes)
+ * 
+ * A block holds up to rows_per_block rows. Each column of a block is
+ * row_count values of column_width() bytes, zero-padded to a multiple of
+ * 8 bytes so every column starts 8-byte aligned in a mapping. Timestamps
+ * are int64 nanoseconds, prices are price_scaled (price * 1e9), and the
+ * symbol column holds ids resolved through the symbol table. The block
+ * headers carry the min/max timestamps, so a reader can skip straight to
+ * a time range. BinaryMbpReader maps the file and reads it in place.
+ */
+class BinaryMbpWriter {
+public:
+    static constexpr char MAGIC[8] = {'M', 'B', 'P', 'C', 'O', 'L', '\0', '\0'};
+    static constexpr uint16_t FORMAT_VERSION = 1;
+    static constexpr uint32_t DEFAULT_ROWS_PER_BLOCK = 4096;
+    
+    /**
+     * @brief File header; row/block counts and the symbol table offset are 0 until close()
+     */
+    struct FileHeader {
+        char magic[8];
+        uint16_t version;
+        uint16_t depth;                 // Levels per side (Utils::MAX_DEPTH)
+        uint32_t rows_per_block;
+        uint64_t row_count;
+        uint64_t block_count;
+        uint64_t symbol_table_offset;   // File offset of the symbol table
+        int64_t min_ts_event;
+        int64_t max_ts_event;
+        uint64_t reserved;
+    };
+    
+    /**
+     * @brief Header in front of every block's columns
+     */
+    struct BlockHeader {
+        uint32_t row_count;
+        uint32_t reserved;
+        int64_t min_ts_recv;
+        int64_t max_ts_recv;
+        int64_t min_ts_event;
+        int64_t max_ts_event;
+    };
+    
+    /**
+     * @brief Columns of a block, in file order
+     * 
+     * Level columns come in groups of MAX_DEPTH: BID_PRICE + level is the
+     * bid price column of that level, and so on.
+     */
+    enum Column : size_t {
+        TS_RECV,            // int64
+        TS_EVENT,           // int64
+        RTYPE,              // uint8
+        PUBLISHER_ID,       // uint16
+        INSTRUMENT_ID,      // uint32
+        ACTION,             // char
+        SIDE,               // char
+        DEPTH,              // int8
+        PRICE,              // uint64 price_scaled
+        SIZE,               // uint32
+        FLAGS,              // uint8
+        TS_IN_DELTA,        // int32
+        SEQUENCE,           // uint32
+        SYMBOL_ID,          // uint32
+        ORDER_ID,           // uint64
+        BID_PRICE,          // uint64 price_scaled, 0 for an empty level
+        BID_SIZE = BID_PRICE + Utils::MAX_DEPTH,    // uint32
+        BID_COUNT = BID_SIZE + Utils::MAX_DEPTH,    // uint32
+        ASK_PRICE = BID_COUNT + Utils::MAX_DEPTH,   // uint64
+        ASK_SIZE = ASK_PRICE + Utils::MAX_DEPTH,    // uint32
+        ASK_COUNT = ASK_SIZE + Utils::MAX_DEPTH,    // uint32
+        COLUMN_COUNT = ASK_COUNT + Utils::MAX_DEPTH
+    };
+    
+    /**
+     * @brief Width in bytes of one value of a column
+     */
+    static size_t column_width(size_t column);
+    
+    /**
+     * @brief Bytes a column takes in a block of row_count rows (padding included)
+     */
+    static size_t column_bytes(size_t column, size_t row_count) {
+        return (column_width(column) * row_count + 7) & ~static_cast<size_t>(7);
+    }
+    
+    /**
+     * @brief Bytes of a whole block of row_count rows, header included
+     */
+    static size_t block_bytes(size_t row_count);
+
+private:
+    std::string output_filename;
+    std::ofstream output_stream;
+    
+    static constexpr size_t WRITE_BUFFER_SIZE = 1024 * 1024;
+    std::unique_ptr<char[]> write_buffer;
+    
+    FileHeader file_header;
+    uint32_t rows_per_block;
+    
+    // Block being filled: each row is scattered straight into its columns,
+    // laid out for a full block (a short last block is compacted on close)
+    std::vector<char> block_buffer;
+    size_t column_offsets[COLUMN_COUNT];
+    BlockHeader block_header;
+    
+    // Symbol ids referenced by the rows written, for the symbol table
+    std::vector<bool> used_symbols;
+    
+    uint64_t bytes_written;
+    bool closed;
+
+public:
+    /**
+     * @brief Constructor creates the file and writes a placeholder header
+     * @param filename Output path
+     * @param block_rows Rows per block
+     */
+    explicit BinaryMbpWriter(const std::string& filename, uint32_t block_rows = DEFAULT_ROWS_PER_BLOCK);
+    
+    /**
+     * @brief Destructor closes the file if close() was not called
+     */
+    ~BinaryMbpWriter();
+    
+    BinaryMbpWriter(const BinaryMbpWriter&) = delete;
+    BinaryMbpWriter& operator=(const BinaryMbpWriter&) = delete;
+    
+    bool is_open() const;
+    
+    const std::string& get_filename() const { return output_filename; }
+    
+    /**
+     * @brief Append one row; a full block is written out
+     * @return true if the row was accepted
+     */
+    bool write_mbp_row(const OrderBook::MBPRow& mbp_row);
+    
+    /**
+     * @brief Flush the completed blocks to disk
+     * The partially filled block stays in memory until it fills up or close()
+     */
+    bool flush();
+    
+    /**
+     * @brief Write the last block and the symbol table, then patch the header
+     * @return true if the file is complete
+     */
+    bool close();
+    
+    uint64_t get_row_count() const { return file_header.row_count + block_header.row_count; }
+    
+    /**
+     * @brief Bytes written so far (header and completed blocks)
+     */
+    uint64_t get_bytes_written() const { return bytes_written; }
+
+private:
+    /**
+     * @brief Write the block being filled and start an empty one
+     */
+    bool write_block();
+    
+    /**
+     * @brief Reset the block header for an empty block
+     */
+    void start_block();
+    
+    /**
+     * @brief Store one value of the current row in its column
+     */
+    template <typename T>
+    void store(size_t column, T value) {
+        std::memcpy(block_buffer.data() + column_offsets[column] + sizeof(T) * block_header.row_count,
+                    &value, sizeof(T));
+    }
+    
+    bool write_symbol_table();
+    
+    bool write_bytes(const void* data, size_t length);
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Order.hpp"
+#include "OrderBook.hpp"
+#include "CsvWriter.hpp"
+#include "SpscRing.hpp"
+#include <vector>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Per-instrument order books sharded across worker threads
+ * 
+ * Routes every event by instrument_id to that instrument's own OrderBook:
+ * 
+ * 1. Instruments are assigned to shards by hash; each shard owns its books
+ *    and a worker thread, so a book is only ever touched by one thread
+ * 2. The calling thread splits each chunk of orders into one batch per
+ *    shard (tagged with each order's position in the chunk) and hands the
+ *    batches over through SpscRings
+ * 3. Workers apply their batches and keep the resulting MBP rows with the
+ *    position of the order that triggered them
+ * 4. Once every shard is done with a chunk, its rows are merged back by
+ *    position and written in input order
+ * 
+ * Output is therefore identical to applying the file serially with one
+ * book per instrument, whatever the shard count. Up to CHUNKS_IN_FLIGHT
+ * chunks are being worked on at once.
+ */
+class BookManager {
+public:
+    // Chunks dispatched to the workers before the oldest one must be written
+    static constexpr size_t CHUNKS_IN_FLIGHT = 4;
+
+private:
+    /**
+     * @brief One shard's share of a chunk: its orders in, its MBP rows out
+     */
+    struct ShardBatch {
+        std::vector<Order> orders;
+        std::vector<uint32_t> positions;            // Position of each order in the chunk
+        std::vector<OrderBook::MBPRow> rows;
+        std::vector<uint32_t> row_positions;        // Position of the order behind each row
+        
+        void clear();
+    };
+    
+    /**
+     * @brief Books of the instruments hashed to one worker thread
+     */
+    struct Shard {
+        std::unordered_map<uint32_t, std::unique_ptr<OrderBook>> books;
+        SpscRing<ShardBatch*> pending;              // Calling thread -> worker
+        SpscRing<ShardBatch*> completed;            // Worker -> calling thread
+        std::thread worker;
+        
+        size_t orders_processed = 0;
+        size_t mbp_updates = 0;
+        
+        Shard() : pending(CHUNKS_IN_FLIGHT), completed(CHUNKS_IN_FLIGHT) {}
+    };
+    
+    LadderType ladder_type;
+    CsvWriter& csv_writer;
+    
+    std::vector<std::unique_ptr<Shard>> shards;
+    
+    // chunk_batches[slot][shard]; chunk n uses slot n % CHUNKS_IN_FLIGHT
+    std::vector<std::vector<ShardBatch>> chunk_batches;
+    size_t chunks_dispatched;
+    size_t chunks_written;
+    
+    size_t mbp_updates;
+    bool write_failed;
+    bool finished;
+
+public:
+    /**
+     * @brief Constructor starts one worker thread per shard
+     * 
+     * @param shard_count Number of shards/worker threads (0 = all cores)
+     * @param ladder Price ladder used by every book
+     * @param writer Destination of the merged MBP rows (written from the calling thread)
+     */
+    BookManager(size_t shard_count, LadderType ladder, CsvWriter& writer);
+    
+    /**
+     * @brief Destructor finishes (drains and joins) the workers if needed
+     */
+    ~BookManager();
+    
+    BookManager(const BookManager&) = delete;
+    BookManager& operator=(const BookManager&) = delete;
+    
+    /**
+     * @brief Route one chunk of orders to the shards
+     * 
+     * May first write the oldest chunk in flight to make room.
+     * 
+     * @param orders Orders in file order
+     * @return false if an MBP row could not be written
+     */
+    bool process_orders(const std::vector<Order>& orders);
+    
+    /**
+     * @brief Write every chunk still in flight, then stop the workers
+     * @return false if an MBP row could not be written
+     */
+    bool finish();
+    
+    size_t get_shard_count() const { return shards.size(); }
+    
+    /**
+     * @brief MBP rows written so far
+     */
+    size_t get_mbp_updates() const { return mbp_updates; }
+    
+    /**
+     * @brief Number of instruments with a book (call after finish)
+     */
+    size_t get_instrument_count() const;
+    
+    /**
+     * @brief Print orders, rows and books per shard (call after finish)
+     */
+    void print_shard_statistics() const;
+
+private:
+    /**
+     * @brief Shard that owns an instrument
+     */
+    size_t shard_of(uint32_t instrument_id) const {
+        // Fibonacci-hash the id to 32 bits, then scale it to the shard count
+        // with a multiply-shift instead of a division
+        uint64_t hash = (instrument_id * 0x9E3779B97F4A7C15ULL) >> 32;
+        return static_cast<size_t>((hash * shards.size()) >> 32);
+    }
+    
+    /**
+     * @brief Worker thread: apply batches until the pending ring is closed
+     */
+    void worker_loop(Shard& shard);
+    
+    /**
+     * @brief Wait for every shard to finish the oldest chunk and write its rows in order
+     */
+    bool write_oldest_chunk();
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Order.hpp"
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Compact, trivially-copyable order record for the hot path
+ * 
+ * Carries the same information as Order without any heap storage:
+ * timestamps are nanoseconds since the epoch and the symbol is an id in
+ * SymbolTable::instance(). Field widths follow the vendor MBO record
+ * (u32 sequence, i32 ts_in_delta, u8 flags), which brings an event down
+ * from ~144 bytes to 64 - exactly one cache line - and can be copied
+ * with memcpy.
+ * 
+ * Order keeps those fields wider, so not every Order fits:
+ * - sequence must be at most 4294967295 (UINT32_MAX)
+ * - ts_in_delta, read as a two's-complement int64, must lie in
+ *   [-2147483648, 2147483647] (INT32_MIN..INT32_MAX)
+ * - flags must be at most 255 (UINT8_MAX)
+ * from_order() rejects anything else instead of truncating it; callers
+ * fall back to processing the full Order.
+ */
+struct CompactOrder {
+    // Timing information (nanoseconds since 1970-01-01T00:00:00Z)
+    int64_t ts_recv;            // Reception timestamp
+    int64_t ts_event;           // Event timestamp
+    
+    // Core order identification and price
+    uint64_t order_id;          // Unique identifier for the order
+    uint64_t price_scaled;      // Price * 1e9
+    
+    uint32_t size;              // Order size/quantity
+    uint32_t sequence;          // Sequence number
+    int32_t ts_in_delta;        // Timestamp delta
+    uint32_t symbol_id;         // Interned trading symbol
+    uint32_t instrument_id;     // Instrument the order belongs to
+    uint16_t publisher_id;      // Dataset/venue that published the event
+    
+    uint8_t flags;              // Order flags
+    char side;                  // 'B' for bid, 'A' for ask
+    char action;                // 'A' for add, 'C' for cancel, 'T' for trade, etc.
+    
+    /**
+     * @brief Default constructor
+     */
+    CompactOrder() : ts_recv(0), ts_event(0), order_id(0), price_scaled(0), size(0),
+                     sequence(0), ts_in_delta(0), symbol_id(0), instrument_id(0),
+                     publisher_id(0), flags(0), side('N'), action(' ') {}
+    
+    /**
+     * @brief Check if an Order's metadata fits the compact field widths
+     */
+    static bool fits(const Order& order);
+    
+    /**
+     * @brief Build a compact record from a parsed Order
+     * Narrows the metadata fields to their vendor widths
+     * 
+     * @param order Parsed order
+     * @param compact Output record, left untouched on failure
+     * @return false if a field is out of range (see fits())
+     */
+    static bool from_order(const Order& order, CompactOrder& compact);
+    
+    /**
+     * @brief Expand back into a full Order (for logging and tests)
+     */
+    Order to_order() const;
+    
+    /**
+     * @brief Get the actual price as a double
+     */
+    inline double get_price() const {
+        return static_cast<double>(price_scaled) / 1e9;
+    }
+    
+    /**
+     * @brief Check if this is a bid order
+     */
+    inline bool is_bid() const {
+        return side == 'B';
+    }
+    
+    /**
+     * @brief Check if this is an ask order
+     */
+    inline bool is_ask() const {
+        return side == 'A';
+    }
+    
+    /**
+     * @brief Check if this is a valid order (not neutral side)
+     */
+    inline bool is_valid() const {
+        return side == 'B' || side == 'A';
+    }
+};
+
+static_assert(std::is_trivially_copyable<CompactOrder>::value,
+              "CompactOrder must stay memcpy-able");
+static_assert(sizeof(CompactOrder) == 64,
+              "CompactOrder layout changed - keep it within one cache line");
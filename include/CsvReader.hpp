@@ -137,14 +137,20 @@ public:
      * @brief Parse orders in chunks for memory-efficient processing
      * 
      * This method allows processing very large files without loading
-     * everything into memory at once.
+     * everything into memory at once. With more than one thread the file
+     * is split into newline-aligned byte ranges that are parsed
+     * concurrently (through MappedCsvReader) and still delivered to the
+     * callback in the original order.
      * 
      * @param chunk_size Maximum number of orders to parse in one chunk
+     *                   (approximate when num_threads > 1)
      * @param callback Function called for each chunk of orders
+     * @param num_threads Parser threads; 1 keeps the sequential stream reader
      * @return Overall parsing statistics
      */
     ParseResult parse_in_chunks(size_t chunk_size, 
-                               std::function<void(const std::vector<Order>&)> callback);
+                               std::function<void(const std::vector<Order>&)> callback,
+                               size_t num_threads = 1);
     
     /**
      * @brief Get file size in bytes
@@ -157,6 +163,18 @@ public:
      * Uses file size and average line length estimation
      */
     size_t estimate_order_count() const;
+    
+    /**
+     * @brief Validate that a parsed order makes sense
+     * 
+     * Performs sanity checks on the parsed data to catch parsing errors
+     * early and provide meaningful error messages. Shared with the
+     * memory-mapped reader so both apply identical rules.
+     * 
+     * @param order The order to validate
+     * @return true if order is valid
+     */
+    static bool validate_order(const Order& order);
 
 private:
     /**
@@ -190,17 +208,6 @@ private:
      */
     const std::vector<std::string>& split_csv_line(const std::string& line);
     
-    /**
-     * @brief Validate that a parsed order makes sense
-     * 
-     * Performs sanity checks on the parsed data to catch parsing errors
-     * early and provide meaningful error messages.
-     * 
-     * @param order The order to validate
-     * @return true if order is valid
-     */
-    bool validate_order(const Order& order) const;
-    
     /**
      * @brief Get column name by index (for error reporting)
      * @param index Column index
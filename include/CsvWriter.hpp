@@ -1,27 +1,84 @@
 #pragma once
 
 #include "OrderBook.hpp"
+#include "BinaryMbpWriter.hpp"
+#include "SpscRing.hpp"
 #include "Utils.hpp"
+#include <atomic>
 #include <string>
+#include <thread>
 #include <fstream>
 #include <vector>
 #include <sstream>
 #include <memory>
 
 /**
- * @brief High-performance CSV writer optimized for MBP-10 output
+ * @brief What each output row carries
  * 
- * This class is specifically designed to write MBP-10 CSV files with maximum
+ * FULL  - the standard MBP row with all level columns (60 for MBP-10)
+ * DELTA - the event columns plus only the levels that changed since the
+ *         previous row, as (side, depth, price, size, count) tuples.
+ *         MbpDeltaReader expands these back into FULL rows.
+ * BINARY - FULL rows as fixed-width binary columns (BinaryMbpWriter);
+ *         BinaryMbpReader maps them back.
+ */
+enum class MbpOutputMode {
+    FULL,
+    DELTA,
+    BINARY
+};
+
+/**
+ * @brief Human-readable output mode name for logging
+ */
+inline const char* mbp_output_mode_name(MbpOutputMode mode) {
+    switch (mode) {
+        case MbpOutputMode::DELTA: return "delta";
+        case MbpOutputMode::BINARY: return "binary";
+        default: return "full";
+    }
+}
+
+/**
+ * @brief High-performance CSV writer optimized for MBP-N output
+ * 
+ * This class is specifically designed to write MBP CSV files with maximum
  * efficiency and exact format matching. Key optimizations include:
  * 
  * 1. Buffered writing to minimize I/O operations
  * 2. Pre-formatted string templates to avoid repeated formatting
- * 3. Fast double-to-string conversion with precise decimal handling
- * 4. Memory-efficient row construction
+ * 3. Rows rendered straight into one reusable char buffer: integers via
+ *    digit-pair tables, prices from price_scaled without going through double
+ * 4. Memory-efficient row construction (no temporary strings per row)
  * 5. Exact format matching with the expected mbp.csv output
+ * 6. Optional async mode: rows are handed to a dedicated writer thread
+ *    through a bounded SpscRing, so disk stalls never block the caller
+ *    unless the ring fills up (backpressure)
+ * 7. MbpOutputMode::BINARY hands rows to a BinaryMbpWriter instead of
+ *    formatting text, keeping the same interface (and async mode)
+ * 
+ * Delta row layout (MbpOutputMode::DELTA):
+ * 
+ *   index,ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,depth,
+ *   price,size,flags,ts_in_delta,sequence,symbol,order_id,changes,
+ *   then `changes` tuples of side,depth,price,size,count
+ * 
+ * Levels are diffed by price against the previous row written, starting
+ * from an empty book. A tuple with zero size and count removes the level
+ * at that price; any other tuple inserts or updates it. Depth is the
+ * level's position in this row (its old position for a removal), so a
+ * level that only moved because a better one appeared is not repeated.
+ * 
+ * Depth is the number of levels per side, matching BasicOrderBook<Depth>;
+ * CsvWriter is the MBP-10 writer. BINARY output is only available at
+ * depth 10, the layout BinaryMbpWriter stores.
  */
-class CsvWriter {
+template <int Depth>
+class BasicCsvWriter {
 public:
+    using MBPRow = typename BasicOrderBook<Depth>::MBPRow;
+    using Level = typename MBPRow::Level;
+    
     /**
      * @brief Writing statistics and result information
      */
@@ -31,9 +88,14 @@ public:
         double writing_time_ms;             // Time taken for writing
         bool success;                       // Overall success flag
         std::string error_message;          // Error details if any
+        bool async_mode;                    // Rows were written on a writer thread
+        double async_blocked_ms;            // Time the caller waited on a full ring
+        double async_thread_ms;             // Lifetime of the writer thread
+        double async_idle_ms;               // Time the writer thread waited for rows
         
         WriteResult() : rows_written(0), bytes_written(0), writing_time_ms(0.0), 
-                       success(true) {}
+                       success(true), async_mode(false), async_blocked_ms(0.0),
+                       async_thread_ms(0.0), async_idle_ms(0.0) {}
         
         /**
          * @brief Print writing summary
@@ -64,11 +126,38 @@ private:
     std::unique_ptr<char[]> write_buffer;
     std::ostringstream buffer_stream;
     
+    // Upper bound on the delta tuples of one row (Depth removals + Depth updates per side)
+    static constexpr size_t MAX_DELTA_BYTES = 4 * Depth * 80;
+    
+    // Longest row the formatter can produce, not counting the symbol text:
+    // metadata plus the delta tuples, which also bound 2 * Depth full levels
+    static constexpr size_t MAX_FIXED_ROW_BYTES = 896 + MAX_DELTA_BYTES;
+    
+    // Reusable row buffer, grown only for unusually long symbols
+    std::unique_ptr<char[]> row_buffer;
+    size_t row_buffer_size;
+    
+    // Async mode: rows queued for the writer thread (nullptr when synchronous)
+    std::unique_ptr<SpscRing<MBPRow>> async_ring;
+    std::thread async_thread;
+    size_t async_rows_queued;               // Caller side only
+    std::atomic<size_t> async_rows_done;    // Rows the writer thread has finished with
+    std::atomic<bool> async_failed;
+    
+    // Binary columnar output (BINARY mode only; the text stream stays closed)
+    std::unique_ptr<BinaryMbpWriter> binary_writer;
+    
     // Row counter for the index column
     size_t row_index;
     
+    // Row layout, and the levels of the last row written (DELTA mode diffs against them)
+    MbpOutputMode output_mode;
+    Level last_bid_levels[Depth];
+    Level last_ask_levels[Depth];
+    
     // Pre-formatted strings to avoid repeated string operations
     std::string header_line;
+    std::vector<std::string> symbol_bytes;  // Symbol id -> rendered text, filled on first use
     
     // Statistics tracking
     mutable WriteResult current_result;
@@ -78,13 +167,14 @@ public:
     /**
      * @brief Constructor
      * @param csv_filename Path to the output CSV file
+     * @param mode Full MBP rows or changed levels only
      */
-    explicit CsvWriter(const std::string& csv_filename);
+    explicit BasicCsvWriter(const std::string& csv_filename, MbpOutputMode mode = MbpOutputMode::FULL);
     
     /**
      * @brief Destructor - ensures proper file closure and final flush
      */
-    ~CsvWriter();
+    ~BasicCsvWriter();
     
     /**
      * @brief Check if the output file was opened successfully
@@ -96,6 +186,41 @@ public:
      */
     const std::string& get_filename() const { return output_filename; }
     
+    /**
+     * @brief Get the row layout being written
+     */
+    MbpOutputMode get_output_mode() const { return output_mode; }
+    
+    /**
+     * @brief Default async ring size in rows (about 1 MB of MBPRow records)
+     */
+    static constexpr size_t DEFAULT_ASYNC_RING_CAPACITY = 1024;
+    
+    /**
+     * @brief Switch to async mode: format and write rows on a dedicated thread
+     * 
+     * Call after write_header(). From then on write_mbp_row only copies the
+     * row into a bounded ring and returns; the writer thread validates,
+     * formats and writes it. When the ring is full the caller waits, so
+     * memory stays bounded. A write error is reported by the next
+     * write_mbp_row or flush call.
+     * 
+     * @param ring_capacity Rows the ring can hold (rounded up to a power of two)
+     * @return true if the writer thread was started
+     */
+    bool start_async(size_t ring_capacity = DEFAULT_ASYNC_RING_CAPACITY);
+    
+    /**
+     * @brief Check if rows are written on the writer thread
+     */
+    bool is_async() const { return async_ring != nullptr; }
+    
+    /**
+     * @brief Let the writer thread finish every queued row, join it and return to synchronous mode
+     * Called by close() and the destructor; call it directly to read settled statistics
+     */
+    void stop_async();
+    
     /**
      * @brief Write the CSV header
      * Must be called before writing any MBP rows
@@ -107,13 +232,13 @@ public:
     /**
      * @brief Write a single MBP row to the output file
      * 
-     * This is the main function for writing MBP-10 data. It formats
-     * the OrderBook::MBPRow into the exact CSV format required.
+     * This is the main function for writing MBP data. It formats
+     * the MBPRow into the exact CSV format required.
      * 
      * @param mbp_row The MBP row to write
      * @return true if row was written successfully
      */
-    bool write_mbp_row(const OrderBook::MBPRow& mbp_row);
+    bool write_mbp_row(const MBPRow& mbp_row);
     
     /**
      * @brief Write multiple MBP rows efficiently
@@ -124,11 +249,12 @@ public:
      * @param mbp_rows Vector of MBP rows to write
      * @return true if all rows were written successfully
      */
-    bool write_mbp_rows(const std::vector<OrderBook::MBPRow>& mbp_rows);
+    bool write_mbp_rows(const std::vector<MBPRow>& mbp_rows);
     
     /**
      * @brief Flush any buffered data to disk
-     * Should be called periodically during long writes
+     * Should be called periodically during long writes. In async mode
+     * this first waits for the writer thread to catch up.
      * 
      * @return true if flush was successful
      */
@@ -136,6 +262,7 @@ public:
     
     /**
      * @brief Get current writing statistics
+     * In async mode the counters are only settled after flush() or close()
      */
     const WriteResult& get_write_result() const { return current_result; }
     
@@ -144,6 +271,14 @@ public:
      */
     void reset_statistics();
     
+    /**
+     * @brief Set the index column value of the next row written
+     * A resumed run passes the rows written before its checkpoint, so its
+     * rows continue the numbering instead of restarting at 0. Call before
+     * start_async().
+     */
+    void set_next_row_index(size_t next_index) { row_index = next_index; }
+    
     /**
      * @brief Close the output file explicitly
      * Automatically called by destructor
@@ -151,6 +286,30 @@ public:
     void close();
 
 private:
+    /**
+     * @brief Validate, format and write one row on the calling thread
+     * Body of write_mbp_row in synchronous mode, and of the writer thread
+     * 
+     * @return true if row was written successfully
+     */
+    bool write_row_now(const MBPRow& mbp_row);
+    
+    /**
+     * @brief Finish the binary file (last block, symbol table, header totals)
+     * @return true if there is no binary writer or it closed cleanly
+     */
+    bool close_binary_writer();
+    
+    /**
+     * @brief Writer thread: drain the ring until it is closed
+     */
+    void async_writer_loop();
+    
+    /**
+     * @brief Wait until the writer thread has finished every queued row
+     */
+    void wait_for_async_writer() const;
+    
     /**
      * @brief Initialize the write buffer and prepare for output
      * @return true if initialization was successful
@@ -158,59 +317,81 @@ private:
     bool initialize_writer();
     
     /**
-     * @brief Format a single MBP row into CSV string
+     * @brief Format a single MBP row into the row buffer
      * 
      * This function handles the precise formatting required to match
-     * the expected output format exactly. It's optimized for speed
-     * while maintaining exact decimal precision.
+     * the expected output format exactly. Every field is written in place,
+     * so a row costs no allocations at all.
      * 
      * @param mbp_row The MBP row to format
-     * @param output Output string (pre-allocated for performance)
-     * @return true if formatting was successful
+     * @param output Buffer with room for MAX_FIXED_ROW_BYTES plus the symbol
+     * @return One past the last byte written (the row ends with a newline)
      */
-    bool format_mbp_row(const OrderBook::MBPRow& mbp_row, std::string& output);
+    char* format_mbp_row(const MBPRow& mbp_row, char* output);
     
     /**
-     * @brief Format price value with exact precision
-     * 
-     * Handles the specific decimal formatting required for prices
-     * in the output CSV. Uses fast conversion and avoids scientific notation.
+     * @brief Append the changed levels of one side as delta tuples
+     * Levels are matched by price between the two rows
      * 
-     * @param price The price value to format
-     * @return Formatted price string
+     * @param output Receives ",side,depth,price,size,count" per change
+     * @param side 'B' or 'A'
+     * @param levels Levels of the row being written
+     * @param last_levels Levels of the previous row, updated in place
+     * @param change_count Incremented once per tuple written
+     * @return One past the last byte written
+     */
+    char* write_level_deltas(char* output, char side,
+                             const Level* levels,
+                             Level* last_levels,
+                             int& change_count) const;
+    
+    /**
+     * @brief Write ",price,size,count" for one level
+     * @return One past the last byte written
      */
-    std::string format_price(double price) const;
+    static char* write_level(const Level& level, char* output);
     
     /**
-     * @brief Format size value (always integer)
-     * @param size The size value to format
-     * @return Formatted size string
+     * @brief Write a price column; zero prices are written as an empty field
+     * @return One past the last byte written
      */
-    std::string format_size(uint64_t size) const;
+    static char* write_price(uint64_t price_scaled, char* output);
     
     /**
-     * @brief Format count value (always integer)
-     * @param count The count value to format
-     * @return Formatted count string
+     * @brief Write the trailing ",symbol,order_id" columns
+     * @return One past the last byte written
      */
-    std::string format_count(uint32_t count) const;
+    char* write_symbol_and_order_id(const MBPRow& mbp_row, char* output);
     
     /**
-     * @brief Format timestamp string
+     * @brief Format an epoch-nanosecond timestamp
      * 
-     * Ensures timestamp format matches exactly with input format
+     * Writes the same "YYYY-MM-DDTHH:MM:SS.fffffffffZ" layout the input
+     * used, byte for byte, without building a std::string.
      * 
-     * @param timestamp The timestamp string to format
-     * @return Formatted timestamp string
+     * @param timestamp_ns Nanoseconds since epoch
+     * @param output Buffer with room for Utils::TIMESTAMP_LENGTH bytes
+     * @return Number of bytes written
      */
-    std::string format_timestamp(const std::string& timestamp) const;
+    size_t format_timestamp(int64_t timestamp_ns, char* output) const;
+    
+    /**
+     * @brief Get the rendered text for a symbol id
+     * 
+     * Looked up from SymbolTable the first time an id is written and
+     * served from symbol_bytes afterwards.
+     * 
+     * @param symbol_id Interned symbol id
+     * @return Symbol text
+     */
+    const std::string& symbol_text(uint32_t symbol_id);
     
     /**
      * @brief Create the CSV header string
      * 
-     * Generates the exact header format required for MBP-10 output.
-     * This includes all the metadata columns plus the 20 price level columns
-     * (10 bid levels + 10 ask levels, each with price, size, count).
+     * Generates the exact header format required for MBP output.
+     * This includes all the metadata columns plus the 2 * Depth price level
+     * columns (bid levels then ask levels, each with price, size, count).
      * 
      * @return Formatted header string
      */
@@ -226,6 +407,12 @@ private:
      */
     bool buffered_write(const std::string& data);
     
+    /**
+     * @brief Write raw bytes to output with buffering
+     * @return true if write was successful
+     */
+    bool buffered_write(const char* data, size_t length);
+    
     /**
      * @brief Handle writing error with detailed logging
      * @param error_message Description of the error
@@ -240,7 +427,7 @@ private:
      * @param mbp_row The row to validate
      * @return true if row is valid for writing
      */
-    bool validate_mbp_row(const OrderBook::MBPRow& mbp_row) const;
+    bool validate_mbp_row(const MBPRow& mbp_row) const;
     
     /**
      * @brief Get the current file position/size
@@ -253,10 +440,15 @@ private:
     /**
      * @brief Create empty level string for unused price levels
      * 
-     * When there are fewer than 10 levels on a side, we need to output
+     * When there are fewer than Depth levels on a side, we need to output
      * empty fields for the unused levels.
      * 
      * @return String with empty price, size, and count fields
      */
     std::string create_empty_level_string() const;
-};
\ No newline at end of file
+};
+
+/**
+ * @brief The MBP-10 writer
+ */
+using CsvWriter = BasicCsvWriter<Utils::MAX_DEPTH>;
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief SIMD structural scanner for MBO CSV buffers
+ * 
+ * Finds every ',' and '\n' in a buffer 64 bytes at a time and hands back
+ * their offsets, so the reader can cut lines and fields without looking
+ * at each byte individually. Three kernels are provided:
+ * 
+ * 1. AVX2   - two 32-byte compares per block
+ * 2. SSE4.2 - four 16-byte compares per block
+ * 3. Scalar - portable fallback, also used for the unaligned tail
+ * 
+ * The best kernel supported by the running CPU is picked once at runtime,
+ * so the binary does not need to be built with -mavx2.
+ */
+namespace DelimiterScanner {
+    
+    // Number of bytes classified per kernel call
+    constexpr size_t BLOCK_SIZE = 64;
+    
+    /**
+     * @brief Kernel implementations, in increasing order of preference
+     */
+    enum class Kernel {
+        SCALAR,
+        SSE42,
+        AVX2
+    };
+    
+    /**
+     * @brief Bit masks for one 64-byte block
+     * Bit i is set when byte i of the block is the matching delimiter
+     */
+    struct BlockMasks {
+        uint64_t commas;
+        uint64_t newlines;
+    };
+    
+    /**
+     * @brief Best kernel supported by this CPU (detected once, then cached)
+     */
+    Kernel detect_kernel();
+    
+    /**
+     * @brief Check whether a specific kernel can run on this CPU
+     */
+    bool is_kernel_supported(Kernel kernel);
+    
+    /**
+     * @brief Human-readable kernel name for logging and benchmarks
+     */
+    const char* kernel_name(Kernel kernel);
+    
+    /**
+     * @brief Classify one 64-byte block
+     * 
+     * @param block Pointer to at least BLOCK_SIZE readable bytes
+     * @param kernel Kernel to use (must be supported)
+     * @return Comma and newline masks for the block
+     */
+    BlockMasks scan_block(const char* block, Kernel kernel);
+    
+    /**
+     * @brief Find the offset of every ',' and '\n' in a buffer in one pass
+     * 
+     * Offsets are relative to data and appended to offsets in increasing
+     * order. Buffers must be smaller than 4 GB (callers scan in windows).
+     * 
+     * @param data Start of the buffer
+     * @param length Buffer length in bytes
+     * @param offsets Output vector (appended to)
+     * @param kernel Kernel to use, defaults to the detected one
+     */
+    void find_delimiters(const char* data, size_t length, std::vector<uint32_t>& offsets,
+                         Kernel kernel = detect_kernel());
+    
+    /**
+     * @brief Line and field cursor over a byte range, built on find_delimiters
+     * 
+     * The range is indexed one window at a time (windows always end on a
+     * newline), then lines and their fields are cut straight from the
+     * offset list. Each cursor owns its index, so independent cursors can
+     * run on different threads.
+     */
+    class RecordCursor {
+    public:
+        // Bytes indexed per find_delimiters call
+        static constexpr size_t WINDOW_SIZE = 256 * 1024;
+    
+    private:
+        const char* range_end;
+        const char* window_start;       // Start of the currently indexed window
+        size_t window_length;           // Indexed length (ends just after a newline)
+        size_t cursor;                  // Next unread byte, relative to window_start
+        
+        std::vector<uint32_t> offsets;  // Delimiter offsets within the window
+        size_t offset_pos;              // Next unread entry in offsets
+        Kernel kernel;
+    
+    public:
+        RecordCursor();
+        RecordCursor(const char* begin, const char* end);
+        
+        /**
+         * @brief Restart the cursor on a new byte range
+         */
+        void reset(const char* begin, const char* end);
+        
+        /**
+         * @brief Cut the next line and split it into fields
+         * 
+         * Fields beyond max_fields are counted but not stored. A trailing
+         * '\r' is removed from both the line and its last field.
+         * 
+         * @param line Output view of the whole line (without newline)
+         * @param fields Output array of field views
+         * @param max_fields Capacity of the fields array
+         * @param field_count Output number of fields on the line
+         * @return false once the range is exhausted
+         */
+        bool next(std::string_view& line, std::string_view* fields,
+                  size_t max_fields, size_t& field_count);
+        
+        /**
+         * @brief Pointer to the next unread byte
+         */
+        const char* position() const { return window_start + cursor; }
+    
+    private:
+        /**
+         * @brief Index the next window of the range
+         * @return false if the range is exhausted
+         */
+        bool refill();
+    };
+
+} // namespace DelimiterScanner
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "CsvReader.hpp"
+#include "DelimiterScanner.hpp"
+#include "Order.hpp"
+#include "Utils.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+/**
+ * @brief Zero-copy MBO reader backed by a memory-mapped input file
+ * 
+ * Drop-in alternative to CsvReader for very large inputs. Instead of
+ * pulling every line through std::getline and re-splitting it with an
+ * istringstream, the whole file is mapped read-only and walked with
+ * std::string_view cursors:
+ * 
+ * 1. No per-line or per-field heap allocations
+ * 2. Fields are views straight into the page cache
+ * 3. Line and field boundaries come from the SIMD DelimiterScanner
+ * 4. The kernel is told the access pattern is sequential (read-ahead)
+ * 5. Same header mapping and validation rules as CsvReader
+ */
+class MappedCsvReader {
+public:
+    using ParseResult = CsvReader::ParseResult;
+    
+    /**
+     * @brief Maximum number of fields looked at on a single line
+     * MBO lines have 15 columns, anything beyond this is ignored
+     */
+    static constexpr size_t MAX_FIELDS = 32;
+    
+private:
+    std::string filename;
+    
+    // Mapped file region
+    const char* mapped_data;
+    size_t mapped_size;
+    size_t released_bytes;          // Prefix of the mapping already dropped from memory
+    
+    // Line/field cursor over the mapped region
+    DelimiterScanner::RecordCursor record_cursor;
+
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#else
+    int file_descriptor;
+#endif
+
+    // Column indices (determined from header)
+    struct ColumnIndices {
+        int ts_recv = -1;
+        int ts_event = -1;
+        int publisher_id = -1;
+        int instrument_id = -1;
+        int action = -1;
+        int side = -1;
+        int price = -1;
+        int size = -1;
+        int order_id = -1;
+        int flags = -1;
+        int ts_in_delta = -1;
+        int sequence = -1;
+        int symbol = -1;
+        
+        bool is_valid() const {
+            // Same essential columns as CsvReader, plus symbol
+            return ts_recv >= 0 && ts_event >= 0 && action >= 0 &&
+                   side >= 0 && order_id >= 0 && sequence >= 0 && symbol >= 0;
+        }
+    } column_indices;
+
+public:
+    /**
+     * @brief Constructor maps the whole file read-only
+     * @param csv_filename Path to the CSV file to read
+     */
+    explicit MappedCsvReader(const std::string& csv_filename);
+    
+    /**
+     * @brief Destructor - unmaps the file and closes the handles
+     */
+    ~MappedCsvReader();
+    
+    MappedCsvReader(const MappedCsvReader&) = delete;
+    MappedCsvReader& operator=(const MappedCsvReader&) = delete;
+    
+    /**
+     * @brief Check if the file was mapped successfully
+     */
+    bool is_open() const;
+    
+    /**
+     * @brief Get the filename being processed
+     */
+    const std::string& get_filename() const { return filename; }
+    
+    /**
+     * @brief Get file size in bytes
+     */
+    size_t get_file_size() const { return mapped_size; }
+    
+    /**
+     * @brief Parse the entire file and return all orders
+     * Same contract as CsvReader::parse_all_orders
+     * 
+     * @return ParseResult containing orders and parsing metadata
+     */
+    ParseResult parse_all_orders();
+    
+    /**
+     * @brief Parse orders in chunks for memory-efficient processing
+     * Same contract as CsvReader::parse_in_chunks
+     * 
+     * @param chunk_size Maximum number of orders to parse in one chunk
+     * @param callback Function called for each chunk of orders
+     * @return Overall parsing statistics
+     */
+    ParseResult parse_in_chunks(size_t chunk_size,
+                               std::function<void(const std::vector<Order>&)> callback);
+    
+    /**
+     * @brief Parse byte ranges on worker threads, delivering chunks in file order
+     * 
+     * The data section is cut into ranges of roughly chunk_size lines, each
+     * ending on a newline. Worker threads parse ranges into their own
+     * order vectors, and the calling thread hands them to the callback
+     * strictly in the original order, so the book sees the exact sequence
+     * it would have seen single-threaded. Workers never run more than two
+     * ranges per thread ahead of the callback, which bounds memory.
+     * 
+     * An exception thrown by a worker or by the callback stops every
+     * thread; it is rethrown here once the workers have been joined.
+     * 
+     * @param chunk_size Approximate number of orders per chunk
+     * @param num_threads Worker thread count (0 = hardware concurrency)
+     * @param callback Function called for each chunk, on the calling thread
+     * @return Overall parsing statistics
+     */
+    ParseResult parse_in_chunks_parallel(size_t chunk_size, size_t num_threads,
+                                        std::function<void(const std::vector<Order>&)> callback);
+    
+    /**
+     * @brief Raw view of the mapped file contents
+     */
+    std::string_view data() const { return std::string_view(mapped_data, mapped_size); }
+
+private:
+    /**
+     * @brief Output of one worker-parsed byte range
+     * Reused across ranges so order strings and the delimiter index keep their capacity
+     */
+    struct RangeBatch {
+        std::vector<Order> orders;
+        size_t lines_read = 0;
+        size_t parsing_errors = 0;
+        bool ready = false;
+        DelimiterScanner::RecordCursor cursor;
+    };
+    
+    /**
+     * @brief Map the input file into memory
+     * @return true if the mapping was created
+     */
+    bool map_file();
+    
+    /**
+     * @brief Release the mapping and file handles
+     */
+    void unmap_file();
+    
+    /**
+     * @brief Get the next line from the mapped region, split into fields
+     * 
+     * @param line Output view of the line
+     * @param fields Output array of MAX_FIELDS field views
+     * @param field_count Output number of fields on the line
+     * @return false at end of file
+     */
+    bool next_line(std::string_view& line, std::string_view* fields, size_t& field_count);
+    
+    /**
+     * @brief Read and parse the header line, rewinding to the first data line
+     * @param result ParseResult to record errors in
+     * @return true if header parsing was successful
+     */
+    bool read_header(ParseResult& result);
+    
+    /**
+     * @brief Parse the CSV header and determine column indices
+     * @param fields Header field views
+     * @param field_count Number of header fields
+     * @return true if header parsing was successful
+     */
+    bool parse_header(const std::string_view* fields, size_t field_count);
+    
+    /**
+     * @brief Convert the fields of a single line into an Order object
+     * 
+     * Fields are views into the mapping, so this function only touches
+     * the Order's own (reused) string storage.
+     * 
+     * @param fields Field views of the line
+     * @param field_count Number of fields on the line
+     * @param order Output order object
+     * @return true if parsing was successful
+     */
+    bool parse_line_to_order(const std::string_view* fields, size_t field_count, Order& order) const;
+    
+    /**
+     * @brief Drop already-parsed pages of the mapping from memory
+     * 
+     * Pages are clean and file-backed, but they still count towards RSS
+     * until evicted. Chunked parsing calls this after every delivered
+     * chunk so resident memory stays flat regardless of file size.
+     * 
+     * @param consumed_end Everything before this pointer has been parsed
+     */
+    void release_consumed(const char* consumed_end);
+    
+    /**
+     * @brief Parse one newline-aligned byte range into a batch
+     * Only reads shared state, so it is safe to call from several threads
+     * 
+     * @param begin First byte of the range (start of a line)
+     * @param end One past the last byte (just after a newline, or EOF)
+     * @param batch Output batch, resized to the number of valid orders
+     */
+    void parse_range(const char* begin, const char* end, RangeBatch& batch) const;
+    
+    /**
+     * @brief Cut [begin, end) into ranges of about target_bytes, each ending after a newline
+     * @return Range boundaries; range i is [boundaries[i], boundaries[i + 1])
+     */
+    static std::vector<const char*> split_at_newlines(const char* begin, const char* end,
+                                                      size_t target_bytes);
+    
+    /**
+     * @brief Handle parsing error with detailed logging
+     * @param line_number The line where error occurred
+     * @param error_message Description of the error
+     * @param result ParseResult object to update with error info
+     */
+    void handle_parsing_error(size_t line_number, const std::string& error_message,
+                             ParseResult& result) const;
+};
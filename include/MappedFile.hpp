@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ * 
+ * Small RAII wrapper for the binary readers: the file is mapped once in
+ * the constructor and unmapped in the destructor. Records are then read
+ * in place through data(), without copying them out of the page cache.
+ */
+class MappedFile {
+private:
+    std::string filename;
+    const char* mapped_data;
+    size_t mapped_size;
+
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#else
+    int file_descriptor;
+#endif
+
+public:
+    /**
+     * @brief Constructor maps the file read-only
+     * @param path File to map
+     * @param sequential Hint the kernel that the file is read front to back
+     */
+    explicit MappedFile(const std::string& path, bool sequential = true);
+    
+    /**
+     * @brief Destructor - unmaps the file and closes the handles
+     */
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    /**
+     * @brief Check if the file was mapped (empty files are not)
+     */
+    bool is_open() const { return mapped_data != nullptr; }
+    
+    const std::string& get_filename() const { return filename; }
+    
+    const char* data() const { return mapped_data; }
+    
+    size_t size() const { return mapped_size; }
+
+private:
+    bool map_file(bool sequential);
+    void unmap_file();
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "OrderBook.hpp"
+#include "Utils.hpp"
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <vector>
+
+/**
+ * @brief Reader for delta MBP output (CsvWriter in MbpOutputMode::DELTA)
+ * 
+ * Keeps the running bid/ask levels and applies each row's change tuples
+ * to them by price, handing back complete MBP-10 rows. Writing those rows
+ * with a FULL-mode CsvWriter reproduces the standard output byte for byte.
+ */
+class MbpDeltaReader {
+public:
+    // Event columns before the change tuples: index .. order_id, changes
+    static constexpr size_t EVENT_FIELDS = 17;
+    
+    // Fields per change tuple: side, depth, price, size, count
+    static constexpr size_t TUPLE_FIELDS = 5;
+
+private:
+    std::string filename;
+    std::ifstream input_stream;
+    
+    std::string line;
+    std::vector<std::string_view> fields;       // Reused split buffer
+    size_t line_number;
+    bool malformed;                             // A row failed to parse; reading stopped there
+    
+    // Book levels after the last row read
+    OrderBook::MBPRow::Level bid_levels[Utils::MAX_DEPTH];
+    OrderBook::MBPRow::Level ask_levels[Utils::MAX_DEPTH];
+
+public:
+    /**
+     * @brief Constructor opens the delta file and skips its header
+     * @param delta_filename Path to a delta MBP CSV file
+     */
+    explicit MbpDeltaReader(const std::string& delta_filename);
+    
+    /**
+     * @brief Check if the file was opened and has a delta header
+     */
+    bool is_open() const;
+    
+    /**
+     * @brief Read the next row and expand it to a full MBP-10 row
+     * 
+     * @param mbp_row Output row; every field is overwritten
+     * @return false at end of file or on a malformed row (logged)
+     */
+    bool next_row(OrderBook::MBPRow& mbp_row);
+    
+    /**
+     * @brief Number of the line last read (1-based, header included)
+     */
+    size_t get_line_number() const { return line_number; }
+    
+    /**
+     * @brief Check if reading stopped on a malformed row rather than at end of file
+     */
+    bool has_error() const { return malformed; }
+    
+    /**
+     * @brief Expand a whole delta file into a standard MBP-10 CSV file
+     * 
+     * @param delta_filename Delta MBP CSV file to read
+     * @param output_filename Full MBP-10 CSV file to write
+     * @return Number of rows written, or -1 on error
+     */
+    static long long expand_to_csv(const std::string& delta_filename, const std::string& output_filename);
+
+private:
+    /**
+     * @brief Split the current line on commas into fields
+     */
+    void split_line();
+    
+    /**
+     * @brief Apply the change tuples of the current line to the running levels
+     * @return false if a tuple is malformed
+     */
+    bool apply_changes(size_t change_count);
+    
+    /**
+     * @brief Insert, update or (zero count) remove one level of a side, by price
+     */
+    static void apply_change(OrderBook::MBPRow::Level* levels, bool is_bid,
+                             const OrderBook::MBPRow::Level& change);
+    
+    /**
+     * @brief Parse a price column into price_scaled; empty means no price (0)
+     */
+    static uint64_t parse_price(std::string_view text);
+    
+    /**
+     * @brief Parse a signed integer column (depth may be -1)
+     */
+    static long long parse_signed(std::string_view text);
+};
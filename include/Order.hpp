@@ -23,31 +23,35 @@ struct Order {
     char side;                  // 'B' for bid, 'A' for ask
     char action;                // 'A' for add, 'C' for cancel, 'T' for trade, etc.
     
-    // Timing information
-    std::string ts_recv;        // Reception timestamp
-    std::string ts_event;       // Event timestamp
+    // Timing information (nanoseconds since 1970-01-01T00:00:00Z)
+    int64_t ts_recv;            // Reception timestamp
+    int64_t ts_event;           // Event timestamp
     
     // Additional metadata
     uint32_t flags;             // Order flags
     uint64_t ts_in_delta;       // Timestamp delta
     uint64_t sequence;          // Sequence number
-    std::string symbol;         // Trading symbol
+    uint32_t symbol_id;         // Trading symbol, interned in SymbolTable
+    uint32_t instrument_id;     // Instrument the order belongs to (routes it to a book)
+    uint16_t publisher_id;      // Dataset/venue that published the event
     
     /**
      * @brief Default constructor
      */
     Order() : order_id(0), price_scaled(0), size(0), side('N'), action(' '), 
-              flags(0), ts_in_delta(0), sequence(0) {}
+              ts_recv(0), ts_event(0), flags(0), ts_in_delta(0), sequence(0), symbol_id(0),
+              instrument_id(0), publisher_id(0) {}
     
     /**
      * @brief Parameterized constructor for quick order creation
      */
     Order(uint64_t id, uint64_t price, uint32_t sz, char s, char act, 
-          const std::string& ts_r, const std::string& ts_e, uint32_t f, 
-          uint64_t delta, uint64_t seq, const std::string& sym)
+          int64_t ts_r, int64_t ts_e, uint32_t f, 
+          uint64_t delta, uint64_t seq, uint32_t sym,
+          uint32_t instrument = 0, uint16_t publisher = 0)
         : order_id(id), price_scaled(price), size(sz), side(s), action(act),
           ts_recv(ts_r), ts_event(ts_e), flags(f), ts_in_delta(delta), 
-          sequence(seq), symbol(sym) {}
+          sequence(seq), symbol_id(sym), instrument_id(instrument), publisher_id(publisher) {}
     
     /**
      * @brief Get the actual price as a double
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <memory>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Flat open-addressing hash table from 64-bit order id to a 32-bit value
+ * 
+ * Replaces std::unordered_map for OrderBook::active_orders:
+ * 
+ * 1. Robin Hood probing over one contiguous slot array (no per-entry nodes)
+ * 2. Backward-shift deletion, so erasing never leaves tombstones behind
+ * 3. Incremental growth: when the table fills up, a table of twice the
+ *    size is allocated and every later insert/erase migrates a few slots
+ *    of the old one, so no single operation pays for a full rehash
+ * 4. Slot arrays come from calloc, so large tables are lazily zeroed by
+ *    the OS instead of memset up front
+ * 
+ * While a migration is in progress lookups check both tables; inserts
+ * only ever go to the new one.
+ */
+class OrderIndex {
+private:
+    /**
+     * @brief One bucket; distance is the probe length + 1, 0 marks an empty slot
+     */
+    struct Slot {
+        uint64_t key;
+        uint32_t value;
+        uint32_t distance;
+    };
+    
+    struct FreeDeleter {
+        void operator()(Slot* slots) const { std::free(slots); }
+    };
+    
+    /**
+     * @brief Power-of-two slot array plus its fibonacci-hash shift
+     */
+    struct Table {
+        std::unique_ptr<Slot[], FreeDeleter> slots;
+        size_t slot_count = 0;
+        size_t mask = 0;
+        unsigned shift = 64;
+        size_t count = 0;
+        
+        Table() = default;
+        explicit Table(size_t capacity);
+        
+        size_t capacity() const { return slot_count; }
+        
+        size_t home(uint64_t key) const {
+            // Fibonacci hashing spreads sequential order ids over the high bits
+            return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift);
+        }
+        
+        Slot* find(uint64_t key) {
+            if (count == 0) {
+                return nullptr;
+            }
+            
+            size_t index = home(key);
+            for (uint32_t distance = 1; ; ++distance) {
+                Slot& slot = slots[index];
+                if (slot.distance < distance) {
+                    return nullptr; // Empty, or an entry closer to its home: key absent
+                }
+                if (slot.key == key) {
+                    return &slot;
+                }
+                index = (index + 1) & mask;
+            }
+        }
+        
+        /**
+         * @brief Insert a key known to be absent (the table must have room)
+         */
+        void insert_new(uint64_t key, uint32_t value);
+        
+        /**
+         * @brief Remove the entry at index, shifting its followers back one slot
+         */
+        void erase_at(size_t index);
+    };
+    
+    // Grow once the table is 7/8 full
+    static constexpr size_t LOAD_NUMERATOR = 7;
+    static constexpr size_t LOAD_DENOMINATOR = 8;
+    static constexpr size_t MIN_CAPACITY = 16;
+    
+    // Old-table slots visited per insert/erase while a migration is running
+    static constexpr size_t MIGRATION_STEPS = 16;
+    
+    Table current;
+    Table retiring;                 // Previous table being drained, empty when not migrating
+    size_t migration_cursor;        // Every retiring slot below this has been moved
+
+public:
+    OrderIndex();
+    
+    /**
+     * @brief Find the value stored for a key
+     * @return Pointer to the value (valid until the next insert/erase), nullptr if absent
+     */
+    uint32_t* find(uint64_t key) {
+        Slot* slot = current.find(key);
+        if (slot == nullptr && is_migrating()) {
+            slot = retiring.find(key);
+        }
+        return slot != nullptr ? &slot->value : nullptr;
+    }
+    
+    /**
+     * @brief Insert a key or overwrite its value
+     */
+    void insert_or_assign(uint64_t key, uint32_t value);
+    
+    /**
+     * @brief Remove a key
+     * @return true if the key was present
+     */
+    bool erase(uint64_t key);
+    
+    /**
+     * @brief Number of keys stored
+     */
+    size_t size() const { return current.count + retiring.count; }
+    
+    bool empty() const { return size() == 0; }
+    
+    /**
+     * @brief Make room for at least expected_keys without growing
+     * Rehashes synchronously, so call it up front rather than on the hot path
+     */
+    void reserve(size_t expected_keys);
+    
+    /**
+     * @brief Remove every key (keeps the current capacity)
+     */
+    void clear();
+    
+    /**
+     * @brief Check if an incremental migration is in progress
+     */
+    bool is_migrating() const { return retiring.slot_count != 0; }
+    
+    /**
+     * @brief Current slot capacity (of the newer table while migrating)
+     */
+    size_t capacity() const { return current.capacity(); }
+
+private:
+    /**
+     * @brief Allocate a table twice the size and start draining the old one into it
+     */
+    void start_growth();
+    
+    /**
+     * @brief Move up to steps slots from the retiring table to the current one
+     */
+    void migrate(size_t steps);
+    
+    /**
+     * @brief Smallest power-of-two capacity that holds keys under the load limit
+     */
+    static size_t capacity_for(size_t keys);
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief A resting order, linked into its price level's FIFO queue
+ * 
+ * Nodes refer to each other by pool index rather than pointer, so the
+ * pool can grow without invalidating the links.
+ */
+struct OrderNode {
+    uint64_t order_id;
+    uint64_t price_scaled;
+    uint64_t size;
+    uint32_t prev;              // Older order at the same level (NO_NODE at the head)
+    uint32_t next;              // Newer order at the same level, or next free node
+    char side;
+};
+
+/**
+ * @brief Pooled storage for OrderNode with an intrusive free list
+ * 
+ * Released nodes are recycled before the pool grows, so steady-state add
+ * and cancel traffic never touches the allocator.
+ */
+class OrderPool {
+public:
+    // Null link value
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+private:
+    std::vector<OrderNode> nodes;
+    uint32_t free_head;         // First recycled node, NO_NODE if none
+    size_t live_nodes;
+
+public:
+    OrderPool() : free_head(NO_NODE), live_nodes(0) {}
+    
+    /**
+     * @brief Pre-allocate room for a number of resting orders
+     */
+    void reserve(size_t capacity) { nodes.reserve(capacity); }
+    
+    /**
+     * @brief Take a node from the pool and fill it (unlinked)
+     * @return Index of the node
+     */
+    uint32_t allocate(uint64_t order_id, char side, uint64_t price_scaled, uint64_t size) {
+        uint32_t index;
+        if (free_head != NO_NODE) {
+            index = free_head;
+            free_head = nodes[index].next;
+        } else {
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        
+        nodes[index] = OrderNode{order_id, price_scaled, size, NO_NODE, NO_NODE, side};
+        live_nodes++;
+        return index;
+    }
+    
+    /**
+     * @brief Return an unlinked node to the free list
+     */
+    void release(uint32_t index) {
+        nodes[index].next = free_head;
+        free_head = index;
+        live_nodes--;
+    }
+    
+    OrderNode& operator[](uint32_t index) { return nodes[index]; }
+    const OrderNode& operator[](uint32_t index) const { return nodes[index]; }
+    
+    /**
+     * @brief Number of nodes currently allocated
+     */
+    size_t size() const { return live_nodes; }
+    
+    /**
+     * @brief Release every node (keeps the capacity)
+     */
+    void clear() {
+        nodes.clear();
+        free_head = NO_NODE;
+        live_nodes = 0;
+    }
+};
@@ -1,28 +1,53 @@
 #pragma once
 
 #include "Order.hpp"
+#include "CompactOrder.hpp"
+#include "OrderIndex.hpp"
+#include "OrderPool.hpp"
+#include "PriceLadder.hpp"
 #include "Utils.hpp"
-#include <map>
-#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <functional>
-#include <algorithm>  // ADD THIS LINE - needed for std::find
+#include <string>
 
 /**
- * @brief High-performance order book implementation for MBP-10 reconstruction
+ * @brief High-performance order book implementation for MBP-N reconstruction
  * 
  * This class maintains the state of the limit order book and provides
- * efficient methods for order management and MBP-10 generation.
+ * efficient methods for order management and MBP-N generation.
  * 
  * Key optimizations:
- * - Uses maps for price-level aggregation (automatic sorting)
+ * - Sorted price ladders per side: std::map or a tick-indexed array,
+ *   selected at construction time (see PriceLadder.hpp)
  * - Maintains order tracking for fast cancellations
+ * - Resting orders are pooled nodes in per-level FIFO queues (O(1) cancel)
+ * - Top Depth levels per side cached and updated in place on every mutation,
+ *   so depth lookups and snapshots never walk the ladders
  * - Pre-allocated vectors for MBP output
  * - Minimal memory allocations during hot path operations
+ * - Full L3 state can be checkpointed to a binary snapshot and restored
+ * - T -> F -> C trade sequences are fused into a single T row
+ * 
+ * The number of levels per side in the output is the Depth parameter.
+ * BasicOrderBook<1>, <10> and <50> (MBP-1, MBP-10, MBP-50) are compiled
+ * in OrderBook.cpp; OrderBook is the MBP-10 book used by default.
+ * 
+ * BasicOrderBook<1> is the BBO fast path: it caches a single level per
+ * side and only returns a row when the price, size or count of the best
+ * bid or best ask actually changed.
  */
-class OrderBook {
+template <int Depth>
+class BasicOrderBook {
+    static_assert(Depth == 1 || Depth == 10 || Depth == 50,
+                  "Order book depth must be 1, 10 or 50, the depths with an MBP record type");
+
 public:
+    /**
+     * @brief Levels per side in each MBPRow
+     */
+    static constexpr int DEPTH = Depth;
+    
     /**
      * @brief Price level information
      * Aggregates all orders at a specific price level
@@ -32,41 +57,67 @@ public:
         uint64_t total_size;        // Total size at this price level
         uint32_t order_count;       // Number of orders at this level
         
-        // We maintain order IDs for proper cancellation handling
-        std::vector<uint64_t> order_ids;
+        // FIFO of resting orders (OrderPool indices), oldest first for queue priority
+        uint32_t head;
+        uint32_t tail;
         
-        PriceLevel() : price_scaled(0), total_size(0), order_count(0) {
-            order_ids.reserve(10); // Most price levels have few orders
-        }
+        PriceLevel() : price_scaled(0), total_size(0), order_count(0),
+                       head(OrderPool::NO_NODE), tail(OrderPool::NO_NODE) {}
         
-        PriceLevel(uint64_t price, uint64_t size, uint64_t order_id) 
-            : price_scaled(price), total_size(size), order_count(1) {
-            order_ids.reserve(10);
-            order_ids.push_back(order_id);
-        }
+        explicit PriceLevel(uint64_t price)
+            : price_scaled(price), total_size(0), order_count(0),
+              head(OrderPool::NO_NODE), tail(OrderPool::NO_NODE) {}
         
         /**
-         * @brief Add an order to this price level
+         * @brief Append an order node to the back of this level's queue
          */
-        void add_order(uint64_t order_id, uint64_t size) {
-            order_ids.push_back(order_id);
-            total_size += size;
+        void add_order(OrderPool& pool, uint32_t node_index) {
+            OrderNode& node = pool[node_index];
+            node.prev = tail;
+            node.next = OrderPool::NO_NODE;
+            
+            if (tail != OrderPool::NO_NODE) {
+                pool[tail].next = node_index;
+            } else {
+                head = node_index;
+            }
+            tail = node_index;
+            
+            total_size += node.size;
             order_count++;
         }
         
         /**
-         * @brief Remove an order from this price level
+         * @brief Change the size of a queued order in place (keeps its priority)
+         */
+        void resize_order(OrderPool& pool, uint32_t node_index, uint64_t new_size) {
+            OrderNode& node = pool[node_index];
+            total_size = total_size - node.size + new_size;
+            node.size = new_size;
+        }
+        
+        /**
+         * @brief Unlink an order node from this level's queue in O(1)
          * @return true if the price level becomes empty
          */
-        bool remove_order(uint64_t order_id, uint64_t size) {
-            auto it = std::find(order_ids.begin(), order_ids.end(), order_id);
-            if (it != order_ids.end()) {
-                order_ids.erase(it);
-                total_size -= size;
-                order_count--;
-                return order_count == 0;
+        bool remove_order(OrderPool& pool, uint32_t node_index) {
+            const OrderNode& node = pool[node_index];
+            
+            if (node.prev != OrderPool::NO_NODE) {
+                pool[node.prev].next = node.next;
+            } else {
+                head = node.next;
+            }
+            
+            if (node.next != OrderPool::NO_NODE) {
+                pool[node.next].prev = node.prev;
+            } else {
+                tail = node.prev;
             }
-            return false;
+            
+            total_size -= node.size;
+            order_count--;
+            return order_count == 0;
         }
         
         /**
@@ -78,81 +129,187 @@ public:
     };
     
     /**
-     * @brief MBP-10 output row structure
-     * Represents one row in the output CSV with all 10 bid/ask levels
+     * @brief MBP output row structure
+     * Represents one row in the output CSV with all Depth bid/ask levels
      */
     struct MBPRow {
         // Metadata from the triggering order
-        std::string ts_recv;
-        std::string ts_event;
+        int64_t ts_recv;            // Nanoseconds since epoch
+        int64_t ts_event;
         int rtype;
         int publisher_id;
         int instrument_id;
         char action;
         char side;
         int depth;
-        double price;
+        uint64_t price_scaled;      // Price * 1e9, rendered without going through double
         uint64_t size;
         uint32_t flags;
         uint64_t ts_in_delta;
         uint64_t sequence;
-        std::string symbol;
+        uint32_t symbol_id;         // Interned in SymbolTable
         uint64_t order_id;
         
-        // MBP-10 data: 10 levels each for bid and ask
+        // MBP data: Depth levels each for bid and ask
         struct Level {
-            double price;
+            uint64_t price_scaled;  // Price * 1e9, 0 for an empty level
             uint64_t size;
             uint32_t count;
             
-            Level() : price(0.0), size(0), count(0) {}
-            Level(double p, uint64_t s, uint32_t c) : price(p), size(s), count(c) {}
+            Level() : price_scaled(0), size(0), count(0) {}
+            Level(uint64_t p, uint64_t s, uint32_t c) : price_scaled(p), size(s), count(c) {}
+            
+            double get_price() const { return static_cast<double>(price_scaled) / 1e9; }
         };
         
-        Level bid_levels[Utils::MAX_DEPTH];
-        Level ask_levels[Utils::MAX_DEPTH];
+        Level bid_levels[Depth];
+        Level ask_levels[Depth];
         
-        MBPRow() : rtype(10), publisher_id(2), instrument_id(1108), 
-                   action(' '), side('N'), depth(0), price(0.0), size(0), 
-                   flags(0), ts_in_delta(0), sequence(0), order_id(0) {}
+        MBPRow() : ts_recv(0), ts_event(0), rtype(Depth == 1 ? Utils::RTYPE_MBP1 : Depth == 10 ? Utils::RTYPE_MBP10 : Utils::RTYPE_MBP50), publisher_id(0), instrument_id(0), 
+                   action(' '), side('N'), depth(0), price_scaled(0), size(0), 
+                   flags(0), ts_in_delta(0), sequence(0), symbol_id(0), order_id(0) {}
     };
 
-private:
-    // Bid side: higher prices first (reverse order for max-heap behavior)
-    std::map<uint64_t, PriceLevel, std::greater<uint64_t>> bid_levels;
-    
-    // Ask side: lower prices first (natural order for min-heap behavior)
-    std::map<uint64_t, PriceLevel, std::less<uint64_t>> ask_levels;
+    /**
+     * @brief Header of a snapshot file written by save_snapshot()
+     * 
+     * Followed by the bid side then the ask side, each best level first:
+     * a SnapshotLevel, then its orders oldest first as SnapshotOrder records.
+     */
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t depth;             // Depth of the book that saved it; only that depth loads it
+        uint64_t last_sequence;     // Sequence of the last order processed
+        uint64_t resume_position;   // Caller-defined input position to resume from
+        uint64_t rows_written;      // Caller-defined count of rows output so far
+        uint64_t order_count;
+        uint64_t bid_level_count;
+        uint64_t ask_level_count;
+    };
     
-    // Fast order lookup for cancellations and modifications
-    // Maps order_id -> (side, price_scaled, size)
-    struct OrderInfo {
-        char side;
+    struct SnapshotLevel {
         uint64_t price_scaled;
+        uint32_t order_count;
+        uint32_t reserved;
+    };
+    
+    struct SnapshotOrder {
+        uint64_t order_id;
         uint64_t size;
+    };
+    
+    static constexpr char SNAPSHOT_MAGIC[8] = {'M', 'B', 'O', 'B', 'O', 'O', 'K', '\0'};
+    static constexpr uint32_t SNAPSHOT_VERSION = 3;   // 2: depth stored in the header, 3: rows written
+
+private:
+    /**
+     * @brief Cached copy of the best Depth levels of one side
+     * 
+     * Kept in the exact layout of MBPRow's level arrays so a snapshot is a
+     * plain memcpy. Prices are also kept in price_scaled form for exact
+     * matching. When a side has fewer than Depth levels, the cache holds
+     * all of them; entries past count are zeroed.
+     */
+    struct TopLevels {
+        bool is_bid;
+        int count;
+        uint64_t prices[Depth];
+        typename MBPRow::Level levels[Depth];
+        
+        explicit TopLevels(bool bid_side) : is_bid(bid_side), count(0), prices{} {}
+        
+        /**
+         * @brief Depth of a cached price, -1 if it is not in the top levels
+         */
+        int find(uint64_t price_scaled) const {
+            for (int i = 0; i < count; ++i) {
+                if (prices[i] == price_scaled) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+        
+        bool is_full() const { return count == Depth; }
+        
+        /**
+         * @brief Place a newly created level, pushing the worst one out if full
+         * @return Depth of the new level, -1 if it ranks below the cached levels
+         */
+        int insert(const PriceLevel& level);
+        
+        /**
+         * @brief Refresh size and order count of the level at depth
+         */
+        void update(int depth, const PriceLevel& level);
         
-        OrderInfo() : side('N'), price_scaled(0), size(0) {}
-        OrderInfo(char s, uint64_t p, uint64_t sz) : side(s), price_scaled(p), size(sz) {}
+        /**
+         * @brief Drop the level at depth, moving worse levels up one slot
+         */
+        void remove(int depth);
+        
+        /**
+         * @brief Append a level worse than every cached one (refill after remove)
+         */
+        void append(const PriceLevel& level);
+        
+        void clear();
     };
     
-    std::unordered_map<uint64_t, OrderInfo> active_orders;
+    // Bid side: higher prices first
+    PriceLadder<PriceLevel> bid_levels;
+    
+    // Ask side: lower prices first
+    PriceLadder<PriceLevel> ask_levels;
+    
+    // Best Depth levels of each side, maintained incrementally
+    TopLevels bid_top;
+    TopLevels ask_top;
+    
+    // Storage for every resting order, linked into its level's queue
+    OrderPool order_pool;
+    
+    // Fast order lookup for cancellations and modifications
+    // Maps order_id -> node index in order_pool (side, price_scaled, size)
+    OrderIndex active_orders;
     
     // Performance statistics
     mutable Utils::Statistics stats;
     
     // Pre-allocated MBP row to avoid repeated allocations
     mutable MBPRow current_mbp_row;
+    
+    // Sequence of the last order processed, saved with snapshots
+    uint64_t last_sequence;
+    
+    // T -> F -> C sequence in progress: the trade is held until the fill
+    // names the resting order and the cancel removes it from the book.
+    // Held as a full Order so no input type loses metadata width
+    Order pending_trade;
+    uint64_t pending_fill_order_id;
+    bool trade_pending;
+    bool fill_matched;
+    
+    // Best bid and ask of the last row returned (MBP-1 change detection)
+    typename MBPRow::Level emitted_best_bid;
+    typename MBPRow::Level emitted_best_ask;
+    
+    // Log construction, clears and final statistics (off for per-instrument books)
+    bool verbose;
 
 public:
     /**
      * @brief Constructor initializes the order book
+     * @param ladder_type Price ladder implementation used for both sides
+     * @param verbose_logging Print lifecycle messages and final statistics
      */
-    OrderBook();
+    explicit BasicOrderBook(LadderType ladder_type = DEFAULT_LADDER, bool verbose_logging = true);
     
     /**
-     * @brief Destructor - prints final statistics
+     * @brief Destructor - prints final statistics (when verbose)
      */
-    ~OrderBook();
+    ~BasicOrderBook();
     
     /**
      * @brief Clear the entire order book (for 'R' action)
@@ -170,19 +327,48 @@ public:
      */
     const MBPRow* process_order(const Order& order);
     
+    /**
+     * @brief Process a compact order record
+     * Same book logic as process_order(const Order&), without any string copies
+     * 
+     * @param order The order to process
+     * @return Pointer to MBPRow if update needed, nullptr otherwise
+     */
+    const MBPRow* process_order(const CompactOrder& order);
+    
     /**
      * @brief Add a new order to the book
-     * @param order The order to add
+     * @param order The order to add (Order or CompactOrder)
      * @return true if MBP update should be generated
      */
-    bool add_order(const Order& order);
+    template <typename OrderT>
+    bool add_order(const OrderT& order);
     
     /**
-     * @brief Cancel an existing order
-     * @param order The cancellation order
+     * @brief Cancel an existing order, fully or partially
+     * 
+     * A cancel for less than the resting size reduces the order in place
+     * and keeps its queue priority; otherwise the order is removed.
+     * 
+     * @param order The cancellation order (Order or CompactOrder)
      * @return true if MBP update should be generated
      */
-    bool cancel_order(const Order& order);
+    template <typename OrderT>
+    bool cancel_order(const OrderT& order);
+    
+    /**
+     * @brief Modify an existing order's price and/or size
+     * 
+     * Same price and side: the size changes in place and the order keeps
+     * its queue priority. Otherwise the order is unlinked and appended to
+     * the new level's queue, both O(1). A modify for an unknown order is
+     * treated as an add.
+     * 
+     * @param order The modify order (Order or CompactOrder)
+     * @return true if MBP update should be generated
+     */
+    template <typename OrderT>
+    bool modify_order(const OrderT& order);
     
     /**
      * @brief Process a trade order (special handling as per requirements)
@@ -192,18 +378,36 @@ public:
      * - The T action should be placed on the side that actually changes
      * - If side is 'N', ignore the trade
      * 
-     * @param order The trade order
-     * @return true if MBP update should be generated
+     * The trade becomes pending: its fill and cancel complete it, and the
+     * cancel emits the single combined T row (see complete_trade).
+     * 
+     * @param order The trade order (Order or CompactOrder)
+     * @return false; a trade never generates an MBP update by itself
      */
-    bool process_trade(const Order& order);
+    template <typename OrderT>
+    bool process_trade(const OrderT& order);
     
     /**
-     * @brief Generate current MBP-10 snapshot
+     * @brief Check if a trade is waiting for its fill and cancel
+     * Snapshots taken now would not include the pending trade
+     */
+    bool has_pending_trade() const { return trade_pending; }
+    
+    /**
+     * @brief Generate current MBP snapshot
      * Fills the pre-allocated MBPRow with current book state
      * 
-     * @param triggering_order The order that triggered this update
+     * @param triggering_order The order that triggered this update (Order or CompactOrder)
+     */
+    template <typename OrderT>
+    void generate_mbp_snapshot(const OrderT& triggering_order) const;
+    
+    /**
+     * @brief The row most recently returned by process_order
+     * Stays unchanged until a later call returns a new row, so a caller
+     * may defer writing it (conflation) without copying
      */
-    void generate_mbp_snapshot(const Order& triggering_order) const;
+    const MBPRow& get_last_mbp_row() const { return current_mbp_row; }
     
     /**
      * @brief Get current bid/ask spread
@@ -222,6 +426,47 @@ public:
      */
     std::pair<size_t, size_t> get_level_counts() const;
     
+    /**
+     * @brief Sequence number of the last order processed (0 before the first)
+     */
+    uint64_t get_last_sequence() const { return last_sequence; }
+    
+    /**
+     * @brief Write the full book state to a binary snapshot file
+     * 
+     * Saves every level with its resting orders in queue order, plus the
+     * last processed sequence, so load_snapshot() rebuilds the same book
+     * (same priorities, same MBP output for the following events).
+     * 
+     * @param filename Snapshot file to write
+     * @param resume_position Stored as-is, e.g. the input event count processed so far
+     * @param rows_written Stored as-is, e.g. the MBP rows output so far, so a
+     *                     resumed run can continue the index column
+     * @return true if the snapshot was written completely
+     */
+    bool save_snapshot(const std::string& filename, uint64_t resume_position, uint64_t rows_written) const;
+    
+    /**
+     * @brief Replace the book state with a snapshot written by save_snapshot()
+     * 
+     * The ladder type of this book is kept; statistics are not restored.
+     * The snapshot must come from a book of the same Depth, so a resumed
+     * run keeps writing rows of the layout it started with. A file with
+     * the wrong magic, version or depth leaves the book untouched; one
+     * that is truncated or inconsistent leaves it empty.
+     * 
+     * @param filename Snapshot file to read
+     * @param resume_position Receives the position stored with the snapshot
+     * @param rows_written Receives the row count stored with the snapshot
+     * @return true if the snapshot was loaded
+     */
+    bool load_snapshot(const std::string& filename, uint64_t& resume_position, uint64_t& rows_written);
+    
+    /**
+     * @brief Get the price ladder implementation in use
+     */
+    LadderType get_ladder_type() const { return bid_levels.get_type(); }
+    
     /**
      * @brief Print current book state (for debugging)
      * @param max_levels Maximum levels to print (default 5)
@@ -240,34 +485,92 @@ public:
 
 private:
     /**
-     * @brief Helper function to determine if order affects top 10 levels
-     * Used to optimize MBP generation - only generate updates for relevant changes
+     * @brief Shared dispatch behind both process_order overloads
+     */
+    template <typename OrderT>
+    const MBPRow* process_order_impl(const OrderT& order);
+    
+    /**
+     * @brief Check whether the best bid or ask differs from the last row returned
+     * Records the current best levels as returned; only used by the MBP-1 book
+     */
+    bool best_levels_changed();
+    
+    /**
+     * @brief Queue a pooled order node at the back of its price level
+     * @return Depth of the level in the top levels, -1 if outside them
+     */
+    int attach_order(uint32_t node_index);
+    
+    /**
+     * @brief Change a queued order's size in place, keeping its priority
+     * @return Depth of the level in the top levels, -1 if outside them
+     */
+    int resize_order(uint32_t node_index, uint64_t new_size);
+    
+    /**
+     * @brief Unlink a pooled order node from its price level
+     * The node stays allocated and indexed
+     * @return Depth the level had in the top levels, -1 if outside them
+     */
+    int detach_order(uint32_t node_index);
+    
+    /**
+     * @brief Check if an event is the next step of the pending trade
+     * (its fill at the trade price, or the cancel of the filled order)
+     */
+    template <typename OrderT>
+    bool continues_pending_trade(const OrderT& order) const;
+    
+    /**
+     * @brief Apply the cancel that ends a T -> F -> C sequence
+     * 
+     * Removes the filled order and builds one T row carrying the trade's
+     * fields, on the side of the resting order (the side that changed),
+     * with the depth the trade happened at.
+     * 
+     * @return true if the combined row was generated (the level was in the top Depth)
+     */
+    template <typename OrderT>
+    bool complete_trade(const OrderT& cancel);
+    
+    /**
+     * @brief Refill the last cached slot of a side after a top level emptied
+     * Walks the ladder once, only when the side has more levels than the cache
      * 
-     * @param side The side being modified ('B' or 'A')
-     * @param price_scaled The price level being modified
-     * @return true if this change affects MBP-10 output
+     * @param top Cached top levels of the side
+     * @param levels Price ladder of the same side
+     */
+    static void refill_top_levels(TopLevels& top, const PriceLadder<PriceLevel>& levels);
+    
+    /**
+     * @brief Empty both sides and the order storage (clear() without the logging)
      */
-    bool affects_top_levels(char side, uint64_t price_scaled) const;
+    void clear_state();
     
     /**
-     * @brief Update bid levels in MBP row
-     * @param mbp_row The MBP row to update
+     * @brief Rebuild the cached top levels of a side from its ladder
      */
-    void update_bid_levels(MBPRow& mbp_row) const;
+    static void rebuild_top_levels(TopLevels& top, const PriceLadder<PriceLevel>& levels);
     
     /**
-     * @brief Update ask levels in MBP row
-     * @param mbp_row The MBP row to update
+     * @brief Restore one side from snapshot data
+     * @return false if the data is truncated or inconsistent
      */
-    void update_ask_levels(MBPRow& mbp_row) const;
+    bool load_snapshot_side(const char*& cursor, const char* end, uint64_t level_count, bool is_bid);
     
     /**
      * @brief Get the depth (0-based index) of a price level on given side
-     * Returns -1 if not in top 10
+     * Answered from the cached top levels; returns -1 if not in the top Depth
      * 
      * @param side 'B' for bid, 'A' for ask
      * @param price_scaled The price to check
-     * @return Depth index (0-9) or -1 if not in top 10
+     * @return Depth index (0 to Depth-1) or -1 if not in the top Depth
      */
     int get_price_depth(char side, uint64_t price_scaled) const;
-};
\ No newline at end of file
+};
+
+/**
+ * @brief The MBP-10 order book
+ */
+using OrderBook = BasicOrderBook<Utils::MAX_DEPTH>;
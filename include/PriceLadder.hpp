@@ -0,0 +1,493 @@
+#pragma once
+
+#include "Utils.hpp"
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <numeric>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Price level containers for one side of the order book
+ * 
+ * Two interchangeable implementations keyed by price_scaled:
+ * 
+ * 1. MapLadder   - std::map red-black tree (the original layout)
+ * 2. ArrayLadder - contiguous slots indexed by (price_scaled - base) / tick
+ * 
+ * PriceLadder picks one at runtime so both can be A/B tested on the same
+ * input. Every container hands levels out best price first: highest
+ * first for bids, lowest first for asks.
+ */
+
+/**
+ * @brief Available price ladder implementations
+ */
+enum class LadderType {
+    MAP,
+    ARRAY
+};
+
+// Ladder used when none is requested explicitly; build with
+// -DMBP_ARRAY_LADDER to make the array ladder the default
+#ifdef MBP_ARRAY_LADDER
+constexpr LadderType DEFAULT_LADDER = LadderType::ARRAY;
+#else
+constexpr LadderType DEFAULT_LADDER = LadderType::MAP;
+#endif
+
+/**
+ * @brief Human-readable ladder name for logging and benchmarks
+ */
+inline const char* ladder_type_name(LadderType type) {
+    return type == LadderType::ARRAY ? "array" : "map";
+}
+
+/**
+ * @brief Tree-backed ladder (one std::map node per price level)
+ */
+template <typename LevelT>
+class MapLadder {
+private:
+    bool is_bid;
+    std::map<uint64_t, LevelT> levels;     // Ascending; bids are walked in reverse
+
+public:
+    explicit MapLadder(bool bid_side) : is_bid(bid_side) {}
+    
+    LevelT* find(uint64_t price_scaled) {
+        auto iter = levels.find(price_scaled);
+        return iter != levels.end() ? &iter->second : nullptr;
+    }
+    
+    const LevelT* find(uint64_t price_scaled) const {
+        auto iter = levels.find(price_scaled);
+        return iter != levels.end() ? &iter->second : nullptr;
+    }
+    
+    /**
+     * @brief Get the level at a price, default-constructing it if missing
+     */
+    LevelT& insert(uint64_t price_scaled) {
+        return levels[price_scaled];
+    }
+    
+    void erase(uint64_t price_scaled) {
+        levels.erase(price_scaled);
+    }
+    
+    /**
+     * @brief Visit levels best price first until fn returns false
+     * @param fn Callable as bool(uint64_t price_scaled, const LevelT& level)
+     */
+    template <typename Fn>
+    void for_each_best(Fn&& fn) const {
+        if (is_bid) {
+            for (auto iter = levels.rbegin(); iter != levels.rend(); ++iter) {
+                if (!fn(iter->first, iter->second)) return;
+            }
+        } else {
+            for (auto iter = levels.begin(); iter != levels.end(); ++iter) {
+                if (!fn(iter->first, iter->second)) return;
+            }
+        }
+    }
+    
+    size_t size() const { return levels.size(); }
+    bool empty() const { return levels.empty(); }
+    void clear() { levels.clear(); }
+};
+
+/**
+ * @brief Tick-indexed ladder backed by a contiguous slot array
+ * 
+ * A window of SLOT_COUNT ticks around the touch lives in a flat array,
+ * with an occupancy bitmap so the best price and the next levels are
+ * found with a few count-leading/trailing-zeros over hot cache lines.
+ * 
+ * Prices that fall outside the window on the far side of the book go to
+ * a small overflow map; by construction every overflow level is worse
+ * than every window level, so best-first order is window, then overflow.
+ * A price better than anything in the window (the market moved) recenters
+ * the window on it, and so does emptying the window while overflow still
+ * holds levels, so the window is only ever empty when the side is. The tick starts at one cent and is narrowed to the
+ * gcd of the prices seen if the instrument trades on a finer grid.
+ */
+template <typename LevelT>
+class ArrayLadder {
+public:
+    // Ticks covered by the window
+    static constexpr size_t SLOT_COUNT = 4096;
+    
+    // Initial tick: one cent in price_scaled units
+    static constexpr uint64_t DEFAULT_TICK = Utils::PRICE_SCALE / 100;
+
+private:
+    static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+    static constexpr size_t WORD_BITS = 64;
+    
+    bool is_bid;
+    uint64_t tick;
+    uint64_t base;                          // Price of slot 0
+    
+    std::vector<LevelT> slots;
+    std::vector<uint64_t> occupied;         // Bit i set when slots[i] holds a level
+    size_t window_levels;                   // Number of set bits in occupied
+    size_t best_slot;                       // NO_SLOT when the window is empty
+    
+    std::map<uint64_t, LevelT> overflow;    // Far-side levels outside the window
+
+public:
+    explicit ArrayLadder(bool bid_side)
+        : is_bid(bid_side), tick(DEFAULT_TICK), base(0),
+          slots(SLOT_COUNT), occupied(SLOT_COUNT / WORD_BITS, 0),
+          window_levels(0), best_slot(NO_SLOT) {}
+    
+    LevelT* find(uint64_t price_scaled) {
+        return const_cast<LevelT*>(static_cast<const ArrayLadder*>(this)->find(price_scaled));
+    }
+    
+    const LevelT* find(uint64_t price_scaled) const {
+        size_t slot = slot_of(price_scaled);
+        if (slot != NO_SLOT) {
+            return is_occupied(slot) ? &slots[slot] : nullptr;
+        }
+        
+        auto iter = overflow.find(price_scaled);
+        return iter != overflow.end() ? &iter->second : nullptr;
+    }
+    
+    /**
+     * @brief Get the level at a price, default-constructing it if missing
+     */
+    LevelT& insert(uint64_t price_scaled) {
+        if (price_scaled % tick != 0) {
+            // Finer price grid than assumed: narrow the tick and rebuild
+            rebuild(std::gcd(tick, price_scaled), best_price_or(price_scaled));
+        }
+        
+        size_t slot = slot_of(price_scaled);
+        
+        if (slot == NO_SLOT && (window_levels == 0 || is_better_than_window(price_scaled))) {
+            // The touch moved outside the window: recenter on the new best
+            rebuild(tick, price_scaled);
+            slot = slot_of(price_scaled);
+        }
+        
+        if (slot == NO_SLOT) {
+            return overflow[price_scaled];
+        }
+        
+        if (!is_occupied(slot)) {
+            mark_occupied(slot);
+        }
+        return slots[slot];
+    }
+    
+    void erase(uint64_t price_scaled) {
+        size_t slot = slot_of(price_scaled);
+        if (slot == NO_SLOT) {
+            overflow.erase(price_scaled);
+            return;
+        }
+        
+        if (!is_occupied(slot)) {
+            return;
+        }
+        
+        slots[slot] = LevelT();
+        occupied[slot / WORD_BITS] &= ~(1ULL << (slot % WORD_BITS));
+        window_levels--;
+        
+        if (slot == best_slot) {
+            best_slot = next_worse(slot);
+        }
+        
+        if (window_levels == 0 && !overflow.empty()) {
+            // Only overflow levels are left: recenter on the best of them so
+            // later inserts never see an empty window in front of better prices
+            rebuild(tick, best_price_or(0));
+        }
+    }
+    
+    /**
+     * @brief Visit levels best price first until fn returns false
+     * @param fn Callable as bool(uint64_t price_scaled, const LevelT& level)
+     */
+    template <typename Fn>
+    void for_each_best(Fn&& fn) const {
+        for (size_t slot = best_slot; slot != NO_SLOT; slot = next_worse(slot)) {
+            if (!fn(price_of(slot), slots[slot])) return;
+        }
+        
+        if (is_bid) {
+            for (auto iter = overflow.rbegin(); iter != overflow.rend(); ++iter) {
+                if (!fn(iter->first, iter->second)) return;
+            }
+        } else {
+            for (auto iter = overflow.begin(); iter != overflow.end(); ++iter) {
+                if (!fn(iter->first, iter->second)) return;
+            }
+        }
+    }
+    
+    size_t size() const { return window_levels + overflow.size(); }
+    bool empty() const { return size() == 0; }
+    
+    void clear() {
+        for (size_t slot = best_slot; slot != NO_SLOT; slot = next_worse(slot)) {
+            slots[slot] = LevelT();
+        }
+        std::fill(occupied.begin(), occupied.end(), 0);
+        window_levels = 0;
+        best_slot = NO_SLOT;
+        overflow.clear();
+        tick = DEFAULT_TICK;
+        base = 0;
+    }
+
+private:
+    uint64_t price_of(size_t slot) const {
+        return base + slot * tick;
+    }
+    
+    /**
+     * @brief Slot index for a price, NO_SLOT if outside the window or off-grid
+     */
+    size_t slot_of(uint64_t price_scaled) const {
+        if (price_scaled < base || (price_scaled - base) % tick != 0) {
+            return NO_SLOT;
+        }
+        uint64_t slot = (price_scaled - base) / tick;
+        return slot < SLOT_COUNT ? static_cast<size_t>(slot) : NO_SLOT;
+    }
+    
+    bool is_occupied(size_t slot) const {
+        return (occupied[slot / WORD_BITS] >> (slot % WORD_BITS)) & 1;
+    }
+    
+    void mark_occupied(size_t slot) {
+        occupied[slot / WORD_BITS] |= 1ULL << (slot % WORD_BITS);
+        window_levels++;
+        
+        if (best_slot == NO_SLOT || (is_bid ? slot > best_slot : slot < best_slot)) {
+            best_slot = slot;
+        }
+    }
+    
+    bool is_better_than_window(uint64_t price_scaled) const {
+        return is_bid ? price_scaled > price_of(SLOT_COUNT - 1) : price_scaled < base;
+    }
+    
+    /**
+     * @brief Best price on this side, or fallback when the side is empty
+     */
+    uint64_t best_price_or(uint64_t fallback) const {
+        if (best_slot != NO_SLOT) {
+            return price_of(best_slot);
+        }
+        if (!overflow.empty()) {
+            return is_bid ? overflow.rbegin()->first : overflow.begin()->first;
+        }
+        return fallback;
+    }
+    
+    /**
+     * @brief Next occupied slot after slot, walking away from the touch
+     */
+    size_t next_worse(size_t slot) const {
+        return is_bid ? highest_occupied_below(slot) : lowest_occupied_above(slot);
+    }
+    
+    size_t highest_occupied_below(size_t slot) const {
+        if (slot == 0) {
+            return NO_SLOT;
+        }
+        
+        size_t index = slot - 1;
+        size_t word = index / WORD_BITS;
+        uint64_t bits = occupied[word] & (~0ULL >> (WORD_BITS - 1 - index % WORD_BITS));
+        
+        while (true) {
+            if (bits) {
+                return word * WORD_BITS + (WORD_BITS - 1 - count_leading_zeros(bits));
+            }
+            if (word == 0) {
+                return NO_SLOT;
+            }
+            bits = occupied[--word];
+        }
+    }
+    
+    size_t lowest_occupied_above(size_t slot) const {
+        size_t index = slot + 1;
+        if (index >= SLOT_COUNT) {
+            return NO_SLOT;
+        }
+        
+        size_t word = index / WORD_BITS;
+        uint64_t bits = occupied[word] & (~0ULL << (index % WORD_BITS));
+        
+        while (true) {
+            if (bits) {
+                return word * WORD_BITS + count_trailing_zeros(bits);
+            }
+            if (++word == occupied.size()) {
+                return NO_SLOT;
+            }
+            bits = occupied[word];
+        }
+    }
+    
+    /**
+     * @brief Re-place every level on a window of the given tick centered on center_price
+     */
+    void rebuild(uint64_t new_tick, uint64_t center_price) {
+        std::vector<std::pair<uint64_t, LevelT>> levels;
+        levels.reserve(size());
+        
+        for (size_t slot = best_slot; slot != NO_SLOT; slot = next_worse(slot)) {
+            levels.emplace_back(price_of(slot), std::move(slots[slot]));
+            slots[slot] = LevelT();
+        }
+        for (auto& [price, level] : overflow) {
+            levels.emplace_back(price, std::move(level));
+        }
+        
+        std::fill(occupied.begin(), occupied.end(), 0);
+        window_levels = 0;
+        best_slot = NO_SLOT;
+        overflow.clear();
+        
+        tick = new_tick;
+        uint64_t half_span = (SLOT_COUNT / 2) * tick;
+        uint64_t center = center_price - center_price % tick;
+        base = center > half_span ? center - half_span : 0;
+        
+        for (auto& [price, level] : levels) {
+            size_t slot = slot_of(price);
+            if (slot == NO_SLOT) {
+                overflow.emplace(price, std::move(level));
+            } else {
+                slots[slot] = std::move(level);
+                mark_occupied(slot);
+            }
+        }
+    }
+    
+    static unsigned count_leading_zeros(uint64_t mask) {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_clzll(mask));
+#else
+        unsigned count = 0;
+        while ((mask & (1ULL << 63)) == 0) {
+            mask <<= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+    
+    static unsigned count_trailing_zeros(uint64_t mask) {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(mask));
+#else
+        unsigned count = 0;
+        while ((mask & 1) == 0) {
+            mask >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+};
+
+/**
+ * @brief One side of the book with the ladder implementation chosen at runtime
+ * 
+ * Forwards to either a MapLadder or an ArrayLadder. The type never changes
+ * after construction, so the dispatch branch is perfectly predicted.
+ */
+template <typename LevelT>
+class PriceLadder {
+private:
+    LadderType type;
+    MapLadder<LevelT> map_ladder;
+    ArrayLadder<LevelT> array_ladder;
+
+public:
+    PriceLadder(bool bid_side, LadderType ladder_type)
+        : type(ladder_type), map_ladder(bid_side), array_ladder(bid_side) {}
+    
+    LadderType get_type() const { return type; }
+    
+    /**
+     * @brief Get the level at a price, nullptr if there is none
+     */
+    LevelT* find(uint64_t price_scaled) {
+        return type == LadderType::ARRAY ? array_ladder.find(price_scaled) : map_ladder.find(price_scaled);
+    }
+    
+    const LevelT* find(uint64_t price_scaled) const {
+        return type == LadderType::ARRAY ? array_ladder.find(price_scaled) : map_ladder.find(price_scaled);
+    }
+    
+    /**
+     * @brief Get the level at a price, default-constructing it if missing
+     */
+    LevelT& insert(uint64_t price_scaled) {
+        return type == LadderType::ARRAY ? array_ladder.insert(price_scaled) : map_ladder.insert(price_scaled);
+    }
+    
+    /**
+     * @brief Remove the level at a price (no-op if there is none)
+     */
+    void erase(uint64_t price_scaled) {
+        if (type == LadderType::ARRAY) {
+            array_ladder.erase(price_scaled);
+        } else {
+            map_ladder.erase(price_scaled);
+        }
+    }
+    
+    /**
+     * @brief Visit levels best price first until fn returns false
+     * @param fn Callable as bool(uint64_t price_scaled, const LevelT& level)
+     */
+    template <typename Fn>
+    void for_each_best(Fn&& fn) const {
+        if (type == LadderType::ARRAY) {
+            array_ladder.for_each_best(fn);
+        } else {
+            map_ladder.for_each_best(fn);
+        }
+    }
+    
+    /**
+     * @brief Best level on this side, nullptr if the side is empty
+     */
+    const LevelT* best() const {
+        const LevelT* best_level = nullptr;
+        for_each_best([&best_level](uint64_t, const LevelT& level) {
+            best_level = &level;
+            return false;
+        });
+        return best_level;
+    }
+    
+    size_t size() const {
+        return type == LadderType::ARRAY ? array_ladder.size() : map_ladder.size();
+    }
+    
+    bool empty() const { return size() == 0; }
+    
+    void clear() {
+        if (type == LadderType::ARRAY) {
+            array_ladder.clear();
+        } else {
+            map_ladder.clear();
+        }
+    }
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CsvReader.hpp"
+#include "MappedCsvReader.hpp"
+#include "BinaryMboReader.hpp"
+#include "CsvWriter.hpp"
+#include "OrderBook.hpp"
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief The order -> book -> writer loop of a single-book reconstruction
+ * 
+ * apply_order feeds one event through the book and hands the resulting
+ * row to the writer, taking care of the restored-checkpoint prefix, the
+ * initial clear, conflation buckets and periodic checkpoints. Every
+ * single-book path (in-memory, --stream, --threads, --pipeline) drives
+ * the same function, so they produce the same rows.
+ */
+
+// Orders per chunk handed from the chunked parser to the order book
+constexpr size_t PARSE_CHUNK_SIZE = 8192;
+
+// Order batches cycling between the --pipeline reader and book stages
+constexpr size_t PIPELINE_BATCHES = 8;
+
+/**
+ * @brief Running state of the order -> book -> writer loop
+ * Shared by the whole-file and the chunked processing paths
+ */
+struct ReconstructionProgress {
+    size_t total_orders = 0;            // Known (or estimated) order count for progress output
+    size_t processed_orders = 0;
+    size_t mbp_updates = 0;
+    bool first_clear_ignored = false;
+    
+    // Checkpointing: events already in a restored book, and where/how often to snapshot
+    uint64_t resume_position = 0;
+    uint64_t resume_rows = 0;           // Rows written before the restored checkpoint
+    std::string checkpoint_filename;
+    size_t checkpoint_interval = 0;
+    uint64_t next_checkpoint = 0;
+    
+    // Conflation: the book's last row is held until an event from a later bucket arrives
+    int64_t conflate_interval_ns = 0;
+    bool conflate_on_recv = false;
+    int64_t conflation_bucket = std::numeric_limits<int64_t>::min();
+    bool conflated_row_pending = false;
+    size_t conflated_rows = 0;          // Rows replaced by a later row of the same bucket
+};
+
+/**
+ * @brief Snapshot the order book to the checkpoint file
+ * 
+ * The snapshot is written next to the checkpoint and renamed over it, so
+ * an interrupted run always leaves the previous complete checkpoint behind.
+ * 
+ * @return false if the snapshot could not be written
+ */
+template <int Depth>
+bool save_checkpoint(const BasicOrderBook<Depth>& order_book, const ReconstructionProgress& progress);
+
+/**
+ * @brief Write the row held back by conflation, if there is one
+ * The held row is the book's last returned row, still intact because no
+ * event has produced a newer one since
+ * 
+ * @return false if the row could not be written
+ */
+template <int Depth>
+bool write_conflated_row(const BasicOrderBook<Depth>& order_book, BasicCsvWriter<Depth>& csv_writer,
+                         ReconstructionProgress& progress);
+
+/**
+ * @brief Feed one order through the order book and write any resulting MBP row
+ * 
+ * @param order The order to apply
+ * @param order_book Book receiving the order
+ * @param csv_writer Writer for generated MBP rows
+ * @param progress Running counters, updated in place
+ * @return false if an MBP row could not be written
+ */
+template <int Depth, typename OrderT>
+bool apply_order(const OrderT& order, BasicOrderBook<Depth>& order_book, BasicCsvWriter<Depth>& csv_writer,
+                 ReconstructionProgress& progress);
+
+/**
+ * @brief Parse the input in chunks with whichever reader is open
+ * 
+ * @param csv_reader Buffered reader, or nullptr when another reader is used
+ * @param mapped_reader Memory-mapped reader, or nullptr
+ * @param binary_reader Binary MBO reader, or nullptr
+ * @param chunk_size Orders per chunk
+ * @param parse_threads Parser threads (1 = parse on the calling thread)
+ * @param callback Receives each chunk in file order
+ * @return Overall parsing statistics
+ */
+CsvReader::ParseResult parse_chunks(CsvReader* csv_reader, MappedCsvReader* mapped_reader,
+                                    BinaryMboReader* binary_reader, size_t chunk_size, size_t parse_threads,
+                                    std::function<void(const std::vector<Order>&)> callback);
+
+/**
+ * @brief Run reconstruction as a three-stage pipeline
+ * 
+ * 1. Reader thread: parses chunks into recycled OrderBatch objects
+ * 2. Book stage (calling thread): applies each batch to the order book
+ * 3. Writer thread: the CsvWriter async mode, formatting and writing rows
+ * 
+ * Batches cycle through two SpscRings (filled: reader -> book, free:
+ * book -> reader), so parsing is at most PIPELINE_BATCHES batches ahead
+ * and no batch is allocated after start-up. MBP rows reach the writer
+ * through the CsvWriter's own ring. Each stage's events/sec and blocked
+ * time are printed at the end; the least blocked stage is the bottleneck.
+ * 
+ * @param parse_threads Parser threads for the reader stage (1 = one thread)
+ * @param parse_result Filled with the reader's parsing statistics
+ * @return false if the pipeline failed (parse exception or write error)
+ */
+template <int Depth>
+bool run_pipeline(CsvReader* csv_reader, MappedCsvReader* mapped_reader, BinaryMboReader* binary_reader,
+                  size_t parse_threads, BasicOrderBook<Depth>& order_book, BasicCsvWriter<Depth>& csv_writer,
+                  ReconstructionProgress& progress, CsvReader::ParseResult& parse_result);
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring buffer
+ * 
+ * Hands fixed-size records from one thread to another without locks:
+ * 
+ * 1. Power-of-two slot array, indices wrap with a mask
+ * 2. Producer and consumer indices live on separate cache lines, and
+ *    each side caches the other's index so the shared line is only
+ *    re-read when the ring looks full (or empty)
+ * 3. A full ring blocks the producer (backpressure), so memory stays
+ *    bounded by the capacity no matter how far the consumer falls behind
+ * 4. Blocking waits spin briefly with yield, then sleep, so an idle side
+ *    does not burn a core; time spent blocked is accumulated per side
+ * 
+ * Exactly one thread may push and exactly one thread may pop.
+ */
+template <typename T>
+class SpscRing {
+public:
+    // Cache line size assumed for padding the shared indices
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+private:
+    // Failed attempts that yield before a blocked side starts sleeping
+    static constexpr unsigned SPIN_LIMIT = 64;
+    static constexpr std::chrono::microseconds SLEEP_INTERVAL{50};
+    
+    std::unique_ptr<T[]> slots;
+    size_t mask;
+    
+    // Producer side: next slot to fill, plus its view of the consumer index
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail;
+    size_t cached_head;
+    uint64_t producer_blocked_ns;
+    
+    // Consumer side: next slot to drain, plus its view of the producer index
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head;
+    size_t cached_tail;
+    uint64_t consumer_blocked_ns;
+    
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> closed;
+
+public:
+    /**
+     * @brief Constructor allocates the slots
+     * @param min_capacity Minimum number of records; rounded up to a power of two
+     */
+    explicit SpscRing(size_t min_capacity)
+        : mask(round_up_pow2(min_capacity) - 1),
+          tail(0), cached_head(0), producer_blocked_ns(0),
+          head(0), cached_tail(0), consumer_blocked_ns(0),
+          closed(false) {
+        slots = std::make_unique<T[]>(mask + 1);
+    }
+    
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    
+    size_t capacity() const { return mask + 1; }
+    
+    /**
+     * @brief Append a record if there is room (producer only)
+     * @return false if the ring is full
+     */
+    template <typename U>
+    bool try_push(U&& item) {
+        size_t index = tail.load(std::memory_order_relaxed);
+        if (index - cached_head > mask) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (index - cached_head > mask) {
+                return false;
+            }
+        }
+        
+        slots[index & mask] = std::forward<U>(item);
+        tail.store(index + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Take the oldest record if there is one (consumer only)
+     * @return false if the ring is empty
+     */
+    bool try_pop(T& item) {
+        size_t index = head.load(std::memory_order_relaxed);
+        if (index == cached_tail) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (index == cached_tail) {
+                return false;
+            }
+        }
+        
+        item = std::move(slots[index & mask]);
+        head.store(index + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Append a record, waiting while the ring is full (producer only)
+     */
+    template <typename U>
+    void push(U&& item) {
+        if (try_push(std::forward<U>(item))) {
+            return;
+        }
+        
+        auto blocked_start = std::chrono::steady_clock::now();
+        for (unsigned attempts = 0; !try_push(std::forward<U>(item)); ++attempts) {
+            back_off(attempts);
+        }
+        producer_blocked_ns += elapsed_ns(blocked_start);
+    }
+    
+    /**
+     * @brief Take the oldest record, waiting while the ring is empty (consumer only)
+     * @return false once the ring is closed and fully drained
+     */
+    bool pop(T& item) {
+        if (try_pop(item)) {
+            return true;
+        }
+        
+        auto blocked_start = std::chrono::steady_clock::now();
+        bool popped = false;
+        for (unsigned attempts = 0; ; ++attempts) {
+            // Read closed before retrying, so a push made just before close() is not lost
+            bool was_closed = closed.load(std::memory_order_acquire);
+            if (try_pop(item)) {
+                popped = true;
+                break;
+            }
+            if (was_closed) {
+                break;
+            }
+            back_off(attempts);
+        }
+        consumer_blocked_ns += elapsed_ns(blocked_start);
+        return popped;
+    }
+    
+    /**
+     * @brief Mark the end of the stream; pop() returns false once drained
+     */
+    void close() { closed.store(true, std::memory_order_release); }
+    
+    bool is_closed() const { return closed.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Check if every pushed record has been popped
+     */
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Time the producer spent waiting on a full ring
+     * Read it from the producer thread, or after both threads are done
+     */
+    double get_producer_blocked_ms() const { return producer_blocked_ns / 1e6; }
+    
+    /**
+     * @brief Time the consumer spent waiting on an empty ring
+     * Read it from the consumer thread, or after both threads are done
+     */
+    double get_consumer_blocked_ms() const { return consumer_blocked_ns / 1e6; }
+
+private:
+    static size_t round_up_pow2(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+    
+    static void back_off(unsigned attempts) {
+        if (attempts < SPIN_LIMIT) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(SLEEP_INTERVAL);
+        }
+    }
+    
+    static uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+};
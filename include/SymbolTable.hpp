@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+/**
+ * @brief Process-wide interning table mapping trading symbols to dense 32-bit ids
+ * 
+ * Readers intern each symbol once, when it is first seen; after that only
+ * the id flows through orders, the book and MBP rows, and the writer turns
+ * it back into text. Ids are assigned in first-seen order and never change,
+ * so they can be used directly as array indices. Id 0 is reserved for the
+ * empty symbol.
+ * 
+ * Interning and lookups are thread-safe, so parallel parse workers can
+ * share the table. Each thread remembers its last symbol, which keeps the
+ * common single-symbol feed off the lock entirely.
+ */
+class SymbolTable {
+public:
+    // Id of the empty symbol
+    static constexpr uint32_t NO_SYMBOL = 0;
+
+private:
+    std::unordered_map<std::string, uint32_t> symbol_ids;
+    std::deque<std::string> symbols;        // id -> symbol text (stable references)
+    mutable std::mutex table_mutex;
+
+public:
+    SymbolTable();
+    
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+    
+    /**
+     * @brief The process-wide table shared by readers, books and writers
+     */
+    static SymbolTable& instance();
+    
+    /**
+     * @brief Get the id for a symbol, assigning a new one on first sight
+     * @param symbol Symbol text
+     * @return Dense symbol id (NO_SYMBOL for an empty symbol)
+     */
+    uint32_t intern(std::string_view symbol);
+    
+    /**
+     * @brief Get the symbol text for an id
+     * The returned reference stays valid for the lifetime of the table
+     * 
+     * @param id Id previously returned by intern()
+     * @return Symbol text, or an empty string for unknown ids
+     */
+    const std::string& lookup(uint32_t id) const;
+    
+    /**
+     * @brief Number of ids assigned so far (including NO_SYMBOL)
+     */
+    size_t size() const;
+};
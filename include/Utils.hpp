@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <vector>
 #include <chrono>
 #include <sstream>
@@ -17,9 +19,16 @@
 namespace Utils {
     
     // Constants for performance optimization
-    constexpr int MAX_DEPTH = 10;              // Maximum depth for MBP-10
+    constexpr int MAX_DEPTH = 10;              // Default book depth (MBP-10)
     constexpr double PRICE_EPSILON = 1e-9;     // Precision for price comparisons
+    constexpr uint64_t PRICE_SCALE = 1000000000ULL;  // Fixed-point scale (9 decimals)
+    constexpr int PRICE_DECIMALS = 9;          // Decimal places in PRICE_SCALE
+    constexpr int MAX_PRICE_INTEGER_DIGITS = 10; // Longest integer part parse_price_scaled accepts
+    constexpr size_t TIMESTAMP_LENGTH = 30;    // "YYYY-MM-DDTHH:MM:SS.fffffffffZ"
     constexpr size_t INITIAL_RESERVE_SIZE = 10000; // Initial vector reserve size
+    constexpr int RTYPE_MBP1 = 1;              // Record type of an MBP-1 (BBO) output row
+    constexpr int RTYPE_MBP10 = 10;            // Record type of an MBP-10 output row
+    constexpr int RTYPE_MBP50 = 50;            // Record type of an MBP-50 output row (no feed equivalent)
     
     // Action types as constants for faster comparison
     constexpr char ACTION_ADD = 'A';
@@ -27,6 +36,7 @@ namespace Utils {
     constexpr char ACTION_TRADE = 'T';
     constexpr char ACTION_FILL = 'F';
     constexpr char ACTION_CLEAR = 'R';
+    constexpr char ACTION_MODIFY = 'M';
     
     // Side types
     constexpr char SIDE_BID = 'B';
@@ -52,6 +62,30 @@ namespace Utils {
      */
     double fast_string_to_double(const std::string& str);
     
+    /**
+     * @brief Fast string to double conversion for non-terminated views
+     * Copies the digits into a small stack buffer before calling strtod
+     * 
+     * @param str The string view to convert
+     * @return Converted double value, 0.0 if conversion fails
+     */
+    double fast_string_to_double(std::string_view str);
+    
+    /**
+     * @brief Parse decimal price text straight into the fixed-point scale
+     * 
+     * Converts text such as "5.510000000" into price * 1e9 using integer
+     * arithmetic only, so no double (and no -ffast-math rounding) sits
+     * between the CSV and the order book. The feed's fixed 9-decimal
+     * layout takes a SWAR fast path; other layouts fall back to a digit
+     * loop. Digits past the 9th decimal are rounded half-up.
+     * 
+     * @param str The price text (already trimmed)
+     * @return Scaled price, 0 if the text is empty, negative, malformed or
+     *         has more than MAX_PRICE_INTEGER_DIGITS integer digits
+     */
+    uint64_t parse_price_scaled(std::string_view str);
+    
     /**
      * @brief Fast string to uint64_t conversion
      * Optimized for order ID and sequence number parsing
@@ -59,7 +93,7 @@ namespace Utils {
      * @param str The string to convert
      * @return Converted uint64_t value, 0 if conversion fails
      */
-    uint64_t fast_string_to_uint64(const std::string& str);
+    uint64_t fast_string_to_uint64(std::string_view str);
     
     /**
      * @brief Fast string to uint32_t conversion
@@ -68,7 +102,66 @@ namespace Utils {
      * @param str The string to convert
      * @return Converted uint32_t value, 0 if conversion fails
      */
-    uint32_t fast_string_to_uint32(const std::string& str);
+    uint32_t fast_string_to_uint32(std::string_view str);
+    
+    /**
+     * @brief Parse an ISO-8601 UTC timestamp into nanoseconds since the epoch
+     * 
+     * The feed's fixed "YYYY-MM-DDTHH:MM:SS.fffffffffZ" layout is parsed
+     * branch-free; other fraction lengths (0-9 digits) take a slower path.
+     * Days are checked against the month, leap years included. A leap
+     * second (":60") is accepted and lands on the next minute's first second.
+     * 
+     * @param str The timestamp text
+     * @return Nanoseconds since 1970-01-01T00:00:00Z, 0 if malformed
+     */
+    int64_t parse_timestamp_ns(std::string_view str);
+    
+    /**
+     * @brief Write nanoseconds since the epoch as an ISO-8601 UTC timestamp
+     * Always writes TIMESTAMP_LENGTH bytes (9 fraction digits), no terminator
+     * 
+     * @param timestamp_ns Nanoseconds since 1970-01-01T00:00:00Z
+     * @param output Buffer with room for TIMESTAMP_LENGTH bytes
+     * @return Number of bytes written
+     */
+    size_t write_timestamp_ns(int64_t timestamp_ns, char* output);
+    
+    /**
+     * @brief Format nanoseconds since the epoch as an ISO-8601 UTC timestamp
+     * 
+     * @param timestamp_ns Nanoseconds since 1970-01-01T00:00:00Z
+     * @return Formatted timestamp, e.g. "2025-07-17T08:05:03.360677248Z"
+     */
+    std::string format_timestamp_ns(int64_t timestamp_ns);
+    
+    /**
+     * @brief Write an unsigned integer in decimal, two digits per table lookup
+     * 
+     * @param value The value to write
+     * @param output Buffer with room for 20 bytes
+     * @return One past the last byte written
+     */
+    char* write_uint64(uint64_t value, char* output);
+    
+    /**
+     * @brief Write a signed integer in decimal
+     * @param output Buffer with room for 20 bytes
+     * @return One past the last byte written
+     */
+    char* write_int64(int64_t value, char* output);
+    
+    /**
+     * @brief Write a fixed-point price with trailing fraction zeros removed
+     * 
+     * Renders price_scaled / PRICE_SCALE exactly, e.g. 5510000000 -> "5.51"
+     * and 21000000000 -> "21", with no trip through double.
+     * 
+     * @param price_scaled Price * PRICE_SCALE
+     * @param output Buffer with room for 30 bytes
+     * @return One past the last byte written
+     */
+    char* write_price_scaled(uint64_t price_scaled, char* output);
     
     /**
      * @brief Format double to string with specified precision
@@ -96,6 +189,15 @@ namespace Utils {
      */
     void trim_string(std::string& str);
     
+    /**
+     * @brief Trim whitespace from both ends of a string view
+     * Only adjusts the view bounds, never copies
+     * 
+     * @param str View to trim
+     * @return Trimmed view into the same storage
+     */
+    std::string_view trim_view(std::string_view str);
+    
     /**
      * @brief Performance timer class for benchmarking
      * Uses high-resolution clock for accurate measurements
@@ -165,8 +267,10 @@ namespace Utils {
     struct Statistics {
         size_t total_orders_processed = 0;
         size_t total_trades_processed = 0;
+        size_t trades_fused = 0;            // Trades emitted as one row with their F and C
         size_t total_cancellations_processed = 0;
         size_t total_additions_processed = 0;
+        size_t total_modifications_processed = 0;
         size_t mbp_updates_generated = 0;
         double total_processing_time_ms = 0.0;
         
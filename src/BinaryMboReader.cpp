@@ -0,0 +1,199 @@
+#include "BinaryMboReader.hpp"
+#include "SymbolTable.hpp"
+#include "Utils.hpp"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <string_view>
+
+/**
+ * @file BinaryMboReader.cpp
+ * @brief Record decoding for binary MBO files
+ */
+
+BinaryMboReader::BinaryMboReader(const std::string& filename)
+    : mapped_file(filename), file_header(nullptr), skipped_records(0) {
+    if (!mapped_file.is_open()) {
+        std::cerr << "Error: Cannot map binary MBO file '" << filename << "'" << std::endl;
+        return;
+    }
+    
+    if (!index_file()) {
+        instrument_symbols.clear();
+        file_header = nullptr;
+    }
+}
+
+bool BinaryMboReader::is_binary_mbo_file(const std::string& filename) {
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    char magic[sizeof(BinaryMboWriter::MAGIC)];
+    if (!file.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, BinaryMboWriter::MAGIC, sizeof(magic)) == 0;
+}
+
+bool BinaryMboReader::index_file() {
+    const char* data = mapped_file.data();
+    size_t size = mapped_file.size();
+    const std::string& filename = mapped_file.get_filename();
+    
+    if (size < sizeof(BinaryMboWriter::FileHeader) ||
+        std::memcmp(data, BinaryMboWriter::MAGIC, sizeof(BinaryMboWriter::MAGIC)) != 0) {
+        std::cerr << "Error: '" << filename << "' is not a binary MBO file" << std::endl;
+        return false;
+    }
+    
+    file_header = reinterpret_cast<const BinaryMboWriter::FileHeader*>(data);
+    if (file_header->version != BinaryMboWriter::FORMAT_VERSION) {
+        std::cerr << "Error: '" << filename << "' has format version " << file_header->version
+                  << ", expected " << BinaryMboWriter::FORMAT_VERSION << std::endl;
+        return false;
+    }
+    
+    // A zero offset means the writer never finished the file
+    uint64_t table_offset = file_header->symbol_table_offset;
+    if (table_offset < sizeof(BinaryMboWriter::FileHeader) || table_offset + sizeof(uint32_t) > size) {
+        std::cerr << "Error: '" << filename << "' is incomplete (writer was not closed)" << std::endl;
+        return false;
+    }
+    
+    // Symbol table: u32 count, then (u32 instrument_id, u32 length, bytes) entries
+    size_t cursor = table_offset;
+    uint32_t entry_count;
+    std::memcpy(&entry_count, data + cursor, sizeof(entry_count));
+    cursor += sizeof(entry_count);
+    
+    for (uint32_t i = 0; i < entry_count; ++i) {
+        uint32_t entry[2];
+        if (cursor + sizeof(entry) > size) {
+            std::cerr << "Error: '" << filename << "' has a truncated symbol table" << std::endl;
+            return false;
+        }
+        std::memcpy(entry, data + cursor, sizeof(entry));
+        cursor += sizeof(entry);
+        
+        if (cursor + entry[1] > size) {
+            std::cerr << "Error: '" << filename << "' has a truncated symbol table" << std::endl;
+            return false;
+        }
+        instrument_symbols[entry[0]] = SymbolTable::instance().intern(std::string_view(data + cursor, entry[1]));
+        cursor += entry[1];
+    }
+    
+    std::cout << "BinaryMboReader mapped " << filename << ": " << file_header->record_count
+              << " records, " << instrument_symbols.size() << " instruments" << std::endl;
+    return true;
+}
+
+bool BinaryMboReader::next_order(size_t& cursor, Order& order, ParseResult& result) {
+    const char* data = mapped_file.data();
+    size_t records_end = file_header->symbol_table_offset;
+    
+    while (cursor < records_end) {
+        BinaryMboWriter::RecordHeader header;
+        size_t length = 0;
+        if (cursor + sizeof(header) <= records_end) {
+            std::memcpy(&header, data + cursor, sizeof(header));
+            length = header.length * BinaryMboWriter::RECORD_LENGTH_UNIT;
+        }
+        
+        if (length < sizeof(header) || cursor + length > records_end) {
+            std::string error_msg = "Corrupt record length at offset " + std::to_string(cursor);
+            result.parsing_errors++;
+            result.error_messages.push_back(error_msg);
+            std::cerr << "Error: " << error_msg << std::endl;
+            cursor = records_end;
+            return false;
+        }
+        
+        const char* record_data = data + cursor;
+        cursor += length;
+        result.total_lines_read++;
+        
+        if (header.rtype != BinaryMboWriter::RTYPE_MBO || length < sizeof(BinaryMboWriter::MboRecord)) {
+            skipped_records++;
+            continue;
+        }
+        
+        BinaryMboWriter::MboRecord record;
+        std::memcpy(&record, record_data, sizeof(record));
+        
+        order.order_id = record.order_id;
+        order.price_scaled = static_cast<uint64_t>(record.price);
+        order.size = record.size;
+        order.side = record.side;
+        order.action = record.action;
+        order.ts_recv = record.ts_recv;
+        order.ts_event = record.header.ts_event;
+        order.flags = record.flags;
+        order.ts_in_delta = static_cast<uint64_t>(static_cast<int64_t>(record.ts_in_delta));
+        order.sequence = record.sequence;
+        order.instrument_id = record.header.instrument_id;
+        order.publisher_id = record.header.publisher_id;
+        
+        auto symbol = instrument_symbols.find(order.instrument_id);
+        order.symbol_id = symbol != instrument_symbols.end() ? symbol->second : SymbolTable::NO_SYMBOL;
+        
+        if (CsvReader::validate_order(order)) {
+            result.successful_parses++;
+            return true;
+        }
+        result.parsing_errors++;
+    }
+    
+    return false;
+}
+
+BinaryMboReader::ParseResult BinaryMboReader::parse_all_orders() {
+    Utils::Timer parse_timer("Binary MBO Decoding");
+    ParseResult result;
+    
+    // The file header stands in for the CSV header line in the statistics
+    result.total_lines_read = 1;
+    result.orders.reserve(file_header->record_count);
+    
+    size_t cursor = sizeof(BinaryMboWriter::FileHeader);
+    Order order;
+    while (next_order(cursor, order, result)) {
+        result.orders.push_back(order);
+    }
+    
+    result.parsing_time_ms = parse_timer.elapsed_ms();
+    
+    std::cout << "\nDecoding completed:" << std::endl;
+    result.print_summary();
+    
+    return result;
+}
+
+BinaryMboReader::ParseResult BinaryMboReader::parse_in_chunks(size_t chunk_size,
+                                                           std::function<void(const std::vector<Order>&)> callback) {
+    Utils::Timer parse_timer("Chunked Binary MBO Decoding");
+    ParseResult result;
+    result.total_lines_read = 1;
+    
+    if (chunk_size == 0) {
+        chunk_size = 1;
+    }
+    
+    std::vector<Order> chunk(chunk_size);
+    size_t chunk_fill = 0;
+    size_t cursor = sizeof(BinaryMboWriter::FileHeader);
+    
+    while (next_order(cursor, chunk[chunk_fill], result)) {
+        if (++chunk_fill == chunk_size) {
+            callback(chunk);
+            chunk_fill = 0;
+        }
+    }
+    
+    // Process remaining orders
+    if (chunk_fill > 0) {
+        chunk.resize(chunk_fill);
+        callback(chunk);
+    }
+    
+    result.parsing_time_ms = parse_timer.elapsed_ms();
+    return result;
+}
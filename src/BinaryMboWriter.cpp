@@ -0,0 +1,182 @@
+#include "BinaryMboWriter.hpp"
+#include "CompactOrder.hpp"
+#include "MappedCsvReader.hpp"
+#include "SymbolTable.hpp"
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+
+/**
+ * @file BinaryMboWriter.cpp
+ * @brief Binary MBO record writer and the CSV converter
+ * 
+ * Values are stored in host byte order; the constructor refuses to run on
+ * a big-endian host, so files are always little-endian.
+ */
+
+static_assert(sizeof(BinaryMboWriter::FileHeader) == 32, "FileHeader layout changed");
+static_assert(sizeof(BinaryMboWriter::RecordHeader) == 16, "RecordHeader layout changed");
+static_assert(sizeof(BinaryMboWriter::MboRecord) == 56, "MboRecord layout changed");
+static_assert(sizeof(BinaryMboWriter::MboRecord) % BinaryMboWriter::RECORD_LENGTH_UNIT == 0,
+              "MboRecord size must be a whole number of length units");
+
+namespace {
+    bool host_is_little_endian() {
+        uint16_t probe = 1;
+        unsigned char first_byte;
+        std::memcpy(&first_byte, &probe, 1);
+        return first_byte == 1;
+    }
+}
+
+BinaryMboWriter::BinaryMboWriter(const std::string& filename)
+    : output_filename(filename), file_header(), bytes_written(0), closed(false) {
+    std::memcpy(file_header.magic, MAGIC, sizeof(MAGIC));
+    file_header.version = FORMAT_VERSION;
+    
+    if (!host_is_little_endian()) {
+        std::cerr << "Error: Binary MBO output requires a little-endian host" << std::endl;
+        closed = true;
+        return;
+    }
+    
+    write_buffer = std::make_unique<char[]>(WRITE_BUFFER_SIZE);
+    output_stream.rdbuf()->pubsetbuf(write_buffer.get(), WRITE_BUFFER_SIZE);
+    output_stream.open(output_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    
+    if (!output_stream.is_open()) {
+        std::cerr << "Error: Cannot create output file '" << output_filename << "'" << std::endl;
+        closed = true;
+        return;
+    }
+    
+    // Placeholder; the totals are patched in by close()
+    write_bytes(&file_header, sizeof(file_header));
+}
+
+BinaryMboWriter::~BinaryMboWriter() {
+    close();
+}
+
+bool BinaryMboWriter::is_open() const {
+    return !closed && output_stream.is_open() && output_stream.good();
+}
+
+bool BinaryMboWriter::write_order(const Order& order) {
+    if (!is_open()) {
+        return false;
+    }
+    
+    // The record uses the vendor widths; refuse rather than truncate
+    if (!CompactOrder::fits(order)) {
+        std::cerr << "Error: Order " << order.order_id << " has a sequence, ts_in_delta or flags value "
+                  << "too wide for a binary MBO record" << std::endl;
+        return false;
+    }
+    
+    instrument_symbols.emplace(order.instrument_id, order.symbol_id);
+    
+    MboRecord record;
+    record.header.length = static_cast<uint8_t>(sizeof(MboRecord) / RECORD_LENGTH_UNIT);
+    record.header.rtype = RTYPE_MBO;
+    record.header.publisher_id = order.publisher_id;
+    record.header.instrument_id = order.instrument_id;
+    record.header.ts_event = order.ts_event;
+    record.order_id = order.order_id;
+    record.price = static_cast<int64_t>(order.price_scaled);
+    record.size = order.size;
+    record.flags = static_cast<uint8_t>(order.flags);
+    record.channel_id = 0;          // Not carried by Order; always 0 in the MBO samples
+    record.action = order.action;
+    record.side = order.side;
+    record.ts_recv = order.ts_recv;
+    record.ts_in_delta = static_cast<int32_t>(order.ts_in_delta);
+    record.sequence = static_cast<uint32_t>(order.sequence);
+    
+    file_header.record_count++;
+    return write_bytes(&record, sizeof(record));
+}
+
+bool BinaryMboWriter::close() {
+    if (closed) {
+        return false;
+    }
+    closed = true;
+    
+    bool complete = output_stream.good();
+    if (complete) {
+        file_header.symbol_table_offset = bytes_written;
+        complete = write_symbol_table();
+    }
+    
+    if (complete) {
+        output_stream.seekp(0);
+        output_stream.write(reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+        output_stream.flush();
+        complete = output_stream.good();
+    }
+    
+    output_stream.close();
+    
+    if (!complete) {
+        std::cerr << "Error: Failed to complete binary MBO file '" << output_filename << "'" << std::endl;
+    }
+    return complete;
+}
+
+bool BinaryMboWriter::write_symbol_table() {
+    // Sorted by instrument so the same input always gives the same file
+    std::vector<std::pair<uint32_t, uint32_t>> entries(instrument_symbols.begin(), instrument_symbols.end());
+    std::sort(entries.begin(), entries.end());
+    
+    uint32_t entry_count = static_cast<uint32_t>(entries.size());
+    if (!write_bytes(&entry_count, sizeof(entry_count))) {
+        return false;
+    }
+    
+    for (const auto& entry : entries) {
+        const std::string& symbol = SymbolTable::instance().lookup(entry.second);
+        uint32_t fields[2] = {entry.first, static_cast<uint32_t>(symbol.size())};
+        if (!write_bytes(fields, sizeof(fields)) || !write_bytes(symbol.data(), symbol.size())) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool BinaryMboWriter::write_bytes(const void* data, size_t length) {
+    output_stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(length));
+    bytes_written += length;
+    return output_stream.good();
+}
+
+long long BinaryMboWriter::convert_csv(const std::string& csv_filename, const std::string& output_filename) {
+    MappedCsvReader reader(csv_filename);
+    if (!reader.is_open()) {
+        return -1;
+    }
+    
+    BinaryMboWriter writer(output_filename);
+    if (!writer.is_open()) {
+        return -1;
+    }
+    
+    bool write_failed = false;
+    auto parse_result = reader.parse_in_chunks(8192, [&](const std::vector<Order>& chunk) {
+        for (const auto& order : chunk) {
+            if (write_failed || !writer.write_order(order)) {
+                write_failed = true;
+                return;
+            }
+        }
+    });
+    
+    if (write_failed || !parse_result.is_successful() || !writer.close()) {
+        return -1;
+    }
+    
+    parse_result.print_summary();
+    return static_cast<long long>(writer.get_record_count());
+}
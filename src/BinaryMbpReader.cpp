@@ -0,0 +1,185 @@
+#include "BinaryMbpReader.hpp"
+#include "CsvWriter.hpp"
+#include "SymbolTable.hpp"
+#include <iostream>
+#include <cstring>
+#include <string_view>
+
+/**
+ * @file BinaryMbpReader.cpp
+ * @brief Block indexing and row reassembly for binary MBP-10 files
+ */
+
+BinaryMbpReader::BinaryMbpReader(const std::string& filename)
+    : mapped_file(filename), file_header(nullptr) {
+    if (!mapped_file.is_open()) {
+        std::cerr << "Error: Cannot map binary MBP file '" << filename << "'" << std::endl;
+        return;
+    }
+    
+    if (!index_file()) {
+        blocks.clear();
+        file_header = nullptr;
+    }
+}
+
+bool BinaryMbpReader::index_file() {
+    const char* data = mapped_file.data();
+    size_t size = mapped_file.size();
+    const std::string& filename = mapped_file.get_filename();
+    
+    if (size < sizeof(BinaryMbpWriter::FileHeader) ||
+        std::memcmp(data, BinaryMbpWriter::MAGIC, sizeof(BinaryMbpWriter::MAGIC)) != 0) {
+        std::cerr << "Error: '" << filename << "' is not a binary MBP file" << std::endl;
+        return false;
+    }
+    
+    file_header = reinterpret_cast<const BinaryMbpWriter::FileHeader*>(data);
+    if (file_header->version != BinaryMbpWriter::FORMAT_VERSION || file_header->depth != Utils::MAX_DEPTH) {
+        std::cerr << "Error: '" << filename << "' has format version " << file_header->version
+                  << " and depth " << file_header->depth << ", expected version "
+                  << BinaryMbpWriter::FORMAT_VERSION << " and depth " << Utils::MAX_DEPTH << std::endl;
+        return false;
+    }
+    
+    // A zero offset means the writer never finished the file
+    uint64_t table_offset = file_header->symbol_table_offset;
+    if (table_offset < sizeof(BinaryMbpWriter::FileHeader) || table_offset + sizeof(uint32_t) > size) {
+        std::cerr << "Error: '" << filename << "' is incomplete (writer was not closed)" << std::endl;
+        return false;
+    }
+    
+    blocks.reserve(file_header->block_count);
+    size_t offset = sizeof(BinaryMbpWriter::FileHeader);
+    uint64_t rows = 0;
+    
+    for (uint64_t i = 0; i < file_header->block_count; ++i) {
+        if (offset + sizeof(BinaryMbpWriter::BlockHeader) > table_offset) {
+            std::cerr << "Error: '" << filename << "' is truncated at block " << i << std::endl;
+            return false;
+        }
+        
+        Block block;
+        block.header = reinterpret_cast<const BinaryMbpWriter::BlockHeader*>(data + offset);
+        if (offset + BinaryMbpWriter::block_bytes(block.row_count()) > table_offset) {
+            std::cerr << "Error: '" << filename << "' is truncated at block " << i << std::endl;
+            return false;
+        }
+        
+        const char* column_start = data + offset + sizeof(BinaryMbpWriter::BlockHeader);
+        for (size_t column_id = 0; column_id < BinaryMbpWriter::COLUMN_COUNT; ++column_id) {
+            block.columns[column_id] = column_start;
+            column_start += BinaryMbpWriter::column_bytes(column_id, block.row_count());
+        }
+        
+        blocks.push_back(block);
+        rows += block.row_count();
+        offset += BinaryMbpWriter::block_bytes(block.row_count());
+    }
+    
+    if (rows != file_header->row_count) {
+        std::cerr << "Error: '" << filename << "' block rows (" << rows
+                  << ") do not match the header row count (" << file_header->row_count << ")" << std::endl;
+        return false;
+    }
+    
+    // Symbol table: u32 count, then (u32 id, u32 length, bytes) entries
+    size_t cursor = table_offset;
+    uint32_t entry_count;
+    std::memcpy(&entry_count, data + cursor, sizeof(entry_count));
+    cursor += sizeof(entry_count);
+    
+    for (uint32_t i = 0; i < entry_count; ++i) {
+        uint32_t entry[2];
+        if (cursor + sizeof(entry) > size) {
+            std::cerr << "Error: '" << filename << "' has a truncated symbol table" << std::endl;
+            return false;
+        }
+        std::memcpy(entry, data + cursor, sizeof(entry));
+        cursor += sizeof(entry);
+        
+        if (cursor + entry[1] > size) {
+            std::cerr << "Error: '" << filename << "' has a truncated symbol table" << std::endl;
+            return false;
+        }
+        symbol_ids[entry[0]] = SymbolTable::instance().intern(std::string_view(data + cursor, entry[1]));
+        cursor += entry[1];
+    }
+    
+    std::cout << "BinaryMbpReader mapped " << filename << ": " << file_header->row_count
+              << " rows in " << blocks.size() << " blocks" << std::endl;
+    return true;
+}
+
+size_t BinaryMbpReader::find_block(int64_t timestamp_ns) const {
+    // Events are in ts_recv order, so ts_event is only nearly sorted; a
+    // linear pass over the block headers is exact and touches no columns
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].header->max_ts_event >= timestamp_ns) {
+            return i;
+        }
+    }
+    return blocks.size();
+}
+
+void BinaryMbpReader::read_row(size_t block, size_t row, OrderBook::MBPRow& mbp_row) const {
+    mbp_row.ts_recv = column<int64_t>(block, Column::TS_RECV)[row];
+    mbp_row.ts_event = column<int64_t>(block, Column::TS_EVENT)[row];
+    mbp_row.rtype = column<uint8_t>(block, Column::RTYPE)[row];
+    mbp_row.publisher_id = column<uint16_t>(block, Column::PUBLISHER_ID)[row];
+    mbp_row.instrument_id = static_cast<int>(column<uint32_t>(block, Column::INSTRUMENT_ID)[row]);
+    mbp_row.action = column<char>(block, Column::ACTION)[row];
+    mbp_row.side = column<char>(block, Column::SIDE)[row];
+    mbp_row.depth = column<int8_t>(block, Column::DEPTH)[row];
+    mbp_row.price_scaled = column<uint64_t>(block, Column::PRICE)[row];
+    mbp_row.size = column<uint32_t>(block, Column::SIZE)[row];
+    mbp_row.flags = column<uint8_t>(block, Column::FLAGS)[row];
+    mbp_row.ts_in_delta = static_cast<uint64_t>(static_cast<int64_t>(column<int32_t>(block, Column::TS_IN_DELTA)[row]));
+    mbp_row.sequence = column<uint32_t>(block, Column::SEQUENCE)[row];
+    mbp_row.order_id = column<uint64_t>(block, Column::ORDER_ID)[row];
+    
+    auto symbol = symbol_ids.find(column<uint32_t>(block, Column::SYMBOL_ID)[row]);
+    mbp_row.symbol_id = symbol != symbol_ids.end() ? symbol->second : SymbolTable::NO_SYMBOL;
+    
+    for (int level = 0; level < Utils::MAX_DEPTH; ++level) {
+        mbp_row.bid_levels[level] = OrderBook::MBPRow::Level(
+            column<uint64_t>(block, Column::BID_PRICE + level)[row],
+            column<uint32_t>(block, Column::BID_SIZE + level)[row],
+            column<uint32_t>(block, Column::BID_COUNT + level)[row]);
+        mbp_row.ask_levels[level] = OrderBook::MBPRow::Level(
+            column<uint64_t>(block, Column::ASK_PRICE + level)[row],
+            column<uint32_t>(block, Column::ASK_SIZE + level)[row],
+            column<uint32_t>(block, Column::ASK_COUNT + level)[row]);
+    }
+}
+
+long long BinaryMbpReader::expand_to_csv(const std::string& binary_filename, const std::string& output_filename) {
+    BinaryMbpReader reader(binary_filename);
+    if (!reader.is_open()) {
+        return -1;
+    }
+    
+    CsvWriter writer(output_filename, MbpOutputMode::FULL);
+    if (!writer.is_open() || !writer.write_header()) {
+        return -1;
+    }
+    
+    OrderBook::MBPRow mbp_row;
+    long long rows_written = 0;
+    
+    for (size_t block = 0; block < reader.get_block_count(); ++block) {
+        for (size_t row = 0; row < reader.get_block(block).row_count(); ++row) {
+            reader.read_row(block, row, mbp_row);
+            if (!writer.write_mbp_row(mbp_row)) {
+                return -1;
+            }
+            rows_written++;
+        }
+    }
+    
+    if (!writer.flush()) {
+        std::cerr << "Error: Failed to write expanded MBP output '" << output_filename << "'" << std::endl;
+        return -1;
+    }
+    return rows_written;
+}
@@ -0,0 +1,269 @@
+#include "BinaryMbpWriter.hpp"
+#include "SymbolTable.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+/**
+ * @file BinaryMbpWriter.cpp
+ * @brief Binary columnar MBP-10 writer
+ * 
+ * Values are stored in host byte order; the constructor refuses to run on
+ * a big-endian host, so files are always little-endian.
+ */
+
+static_assert(sizeof(BinaryMbpWriter::FileHeader) == 64, "FileHeader layout changed");
+static_assert(sizeof(BinaryMbpWriter::BlockHeader) == 40, "BlockHeader layout changed");
+
+namespace {
+    bool host_is_little_endian() {
+        uint16_t probe = 1;
+        unsigned char first_byte;
+        std::memcpy(&first_byte, &probe, 1);
+        return first_byte == 1;
+    }
+}
+
+size_t BinaryMbpWriter::column_width(size_t column) {
+    switch (column) {
+        case TS_RECV:
+        case TS_EVENT:
+        case PRICE:
+        case ORDER_ID:
+            return 8;
+        case INSTRUMENT_ID:
+        case SIZE:
+        case TS_IN_DELTA:
+        case SEQUENCE:
+        case SYMBOL_ID:
+            return 4;
+        case PUBLISHER_ID:
+            return 2;
+        case RTYPE:
+        case ACTION:
+        case SIDE:
+        case DEPTH:
+        case FLAGS:
+            return 1;
+        default:
+            break;
+    }
+    
+    bool is_price = (column >= BID_PRICE && column < BID_SIZE) || (column >= ASK_PRICE && column < ASK_SIZE);
+    return is_price ? 8 : 4;
+}
+
+size_t BinaryMbpWriter::block_bytes(size_t row_count) {
+    size_t bytes = sizeof(BlockHeader);
+    for (size_t column = 0; column < COLUMN_COUNT; ++column) {
+        bytes += column_bytes(column, row_count);
+    }
+    return bytes;
+}
+
+BinaryMbpWriter::BinaryMbpWriter(const std::string& filename, uint32_t block_rows)
+    : output_filename(filename), file_header(), rows_per_block(std::max<uint32_t>(block_rows, 1)),
+      column_offsets(), block_header(), bytes_written(0), closed(false) {
+    std::memcpy(file_header.magic, MAGIC, sizeof(MAGIC));
+    file_header.version = FORMAT_VERSION;
+    file_header.depth = Utils::MAX_DEPTH;
+    file_header.rows_per_block = rows_per_block;
+    file_header.min_ts_event = std::numeric_limits<int64_t>::max();
+    file_header.max_ts_event = std::numeric_limits<int64_t>::min();
+    
+    if (!host_is_little_endian()) {
+        std::cerr << "Error: Binary MBP output requires a little-endian host" << std::endl;
+        closed = true;
+        return;
+    }
+    
+    write_buffer = std::make_unique<char[]>(WRITE_BUFFER_SIZE);
+    output_stream.rdbuf()->pubsetbuf(write_buffer.get(), WRITE_BUFFER_SIZE);
+    output_stream.open(output_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    
+    if (!output_stream.is_open()) {
+        std::cerr << "Error: Cannot create output file '" << output_filename << "'" << std::endl;
+        closed = true;
+        return;
+    }
+    
+    // Column layout of a full block; the header is copied in when the block is written
+    block_buffer.resize(block_bytes(rows_per_block));
+    size_t offset = sizeof(BlockHeader);
+    for (size_t column = 0; column < COLUMN_COUNT; ++column) {
+        column_offsets[column] = offset;
+        offset += column_bytes(column, rows_per_block);
+    }
+    start_block();
+    
+    // Placeholder; the totals are patched in by close()
+    write_bytes(&file_header, sizeof(file_header));
+    
+    std::cout << "BinaryMbpWriter initialized for output: " << output_filename
+              << " (" << rows_per_block << " rows per block)" << std::endl;
+}
+
+BinaryMbpWriter::~BinaryMbpWriter() {
+    close();
+}
+
+bool BinaryMbpWriter::is_open() const {
+    return !closed && output_stream.is_open() && output_stream.good();
+}
+
+bool BinaryMbpWriter::write_mbp_row(const OrderBook::MBPRow& mbp_row) {
+    if (!is_open()) {
+        return false;
+    }
+    
+    if (mbp_row.symbol_id >= used_symbols.size()) {
+        used_symbols.resize(mbp_row.symbol_id + 1, false);
+    }
+    used_symbols[mbp_row.symbol_id] = true;
+    
+    // Scatter the row into its columns, in Column order
+    store<int64_t>(TS_RECV, mbp_row.ts_recv);
+    store<int64_t>(TS_EVENT, mbp_row.ts_event);
+    store<uint8_t>(RTYPE, static_cast<uint8_t>(mbp_row.rtype));
+    store<uint16_t>(PUBLISHER_ID, static_cast<uint16_t>(mbp_row.publisher_id));
+    store<uint32_t>(INSTRUMENT_ID, static_cast<uint32_t>(mbp_row.instrument_id));
+    store<char>(ACTION, mbp_row.action);
+    store<char>(SIDE, mbp_row.side);
+    store<int8_t>(DEPTH, static_cast<int8_t>(mbp_row.depth));
+    store<uint64_t>(PRICE, mbp_row.price_scaled);
+    store<uint32_t>(SIZE, static_cast<uint32_t>(mbp_row.size));
+    store<uint8_t>(FLAGS, static_cast<uint8_t>(mbp_row.flags));
+    store<int32_t>(TS_IN_DELTA, static_cast<int32_t>(mbp_row.ts_in_delta));
+    store<uint32_t>(SEQUENCE, static_cast<uint32_t>(mbp_row.sequence));
+    store<uint32_t>(SYMBOL_ID, mbp_row.symbol_id);
+    store<uint64_t>(ORDER_ID, mbp_row.order_id);
+    
+    for (int level = 0; level < Utils::MAX_DEPTH; ++level) {
+        const OrderBook::MBPRow::Level& bid = mbp_row.bid_levels[level];
+        const OrderBook::MBPRow::Level& ask = mbp_row.ask_levels[level];
+        store<uint64_t>(BID_PRICE + level, bid.price_scaled);
+        store<uint32_t>(BID_SIZE + level, static_cast<uint32_t>(bid.size));
+        store<uint32_t>(BID_COUNT + level, bid.count);
+        store<uint64_t>(ASK_PRICE + level, ask.price_scaled);
+        store<uint32_t>(ASK_SIZE + level, static_cast<uint32_t>(ask.size));
+        store<uint32_t>(ASK_COUNT + level, ask.count);
+    }
+    
+    block_header.min_ts_recv = std::min(block_header.min_ts_recv, mbp_row.ts_recv);
+    block_header.max_ts_recv = std::max(block_header.max_ts_recv, mbp_row.ts_recv);
+    block_header.min_ts_event = std::min(block_header.min_ts_event, mbp_row.ts_event);
+    block_header.max_ts_event = std::max(block_header.max_ts_event, mbp_row.ts_event);
+    
+    if (++block_header.row_count == rows_per_block) {
+        return write_block();
+    }
+    return true;
+}
+
+bool BinaryMbpWriter::flush() {
+    if (!is_open()) {
+        return false;
+    }
+    output_stream.flush();
+    return output_stream.good();
+}
+
+bool BinaryMbpWriter::close() {
+    if (closed) {
+        return false;
+    }
+    closed = true;
+    
+    bool complete = output_stream.good();
+    if (complete && block_header.row_count != 0) {
+        complete = write_block();
+    }
+    
+    if (complete) {
+        file_header.symbol_table_offset = bytes_written;
+        complete = write_symbol_table();
+    }
+    
+    if (file_header.row_count == 0) {
+        file_header.min_ts_event = 0;
+        file_header.max_ts_event = 0;
+    }
+    
+    if (complete) {
+        output_stream.seekp(0);
+        output_stream.write(reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+        output_stream.flush();
+        complete = output_stream.good();
+    }
+    
+    output_stream.close();
+    
+    if (!complete) {
+        std::cerr << "Error: Failed to complete binary MBP file '" << output_filename << "'" << std::endl;
+    }
+    return complete;
+}
+
+void BinaryMbpWriter::start_block() {
+    block_header = BlockHeader();
+    block_header.min_ts_recv = block_header.min_ts_event = std::numeric_limits<int64_t>::max();
+    block_header.max_ts_recv = block_header.max_ts_event = std::numeric_limits<int64_t>::min();
+}
+
+bool BinaryMbpWriter::write_block() {
+    size_t row_count = block_header.row_count;
+    char* block = block_buffer.data();
+    
+    std::memcpy(block, &block_header, sizeof(block_header));
+    
+    // Pack the columns back to back for this row count. Full blocks already
+    // are; a short one moves each column down (never past its own start).
+    size_t offset = sizeof(BlockHeader);
+    for (size_t column = 0; column < COLUMN_COUNT; ++column) {
+        size_t used = column_width(column) * row_count;
+        size_t padded = column_bytes(column, row_count);
+        if (offset != column_offsets[column]) {
+            std::memmove(block + offset, block + column_offsets[column], used);
+        }
+        // Zero the padding so files are reproducible byte for byte
+        std::memset(block + offset + used, 0, padded - used);
+        offset += padded;
+    }
+    
+    file_header.row_count += row_count;
+    file_header.block_count++;
+    file_header.min_ts_event = std::min(file_header.min_ts_event, block_header.min_ts_event);
+    file_header.max_ts_event = std::max(file_header.max_ts_event, block_header.max_ts_event);
+    
+    bool written = write_bytes(block, offset);
+    start_block();
+    return written;
+}
+
+bool BinaryMbpWriter::write_symbol_table() {
+    uint32_t entry_count = static_cast<uint32_t>(std::count(used_symbols.begin(), used_symbols.end(), true));
+    if (!write_bytes(&entry_count, sizeof(entry_count))) {
+        return false;
+    }
+    
+    for (uint32_t id = 0; id < used_symbols.size(); ++id) {
+        if (!used_symbols[id]) {
+            continue;
+        }
+        
+        const std::string& symbol = SymbolTable::instance().lookup(id);
+        uint32_t entry[2] = {id, static_cast<uint32_t>(symbol.size())};
+        if (!write_bytes(entry, sizeof(entry)) || !write_bytes(symbol.data(), symbol.size())) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool BinaryMbpWriter::write_bytes(const void* data, size_t length) {
+    output_stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(length));
+    bytes_written += length;
+    return output_stream.good();
+}
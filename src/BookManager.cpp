@@ -0,0 +1,186 @@
+#include "BookManager.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+/**
+ * @file BookManager.cpp
+ * @brief Routing of events to per-instrument books and ordered merging of their rows
+ * 
+ * Each shard processes its batches in FIFO order, so the batch popped from
+ * a shard's completed ring always belongs to the oldest chunk in flight.
+ * Every shard gets a batch for every chunk (possibly empty) to keep that
+ * true.
+ */
+
+void BookManager::ShardBatch::clear() {
+    orders.clear();
+    positions.clear();
+    rows.clear();
+    row_positions.clear();
+}
+
+BookManager::BookManager(size_t shard_count, LadderType ladder, CsvWriter& writer)
+    : ladder_type(ladder), csv_writer(writer), chunks_dispatched(0), chunks_written(0),
+      mbp_updates(0), write_failed(false), finished(false) {
+    if (shard_count == 0) {
+        shard_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    chunk_batches.resize(CHUNKS_IN_FLIGHT);
+    for (auto& batches : chunk_batches) {
+        batches.resize(shard_count);
+    }
+    
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+    for (auto& shard : shards) {
+        Shard* worker_shard = shard.get();
+        shard->worker = std::thread([this, worker_shard]() { worker_loop(*worker_shard); });
+    }
+    
+    std::cout << "BookManager started " << shard_count << " shard thread(s) ("
+              << ladder_type_name(ladder_type) << " price ladder)" << std::endl;
+}
+
+BookManager::~BookManager() {
+    finish();
+}
+
+bool BookManager::process_orders(const std::vector<Order>& orders) {
+    if (finished) {
+        return false;
+    }
+    
+    if (chunks_dispatched - chunks_written == CHUNKS_IN_FLIGHT && !write_oldest_chunk()) {
+        return false;
+    }
+    
+    std::vector<ShardBatch>& batches = chunk_batches[chunks_dispatched % CHUNKS_IN_FLIGHT];
+    for (auto& batch : batches) {
+        batch.clear();
+    }
+    
+    for (size_t i = 0; i < orders.size(); ++i) {
+        ShardBatch& batch = batches[shard_of(orders[i].instrument_id)];
+        batch.orders.push_back(orders[i]);
+        batch.positions.push_back(static_cast<uint32_t>(i));
+    }
+    
+    for (size_t i = 0; i < shards.size(); ++i) {
+        shards[i]->pending.push(&batches[i]);
+    }
+    chunks_dispatched++;
+    
+    return !write_failed;
+}
+
+bool BookManager::finish() {
+    if (finished) {
+        return !write_failed;
+    }
+    
+    while (chunks_written < chunks_dispatched) {
+        write_oldest_chunk();
+    }
+    
+    for (auto& shard : shards) {
+        shard->pending.close();
+    }
+    for (auto& shard : shards) {
+        shard->worker.join();
+    }
+    
+    finished = true;
+    return !write_failed;
+}
+
+size_t BookManager::get_instrument_count() const {
+    size_t instruments = 0;
+    for (const auto& shard : shards) {
+        instruments += shard->books.size();
+    }
+    return instruments;
+}
+
+void BookManager::print_shard_statistics() const {
+    std::cout << "Book shards (" << get_instrument_count() << " instruments):" << std::endl;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        const Shard& shard = *shards[i];
+        std::cout << "  Shard " << std::setw(2) << i << ": "
+                  << std::setw(6) << shard.books.size() << " books  "
+                  << std::setw(10) << shard.orders_processed << " orders  "
+                  << std::setw(10) << shard.mbp_updates << " MBP rows  "
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(9) << shard.pending.get_consumer_blocked_ms() << " ms idle" << std::endl;
+    }
+}
+
+void BookManager::worker_loop(Shard& shard) {
+    ShardBatch* batch = nullptr;
+    
+    // Events of one instrument tend to come in runs; skip the map lookup for those
+    uint32_t cached_instrument = 0;
+    OrderBook* cached_book = nullptr;
+    
+    while (shard.pending.pop(batch)) {
+        for (size_t i = 0; i < batch->orders.size(); ++i) {
+            const Order& order = batch->orders[i];
+            
+            if (cached_book == nullptr || order.instrument_id != cached_instrument) {
+                std::unique_ptr<OrderBook>& book = shard.books[order.instrument_id];
+                if (!book) {
+                    book = std::make_unique<OrderBook>(ladder_type, false);
+                }
+                cached_instrument = order.instrument_id;
+                cached_book = book.get();
+            }
+            
+            const OrderBook::MBPRow* mbp_row = cached_book->process_order(order);
+            if (mbp_row != nullptr) {
+                batch->rows.push_back(*mbp_row);
+                batch->row_positions.push_back(batch->positions[i]);
+            }
+        }
+        
+        shard.orders_processed += batch->orders.size();
+        shard.mbp_updates += batch->rows.size();
+        shard.completed.push(batch);
+    }
+}
+
+bool BookManager::write_oldest_chunk() {
+    std::vector<ShardBatch*> done(shards.size(), nullptr);
+    for (size_t i = 0; i < shards.size(); ++i) {
+        shards[i]->completed.pop(done[i]);
+    }
+    
+    // k-way merge by position; each shard's rows are already in position order
+    std::vector<size_t> next_row(shards.size(), 0);
+    while (!write_failed) {
+        size_t best_shard = shards.size();
+        uint32_t best_position = 0;
+        for (size_t i = 0; i < shards.size(); ++i) {
+            if (next_row[i] < done[i]->rows.size() &&
+                (best_shard == shards.size() || done[i]->row_positions[next_row[i]] < best_position)) {
+                best_shard = i;
+                best_position = done[i]->row_positions[next_row[i]];
+            }
+        }
+        if (best_shard == shards.size()) {
+            break;
+        }
+        
+        if (!csv_writer.write_mbp_row(done[best_shard]->rows[next_row[best_shard]])) {
+            std::cerr << "Error: Failed to write MBP row to output" << std::endl;
+            write_failed = true;
+            break;
+        }
+        next_row[best_shard]++;
+        mbp_updates++;
+    }
+    
+    chunks_written++;
+    return !write_failed;
+}
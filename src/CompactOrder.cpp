@@ -0,0 +1,46 @@
+#include "CompactOrder.hpp"
+#include <limits>
+
+/**
+ * @file CompactOrder.cpp
+ * @brief Conversions between Order and CompactOrder
+ * 
+ * Only used at the edges of the pipeline; the hot path works on
+ * CompactOrder directly.
+ */
+
+bool CompactOrder::fits(const Order& order) {
+    int64_t ts_in_delta = static_cast<int64_t>(order.ts_in_delta);
+    return order.sequence <= std::numeric_limits<uint32_t>::max() &&
+           ts_in_delta >= std::numeric_limits<int32_t>::min() &&
+           ts_in_delta <= std::numeric_limits<int32_t>::max() &&
+           order.flags <= std::numeric_limits<uint8_t>::max();
+}
+
+bool CompactOrder::from_order(const Order& order, CompactOrder& compact) {
+    if (!fits(order)) {
+        return false;
+    }
+    
+    compact.ts_recv = order.ts_recv;
+    compact.ts_event = order.ts_event;
+    compact.order_id = order.order_id;
+    compact.price_scaled = order.price_scaled;
+    compact.size = order.size;
+    compact.sequence = static_cast<uint32_t>(order.sequence);
+    compact.ts_in_delta = static_cast<int32_t>(order.ts_in_delta);
+    compact.symbol_id = order.symbol_id;
+    compact.instrument_id = order.instrument_id;
+    compact.publisher_id = order.publisher_id;
+    compact.flags = static_cast<uint8_t>(order.flags);
+    compact.side = order.side;
+    compact.action = order.action;
+    
+    return true;
+}
+
+Order CompactOrder::to_order() const {
+    return Order(order_id, price_scaled, size, side, action, ts_recv, ts_event,
+                 flags, static_cast<uint64_t>(ts_in_delta), sequence, symbol_id,
+                 instrument_id, publisher_id);
+}
@@ -1,4 +1,6 @@
 #include "CsvReader.hpp"
+#include "MappedCsvReader.hpp"
+#include "SymbolTable.hpp"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -191,13 +193,11 @@ bool CsvReader::parse_line_to_order(const std::string& line, size_t line_number,
     try {
         // Parse timestamps (required)
         if (column_indices.ts_recv >= 0 && column_indices.ts_recv < static_cast<int>(fields.size())) {
-            order.ts_recv = fields[column_indices.ts_recv];
-            Utils::trim_string(order.ts_recv);
+            order.ts_recv = Utils::parse_timestamp_ns(Utils::trim_view(fields[column_indices.ts_recv]));
         }
         
         if (column_indices.ts_event >= 0 && column_indices.ts_event < static_cast<int>(fields.size())) {
-            order.ts_event = fields[column_indices.ts_event];
-            Utils::trim_string(order.ts_event);
+            order.ts_event = Utils::parse_timestamp_ns(Utils::trim_view(fields[column_indices.ts_event]));
         }
         
         // Parse action (required)
@@ -218,12 +218,7 @@ bool CsvReader::parse_line_to_order(const std::string& line, size_t line_number,
         if (column_indices.price >= 0 && column_indices.price < static_cast<int>(fields.size())) {
             std::string price_str = fields[column_indices.price];
             Utils::trim_string(price_str);
-            if (!price_str.empty()) {
-                double price = Utils::fast_string_to_double(price_str);
-                order.set_price(price);
-            } else {
-                order.price_scaled = 0;
-            }
+            order.price_scaled = Utils::parse_price_scaled(price_str);
         }
         
         // Parse size (might be empty for some actions)
@@ -261,10 +256,19 @@ bool CsvReader::parse_line_to_order(const std::string& line, size_t line_number,
             order.ts_in_delta = delta_str.empty() ? 0 : Utils::fast_string_to_uint64(delta_str);
         }
         
+        // Parse instrument and publisher (optional, 0 when absent)
+        if (column_indices.instrument_id >= 0 && column_indices.instrument_id < static_cast<int>(fields.size())) {
+            order.instrument_id = Utils::fast_string_to_uint32(Utils::trim_view(fields[column_indices.instrument_id]));
+        }
+        
+        if (column_indices.publisher_id >= 0 && column_indices.publisher_id < static_cast<int>(fields.size())) {
+            order.publisher_id = static_cast<uint16_t>(
+                Utils::fast_string_to_uint32(Utils::trim_view(fields[column_indices.publisher_id])));
+        }
+        
         // Parse symbol (required)
         if (column_indices.symbol >= 0 && column_indices.symbol < static_cast<int>(fields.size())) {
-            order.symbol = fields[column_indices.symbol];
-            Utils::trim_string(order.symbol);
+            order.symbol_id = SymbolTable::instance().intern(Utils::trim_view(fields[column_indices.symbol]));
         }
         
         return true;
@@ -297,7 +301,7 @@ const std::vector<std::string>& CsvReader::split_csv_line(const std::string& lin
     return split_buffer;
 }
 
-bool CsvReader::validate_order(const Order& order) const {
+bool CsvReader::validate_order(const Order& order) {
     // Basic validation for parsed order
     
     // Action must be valid
@@ -313,19 +317,20 @@ bool CsvReader::validate_order(const Order& order) const {
     
     // For non-clear actions, we need valid timestamps
     if (order.action != 'R') {
-        if (order.ts_recv.empty() || order.ts_event.empty()) {
+        if (order.ts_recv == 0 || order.ts_event == 0) {
             return false;
         }
         
-        // Order ID should be non-zero for most actions
-        if (order.order_id == 0 && order.action != 'R') {
+        // Order ID should be non-zero for most actions; trades carry no
+        // resting order id (the following F and C events do)
+        if (order.order_id == 0 && order.action != 'T') {
             return false;
         }
     }
     
     // Symbol should not be empty
     // Only ADD and CLEAR actions require a non-empty symbol
-    if ((order.action == Utils::ACTION_ADD || order.action == Utils::ACTION_CLEAR) && order.symbol.empty()) {
+    if ((order.action == Utils::ACTION_ADD || order.action == Utils::ACTION_CLEAR) && order.symbol_id == SymbolTable::NO_SYMBOL) {
        return false;
     }
     
@@ -335,9 +340,8 @@ bool CsvReader::validate_order(const Order& order) const {
             return false;
         }
         
-        // Reasonable price bounds
-        double price = order.get_price();
-        if (price <= 0.0 || price > 1000000.0) {
+        // Reasonable price bounds (checked in fixed point, no double conversion)
+        if (order.price_scaled > 1000000 * Utils::PRICE_SCALE) {
             return false;
         }
         
@@ -424,7 +428,14 @@ size_t CsvReader::estimate_order_count() const {
 
 // Additional method implementations that were missing from the header
 CsvReader::ParseResult CsvReader::parse_in_chunks(size_t chunk_size, 
-                                               std::function<void(const std::vector<Order>&)> callback) {
+                                               std::function<void(const std::vector<Order>&)> callback,
+                                               size_t num_threads) {
+    if (num_threads != 1) {
+        // Splitting into byte ranges needs random access, which the mapped reader provides
+        MappedCsvReader mapped_reader(filename);
+        return mapped_reader.parse_in_chunks_parallel(chunk_size, num_threads, callback);
+    }
+    
     Utils::Timer parse_timer("Chunked CSV Parsing");
     ParseResult result;
     
@@ -446,8 +457,16 @@ CsvReader::ParseResult CsvReader::parse_in_chunks(size_t chunk_size,
     }
     
     result.total_lines_read = 1;
+    if (chunk_size == 0) {
+        chunk_size = 1;
+    }
+    
+    // The chunk is reused for the whole file: slots are overwritten in place
+    // so their strings keep their capacity and memory stays flat
     std::vector<Order> chunk;
-    chunk.reserve(chunk_size);
+    chunk.reserve(std::min(chunk_size, Utils::INITIAL_RESERVE_SIZE));
+    size_t chunk_fill = 0;
+    Order current_order;
     
     std::string line;
     while (std::getline(file_stream, line)) {
@@ -457,15 +476,18 @@ CsvReader::ParseResult CsvReader::parse_in_chunks(size_t chunk_size,
             continue;
         }
         
-        Order current_order;
         if (parse_line_to_order(line, result.total_lines_read, current_order)) {
             if (validate_order(current_order)) {
-                chunk.push_back(current_order);
+                if (chunk_fill == chunk.size()) {
+                    chunk.push_back(current_order);
+                } else {
+                    chunk[chunk_fill] = current_order;
+                }
                 result.successful_parses++;
                 
-                if (chunk.size() >= chunk_size) {
+                if (++chunk_fill >= chunk_size) {
                     callback(chunk);
-                    chunk.clear();
+                    chunk_fill = 0;
                 }
             } else {
                 result.parsing_errors++;
@@ -476,7 +498,8 @@ CsvReader::ParseResult CsvReader::parse_in_chunks(size_t chunk_size,
     }
     
     // Process remaining orders
-    if (!chunk.empty()) {
+    if (chunk_fill > 0) {
+        chunk.resize(chunk_fill);
         callback(chunk);
     }
     
@@ -1,11 +1,14 @@
 #include "CsvWriter.hpp"
+#include "SymbolTable.hpp"
 #include <iostream>
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
+#include <cstring>
 
 /**
  * @file CsvWriter.cpp
- * @brief Implementation of high-performance CSV writer for MBP-10 output
+ * @brief Implementation of high-performance CSV writer for MBP-N output
  * 
  * This implementation focuses on exact format matching with the expected
  * mbp.csv output while maintaining high performance through:
@@ -15,8 +18,27 @@
  * - Precise decimal handling for financial data
  */
 
-CsvWriter::CsvWriter(const std::string& csv_filename) 
-    : output_filename(csv_filename), row_index(0) {
+template <int Depth>
+BasicCsvWriter<Depth>::BasicCsvWriter(const std::string& csv_filename, MbpOutputMode mode) 
+    : output_filename(csv_filename), row_buffer_size(0),
+      async_rows_queued(0), async_rows_done(0), async_failed(false),
+      row_index(0), output_mode(mode) {
+    
+    if (output_mode == MbpOutputMode::BINARY) {
+        if constexpr (Depth != Utils::MAX_DEPTH) {
+            std::cerr << "Error: Binary MBP output only supports depth " << Utils::MAX_DEPTH << std::endl;
+            current_result.success = false;
+            current_result.error_message = "Binary output requires MBP-10 rows";
+            return;
+        }
+        binary_writer = std::make_unique<BinaryMbpWriter>(output_filename);
+        if (!binary_writer->is_open()) {
+            current_result.success = false;
+            current_result.error_message = "Failed to open output file";
+        }
+        write_timer.reset();
+        return;
+    }
     
     // Initialize write buffer
     write_buffer = std::make_unique<char[]>(WRITE_BUFFER_SIZE);
@@ -40,15 +62,21 @@ CsvWriter::CsvWriter(const std::string& csv_filename)
     // Start timing
     write_timer.reset();
     
-    std::cout << "CsvWriter initialized for output: " << output_filename << std::endl;
+    std::cout << "CsvWriter initialized for output: " << output_filename
+              << " (MBP-" << Depth << ", " << mbp_output_mode_name(output_mode) << " rows)" << std::endl;
 }
 
-CsvWriter::~CsvWriter() {
+template <int Depth>
+BasicCsvWriter<Depth>::~BasicCsvWriter() {
+    // Let the writer thread finish every queued row first
+    stop_async();
+    
     // Ensure final flush and close
     if (output_stream.is_open()) {
         flush();
         output_stream.close();
     }
+    close_binary_writer();
     
     // Final timing
     current_result.writing_time_ms = write_timer.elapsed_ms();
@@ -58,17 +86,27 @@ CsvWriter::~CsvWriter() {
     current_result.print_summary();
 }
 
-bool CsvWriter::is_open() const {
+template <int Depth>
+bool BasicCsvWriter<Depth>::is_open() const {
+    if (binary_writer) {
+        return binary_writer->is_open();
+    }
     return output_stream.is_open() && output_stream.good();
 }
 
-bool CsvWriter::write_header() {
+template <int Depth>
+bool BasicCsvWriter<Depth>::write_header() {
     if (!is_open()) {
         current_result.success = false;
         current_result.error_message = "Output stream is not open";
         return false;
     }
     
+    // The binary file header is written (and completed) by BinaryMbpWriter
+    if (binary_writer) {
+        return true;
+    }
+    
     // Write the header line
     if (!buffered_write(header_line + "\n")) {
         handle_write_error("Failed to write header");
@@ -79,7 +117,84 @@ bool CsvWriter::write_header() {
     return true;
 }
 
-bool CsvWriter::write_mbp_row(const OrderBook::MBPRow& mbp_row) {
+template <int Depth>
+bool BasicCsvWriter<Depth>::start_async(size_t ring_capacity) {
+    if (!is_open()) {
+        handle_write_error("Output stream is not open");
+        return false;
+    }
+    if (async_ring) {
+        return true;
+    }
+    
+    async_ring = std::make_unique<SpscRing<MBPRow>>(ring_capacity);
+    async_rows_queued = 0;
+    async_rows_done.store(0, std::memory_order_relaxed);
+    async_failed.store(false, std::memory_order_relaxed);
+    current_result.async_mode = true;
+    
+    async_thread = std::thread(&BasicCsvWriter::async_writer_loop, this);
+    
+    std::cout << "CsvWriter async mode: writer thread started (ring of "
+              << async_ring->capacity() << " rows)" << std::endl;
+    return true;
+}
+
+template <int Depth>
+void BasicCsvWriter<Depth>::async_writer_loop() {
+    Utils::Timer thread_timer("");
+    MBPRow mbp_row;
+    
+    while (async_ring->pop(mbp_row)) {
+        // After a failure keep draining, so the caller never waits on a dead consumer
+        if (!async_failed.load(std::memory_order_relaxed) && !write_row_now(mbp_row)) {
+            async_failed.store(true, std::memory_order_release);
+        }
+        async_rows_done.fetch_add(1, std::memory_order_release);
+    }
+    
+    current_result.async_thread_ms += thread_timer.elapsed_ms();
+}
+
+template <int Depth>
+void BasicCsvWriter<Depth>::wait_for_async_writer() const {
+    while (async_rows_done.load(std::memory_order_acquire) != async_rows_queued) {
+        std::this_thread::yield();
+    }
+}
+
+template <int Depth>
+void BasicCsvWriter<Depth>::stop_async() {
+    if (!async_ring) {
+        return;
+    }
+    
+    async_ring->close();
+    async_thread.join();
+    
+    current_result.async_blocked_ms += async_ring->get_producer_blocked_ms();
+    current_result.async_idle_ms += async_ring->get_consumer_blocked_ms();
+    async_ring.reset();
+}
+
+template <int Depth>
+bool BasicCsvWriter<Depth>::write_mbp_row(const MBPRow& mbp_row) {
+    if (async_ring) {
+        if (async_failed.load(std::memory_order_acquire)) {
+            return false; // Error already reported by the writer thread
+        }
+        
+        // Copy into the ring; waits only when the writer thread is a full ring behind
+        async_ring->push(mbp_row);
+        async_rows_queued++;
+        return true;
+    }
+    
+    return write_row_now(mbp_row);
+}
+
+template <int Depth>
+bool BasicCsvWriter<Depth>::write_row_now(const MBPRow& mbp_row) {
     if (!is_open()) {
         handle_write_error("Output stream is not open");
         return false;
@@ -91,29 +206,47 @@ bool CsvWriter::write_mbp_row(const OrderBook::MBPRow& mbp_row) {
         return false;
     }
     
-    // Format the row
-    std::string formatted_row;
-    if (!format_mbp_row(mbp_row, formatted_row)) {
-        handle_write_error("Failed to format MBP row");
-        return false;
+    if constexpr (Depth == Utils::MAX_DEPTH) {
+        if (binary_writer) {
+            if (!binary_writer->write_mbp_row(mbp_row)) {
+                handle_write_error("Failed to write MBP row to file");
+                return false;
+            }
+            current_result.rows_written++;
+            current_result.bytes_written = binary_writer->get_bytes_written();
+            row_index++;
+            return true;
+        }
+    }
+    
+    // Make sure the reusable buffer fits this row's symbol
+    size_t row_capacity = MAX_FIXED_ROW_BYTES + symbol_text(mbp_row.symbol_id).size();
+    if (row_capacity > row_buffer_size) {
+        row_buffer = std::make_unique<char[]>(row_capacity);
+        row_buffer_size = row_capacity;
     }
     
+    // Format the row (newline included) straight into the buffer
+    size_t row_length = static_cast<size_t>(format_mbp_row(mbp_row, row_buffer.get()) - row_buffer.get());
+    
     // Write the formatted row
-    if (!buffered_write(formatted_row + "\n")) {
+    if (!buffered_write(row_buffer.get(), row_length)) {
         handle_write_error("Failed to write MBP row to file");
         return false;
     }
     
     // Update statistics
     current_result.rows_written++;
-    current_result.bytes_written += formatted_row.length() + 1; // +1 for newline
+    current_result.bytes_written += row_length;
     row_index++;
     
     return true;
 }
 
-bool CsvWriter::write_mbp_rows(const std::vector<OrderBook::MBPRow>& mbp_rows) {
-    if (!is_open()) {
+template <int Depth>
+bool BasicCsvWriter<Depth>::write_mbp_rows(const std::vector<MBPRow>& mbp_rows) {
+    // In async mode the stream and the counters belong to the writer thread
+    if (!async_ring && !is_open()) {
         handle_write_error("Output stream is not open");
         return false;
     }
@@ -124,7 +257,7 @@ bool CsvWriter::write_mbp_rows(const std::vector<OrderBook::MBPRow>& mbp_rows) {
         }
         
         // Periodic flush for large batches
-        if (current_result.rows_written % 1000 == 0) {
+        if (!async_ring && current_result.rows_written % 1000 == 0) {
             flush();
         }
     }
@@ -132,46 +265,85 @@ bool CsvWriter::write_mbp_rows(const std::vector<OrderBook::MBPRow>& mbp_rows) {
     return true;
 }
 
-bool CsvWriter::flush() {
+template <int Depth>
+bool BasicCsvWriter<Depth>::flush() {
+    if (async_ring) {
+        // The writer thread is idle once it has caught up, so the stream is ours
+        wait_for_async_writer();
+        if (async_failed.load(std::memory_order_acquire)) {
+            return false;
+        }
+    }
+    
     if (!is_open()) {
         return false;
     }
     
+    if (binary_writer) {
+        return binary_writer->flush();
+    }
+    
     output_stream.flush();
     return output_stream.good();
 }
 
-void CsvWriter::close() {
+template <int Depth>
+void BasicCsvWriter<Depth>::close() {
+    stop_async();
+    
     if (output_stream.is_open()) {
         flush();
         output_stream.close();
     }
+    close_binary_writer();
     
     // Final timing update
     current_result.writing_time_ms = write_timer.elapsed_ms();
 }
 
-void CsvWriter::reset_statistics() {
+template <int Depth>
+bool BasicCsvWriter<Depth>::close_binary_writer() {
+    if (!binary_writer || !binary_writer->is_open()) {
+        return binary_writer == nullptr;
+    }
+    
+    if (!binary_writer->close()) {
+        handle_write_error("Failed to complete binary output file");
+        return false;
+    }
+    current_result.bytes_written = binary_writer->get_bytes_written();
+    return true;
+}
+
+template <int Depth>
+void BasicCsvWriter<Depth>::reset_statistics() {
     current_result = WriteResult();
     write_timer.reset();
     row_index = 0;
 }
 
-std::string CsvWriter::create_header_line() {
+template <int Depth>
+std::string BasicCsvWriter<Depth>::create_header_line() {
     // Create exact header matching the expected output format
     std::ostringstream header;
     
     header << ",ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,depth,price,size,flags,ts_in_delta,sequence";
     
-    // Add bid levels (10 levels: bid_px_00 to bid_px_09, bid_sz_00 to bid_sz_09, bid_ct_00 to bid_ct_09)
-    for (int i = 0; i < Utils::MAX_DEPTH; ++i) {
+    if (output_mode == MbpOutputMode::DELTA) {
+        // Variable-length tail: `changes` tuples follow the last named column
+        header << ",symbol,order_id,changes";
+        return header.str();
+    }
+    
+    // Add bid levels (bid_px_00, bid_sz_00, bid_ct_00 up to level Depth - 1)
+    for (int i = 0; i < Depth; ++i) {
         header << ",bid_px_" << std::setfill('0') << std::setw(2) << i;
         header << ",bid_sz_" << std::setfill('0') << std::setw(2) << i;
         header << ",bid_ct_" << std::setfill('0') << std::setw(2) << i;
     }
     
-    // Add ask levels (10 levels: ask_px_00 to ask_px_09, ask_sz_00 to ask_sz_09, ask_ct_00 to ask_ct_09)
-    for (int i = 0; i < Utils::MAX_DEPTH; ++i) {
+    // Add ask levels (ask_px_00, ask_sz_00, ask_ct_00 up to level Depth - 1)
+    for (int i = 0; i < Depth; ++i) {
         header << ",ask_px_" << std::setfill('0') << std::setw(2) << i;
         header << ",ask_sz_" << std::setfill('0') << std::setw(2) << i;
         header << ",ask_ct_" << std::setfill('0') << std::setw(2) << i;
@@ -182,124 +354,215 @@ std::string CsvWriter::create_header_line() {
     return header.str();
 }
 
-bool CsvWriter::format_mbp_row(const OrderBook::MBPRow& mbp_row, std::string& output) {
-    std::ostringstream row;
-    
-    try {
-        // Row index (starts from 0)
-        row << row_index;
-        
-        // Metadata fields
-        row << "," << format_timestamp(mbp_row.ts_recv);
-        row << "," << format_timestamp(mbp_row.ts_event);
-        row << "," << mbp_row.rtype;
-        row << "," << mbp_row.publisher_id;
-        row << "," << mbp_row.instrument_id;
-        row << "," << mbp_row.action;
-        row << "," << mbp_row.side;
-        row << "," << mbp_row.depth;
-        row << "," << format_price(mbp_row.price);
-        row << "," << format_size(mbp_row.size);
-        row << "," << mbp_row.flags;
-        row << "," << mbp_row.ts_in_delta;
-        row << "," << mbp_row.sequence;
+template <int Depth>
+char* BasicCsvWriter<Depth>::format_mbp_row(const MBPRow& mbp_row, char* output) {
+    char* out = output;
+    
+    // Row index (starts from 0)
+    out = Utils::write_uint64(row_index, out);
+    
+    // Metadata fields
+    *out++ = ',';
+    out += format_timestamp(mbp_row.ts_recv, out);
+    *out++ = ',';
+    out += format_timestamp(mbp_row.ts_event, out);
+    *out++ = ',';
+    out = Utils::write_int64(mbp_row.rtype, out);
+    *out++ = ',';
+    out = Utils::write_int64(mbp_row.publisher_id, out);
+    *out++ = ',';
+    out = Utils::write_int64(mbp_row.instrument_id, out);
+    *out++ = ',';
+    *out++ = mbp_row.action;
+    *out++ = ',';
+    *out++ = mbp_row.side;
+    *out++ = ',';
+    out = Utils::write_int64(mbp_row.depth, out);
+    *out++ = ',';
+    out = write_price(mbp_row.price_scaled, out);
+    *out++ = ',';
+    out = Utils::write_uint64(mbp_row.size, out);
+    *out++ = ',';
+    out = Utils::write_uint64(mbp_row.flags, out);
+    *out++ = ',';
+    out = Utils::write_uint64(mbp_row.ts_in_delta, out);
+    *out++ = ',';
+    out = Utils::write_uint64(mbp_row.sequence, out);
+    
+    if (output_mode == MbpOutputMode::DELTA) {
+        out = write_symbol_and_order_id(mbp_row, out);
         
-        // Bid levels (10 levels)
-        for (int i = 0; i < Utils::MAX_DEPTH; ++i) {
-            const auto& level = mbp_row.bid_levels[i];
-            row << "," << format_price(level.price);
-            row << "," << format_size(level.size);
-            row << "," << format_count(level.count);
-        }
-        
-        // Ask levels (10 levels)
-        for (int i = 0; i < Utils::MAX_DEPTH; ++i) {
-            const auto& level = mbp_row.ask_levels[i];
-            row << "," << format_price(level.price);
-            row << "," << format_size(level.size);
-            row << "," << format_count(level.count);
-        }
+        // Tuples go to a scratch buffer first, the count has to precede them
+        char tuples[MAX_DELTA_BYTES];
+        int change_count = 0;
+        char* tuples_end = write_level_deltas(tuples, Utils::SIDE_BID, mbp_row.bid_levels,
+                                              last_bid_levels, change_count);
+        tuples_end = write_level_deltas(tuples_end, Utils::SIDE_ASK, mbp_row.ask_levels,
+                                        last_ask_levels, change_count);
         
-        // Final fields
-        row << "," << mbp_row.symbol;
-        row << "," << mbp_row.order_id;
+        *out++ = ',';
+        out = Utils::write_uint64(static_cast<uint64_t>(change_count), out);
+        size_t tuple_bytes = static_cast<size_t>(tuples_end - tuples);
+        std::memcpy(out, tuples, tuple_bytes);
+        out += tuple_bytes;
         
-        output = row.str();
-        return true;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Exception formatting MBP row: " << e.what() << std::endl;
-        return false;
+        *out++ = '\n';
+        return out;
+    }
+    
+    // Bid levels (Depth levels)
+    for (int i = 0; i < Depth; ++i) {
+        out = write_level(mbp_row.bid_levels[i], out);
+    }
+    
+    // Ask levels (Depth levels)
+    for (int i = 0; i < Depth; ++i) {
+        out = write_level(mbp_row.ask_levels[i], out);
     }
+    
+    // Final fields
+    out = write_symbol_and_order_id(mbp_row, out);
+    
+    *out++ = '\n';
+    return out;
 }
 
-std::string CsvWriter::format_price(double price) const {
-    if (price == 0.0) {
-        return ""; // Empty string for zero prices
+template <int Depth>
+char* BasicCsvWriter<Depth>::write_level_deltas(char* output, char side,
+                                    const Level* levels,
+                                    Level* last_levels,
+                                    int& change_count) const {
+    // Levels are matched by price, not position: a new best level shifts
+    // every other level down one depth, but only the new one is reported
+    auto find_price = [](const Level* search, uint64_t price_scaled) {
+        for (int i = 0; i < Depth && search[i].count != 0; ++i) {
+            if (search[i].price_scaled == price_scaled) {
+                return i;
+            }
+        }
+        return -1;
+    };
+    
+    char* out = output;
+    
+    // Levels that left the top of the book: price with zero size and count
+    for (int i = 0; i < Depth && last_levels[i].count != 0; ++i) {
+        if (find_price(levels, last_levels[i].price_scaled) < 0) {
+            *out++ = ',';
+            *out++ = side;
+            *out++ = ',';
+            out = Utils::write_uint64(static_cast<uint64_t>(i), out);
+            out = write_level(Level(last_levels[i].price_scaled, 0, 0), out);
+            change_count++;
+        }
     }
     
-    // Format with high precision and remove trailing zeros
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(9) << price;
-    std::string result = oss.str();
-    
-    // Remove trailing zeros after decimal point
-    if (result.find('.') != std::string::npos) {
-        result = result.substr(0, result.find_last_not_of('0') + 1);
-        if (result.back() == '.') {
-            result.pop_back();
+    // Levels that are new or whose size/count changed
+    for (int i = 0; i < Depth && levels[i].count != 0; ++i) {
+        int last_depth = find_price(last_levels, levels[i].price_scaled);
+        if (last_depth >= 0 && last_levels[last_depth].size == levels[i].size &&
+            last_levels[last_depth].count == levels[i].count) {
+            continue;
         }
+        
+        *out++ = ',';
+        *out++ = side;
+        *out++ = ',';
+        out = Utils::write_uint64(static_cast<uint64_t>(i), out);
+        out = write_level(levels[i], out);
+        change_count++;
     }
     
-    return result;
+    std::copy(levels, levels + Depth, last_levels);
+    return out;
 }
 
-std::string CsvWriter::format_size(uint64_t size) const {
-    if (size == 0) {
-        return "0"; // Always show 0 for sizes, not empty
+template <int Depth>
+char* BasicCsvWriter<Depth>::write_level(const Level& level, char* output) {
+    *output++ = ',';
+    output = write_price(level.price_scaled, output);
+    *output++ = ',';
+    output = Utils::write_uint64(level.size, output);
+    *output++ = ',';
+    return Utils::write_uint64(level.count, output);
+}
+
+template <int Depth>
+char* BasicCsvWriter<Depth>::write_price(uint64_t price_scaled, char* output) {
+    if (price_scaled == 0) {
+        return output; // Empty field for zero prices
     }
     
-    return std::to_string(size);
+    return Utils::write_price_scaled(price_scaled, output);
+}
+
+template <int Depth>
+char* BasicCsvWriter<Depth>::write_symbol_and_order_id(const MBPRow& mbp_row, char* output) {
+    const std::string& symbol = symbol_text(mbp_row.symbol_id);
+    
+    *output++ = ',';
+    std::memcpy(output, symbol.data(), symbol.size());
+    output += symbol.size();
+    *output++ = ',';
+    return Utils::write_uint64(mbp_row.order_id, output);
 }
 
-std::string CsvWriter::format_count(uint32_t count) const {
-    if (count == 0) {
-        return "0"; // Always show 0 for counts, not empty
+template <int Depth>
+size_t BasicCsvWriter<Depth>::format_timestamp(int64_t timestamp_ns, char* output) const {
+    return Utils::write_timestamp_ns(timestamp_ns, output);
+}
+
+template <int Depth>
+const std::string& BasicCsvWriter<Depth>::symbol_text(uint32_t symbol_id) {
+    if (symbol_id >= symbol_bytes.size()) {
+        symbol_bytes.resize(symbol_id + 1);
+    }
+    
+    std::string& text = symbol_bytes[symbol_id];
+    if (text.empty()) {
+        text = SymbolTable::instance().lookup(symbol_id);
     }
     
-    return std::to_string(count);
+    return text;
 }
 
-std::string CsvWriter::format_timestamp(const std::string& timestamp) const {
-    // Return timestamp as-is (already in correct format)
-    return timestamp;
+template <int Depth>
+bool BasicCsvWriter<Depth>::buffered_write(const std::string& data) {
+    if (!is_open()) {
+        return false;
+    }
+    
+    output_stream << data;
+    return output_stream.good();
 }
 
-bool CsvWriter::buffered_write(const std::string& data) {
+template <int Depth>
+bool BasicCsvWriter<Depth>::buffered_write(const char* data, size_t length) {
     if (!is_open()) {
         return false;
     }
     
-    output_stream << data;
+    output_stream.write(data, static_cast<std::streamsize>(length));
     return output_stream.good();
 }
 
-bool CsvWriter::validate_mbp_row(const OrderBook::MBPRow& mbp_row) const {
+template <int Depth>
+bool BasicCsvWriter<Depth>::validate_mbp_row(const MBPRow& mbp_row) const {
     // Basic validation to ensure data integrity
     
-    // Check that timestamps are not empty
-    if (mbp_row.ts_recv.empty() || mbp_row.ts_event.empty()) {
+    // Check that timestamps are set
+    if (mbp_row.ts_recv == 0 || mbp_row.ts_event == 0) {
         return false;
     }
     
     // Check that symbol is not empty
-    if (mbp_row.symbol.empty()) {
+    if (mbp_row.symbol_id == SymbolTable::NO_SYMBOL) {
         return false;
     }
     
     // Check that action and side are valid
     if (mbp_row.action != 'A' && mbp_row.action != 'C' && mbp_row.action != 'T' && 
-        mbp_row.action != 'F' && mbp_row.action != 'R') {
+        mbp_row.action != 'F' && mbp_row.action != 'R' && mbp_row.action != 'M') {
         return false;
     }
     
@@ -307,28 +570,12 @@ bool CsvWriter::validate_mbp_row(const OrderBook::MBPRow& mbp_row) const {
         return false;
     }
     
-    // Validate price levels - prices should be non-negative
-    for (int i = 0; i < Utils::MAX_DEPTH; ++i) {
-        if (mbp_row.bid_levels[i].price < 0.0 || mbp_row.ask_levels[i].price < 0.0) {
-            return false;
-        }
-        
-        // If price is non-zero, size should typically be non-zero too
-        if (mbp_row.bid_levels[i].price > 0.0 && mbp_row.bid_levels[i].size == 0) {
-            // This might be valid in some cases, so just warn
-            // return false;
-        }
-        
-        if (mbp_row.ask_levels[i].price > 0.0 && mbp_row.ask_levels[i].size == 0) {
-            // This might be valid in some cases, so just warn
-            // return false;
-        }
-    }
-    
+    // Price levels need no range check: prices are unsigned fixed-point
     return true;
 }
 
-size_t CsvWriter::get_current_file_size() {
+template <int Depth>
+size_t BasicCsvWriter<Depth>::get_current_file_size() {
     if (!output_stream.is_open()) {
         return 0;
     }
@@ -338,11 +585,13 @@ size_t CsvWriter::get_current_file_size() {
     return static_cast<size_t>(current_pos);
 }
 
-std::string CsvWriter::create_empty_level_string() const {
+template <int Depth>
+std::string BasicCsvWriter<Depth>::create_empty_level_string() const {
     return ",,0"; // Empty price, empty size, zero count
 }
 
-void CsvWriter::handle_write_error(const std::string& error_message) {
+template <int Depth>
+void BasicCsvWriter<Depth>::handle_write_error(const std::string& error_message) {
     current_result.success = false;
     current_result.error_message = error_message;
     
@@ -350,7 +599,8 @@ void CsvWriter::handle_write_error(const std::string& error_message) {
 }
 
 // WriteResult implementation
-void CsvWriter::WriteResult::print_summary() const {
+template <int Depth>
+void BasicCsvWriter<Depth>::WriteResult::print_summary() const {
     std::cout << "\n=== CSV Writing Summary ===" << std::endl;
     std::cout << "Success: " << (success ? "Yes" : "No") << std::endl;
     
@@ -360,6 +610,11 @@ void CsvWriter::WriteResult::print_summary() const {
     
     std::cout << "Rows written: " << rows_written << std::endl;
     std::cout << "Bytes written: " << bytes_written << std::endl;
+    
+    if (async_mode) {
+        std::cout << "Async writer backpressure wait: " << std::fixed << std::setprecision(3)
+                  << async_blocked_ms << " ms" << std::endl;
+    }
     std::cout << "Writing time: " << std::fixed << std::setprecision(3) 
               << writing_time_ms << " ms" << std::endl;
     
@@ -371,4 +626,9 @@ void CsvWriter::WriteResult::print_summary() const {
     }
     
     std::cout << "=============================" << std::endl;
-}
\ No newline at end of file
+}
+
+// Writer depths matching the compiled order books (MBP-1, MBP-10, MBP-50)
+template class BasicCsvWriter<1>;
+template class BasicCsvWriter<Utils::MAX_DEPTH>;
+template class BasicCsvWriter<50>;
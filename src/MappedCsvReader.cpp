@@ -0,0 +1,579 @@
+#include "MappedCsvReader.hpp"
+#include "SymbolTable.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+// Platform-specific includes for file mapping
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @file MappedCsvReader.cpp
+ * @brief Implementation of the zero-copy memory-mapped MBO reader
+ * 
+ * The file is mapped once and parsed in place. Lines and fields are
+ * std::string_view slices of the mapping, cut at the delimiter offsets
+ * found by DelimiterScanner, so the only copies left are
+ * the ones into the Order's own members (whose storage is reused from
+ * line to line).
+ */
+
+MappedCsvReader::MappedCsvReader(const std::string& csv_filename)
+    : filename(csv_filename), mapped_data(nullptr), mapped_size(0), released_bytes(0),
+#ifdef _WIN32
+      file_handle(nullptr), mapping_handle(nullptr)
+#else
+      file_descriptor(-1)
+#endif
+    {
+    
+    if (!map_file()) {
+        std::cerr << "Error: Cannot map file '" << filename << "'" << std::endl;
+        return;
+    }
+    
+    std::cout << "MappedCsvReader initialized for file: " << filename << std::endl;
+    std::cout << "Mapped size: " << mapped_size << " bytes" << std::endl;
+}
+
+MappedCsvReader::~MappedCsvReader() {
+    unmap_file();
+}
+
+bool MappedCsvReader::is_open() const {
+    return mapped_data != nullptr;
+}
+
+bool MappedCsvReader::map_file() {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    file_handle = file;
+    
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        return false;
+    }
+    mapped_size = static_cast<size_t>(file_size.QuadPart);
+    
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        return false;
+    }
+    mapping_handle = mapping;
+    
+    mapped_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    return mapped_data != nullptr;
+#else
+    file_descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (file_descriptor < 0) {
+        return false;
+    }
+    
+    struct stat file_stat;
+    if (::fstat(file_descriptor, &file_stat) != 0 || file_stat.st_size == 0) {
+        return false;
+    }
+    mapped_size = static_cast<size_t>(file_stat.st_size);
+    
+    void* mapping = ::mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (mapping == MAP_FAILED) {
+        mapped_size = 0;
+        return false;
+    }
+    
+    // We walk the file front to back exactly once
+    ::madvise(mapping, mapped_size, MADV_SEQUENTIAL);
+    
+    mapped_data = static_cast<const char*>(mapping);
+    return true;
+#endif
+}
+
+void MappedCsvReader::unmap_file() {
+#ifdef _WIN32
+    if (mapped_data != nullptr) {
+        UnmapViewOfFile(mapped_data);
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(mapping_handle));
+    }
+    if (file_handle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(file_handle));
+    }
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+#else
+    if (mapped_data != nullptr) {
+        ::munmap(const_cast<char*>(mapped_data), mapped_size);
+    }
+    if (file_descriptor >= 0) {
+        ::close(file_descriptor);
+    }
+    file_descriptor = -1;
+#endif
+    mapped_data = nullptr;
+    mapped_size = 0;
+}
+
+bool MappedCsvReader::next_line(std::string_view& line, std::string_view* fields,
+                                size_t& field_count) {
+    return record_cursor.next(line, fields, MAX_FIELDS, field_count);
+}
+
+bool MappedCsvReader::read_header(ParseResult& result) {
+    if (!is_open()) {
+        result.error_messages.push_back("File is not open or has errors");
+        return false;
+    }
+    
+    record_cursor.reset(mapped_data, mapped_data + mapped_size);
+    released_bytes = 0;
+    
+    std::string_view header_line;
+    std::string_view fields[MAX_FIELDS];
+    size_t field_count = 0;
+    if (!next_line(header_line, fields, field_count)) {
+        result.error_messages.push_back("Cannot read header line");
+        return false;
+    }
+    
+    if (!parse_header(fields, std::min(field_count, MAX_FIELDS))) {
+        result.error_messages.push_back("Invalid CSV header format");
+        return false;
+    }
+    
+    result.total_lines_read = 1; // Header counts as one line
+    return true;
+}
+
+bool MappedCsvReader::parse_header(const std::string_view* fields, size_t field_count) {
+    column_indices = ColumnIndices();
+    
+    int index = 0;
+    
+    for (size_t i = 0; i < field_count; ++i) {
+        std::string_view field = Utils::trim_view(fields[i]);
+        
+        if (field == "ts_recv") {
+            column_indices.ts_recv = index;
+        } else if (field == "ts_event") {
+            column_indices.ts_event = index;
+        } else if (field == "publisher_id") {
+            column_indices.publisher_id = index;
+        } else if (field == "instrument_id") {
+            column_indices.instrument_id = index;
+        } else if (field == "action") {
+            column_indices.action = index;
+        } else if (field == "side") {
+            column_indices.side = index;
+        } else if (field == "price") {
+            column_indices.price = index;
+        } else if (field == "size") {
+            column_indices.size = index;
+        } else if (field == "order_id") {
+            column_indices.order_id = index;
+        } else if (field == "flags") {
+            column_indices.flags = index;
+        } else if (field == "ts_in_delta") {
+            column_indices.ts_in_delta = index;
+        } else if (field == "sequence") {
+            column_indices.sequence = index;
+        } else if (field == "symbol") {
+            column_indices.symbol = index;
+        }
+        
+        ++index;
+    }
+    
+    if (!column_indices.is_valid()) {
+        std::cerr << "Error: Missing required columns in CSV header" << std::endl;
+        std::cerr << "Required columns: ts_recv, ts_event, action, side, order_id, sequence, symbol" << std::endl;
+        return false;
+    }
+    
+    std::cout << "Header parsed successfully. Found " << index << " columns." << std::endl;
+    return true;
+}
+
+bool MappedCsvReader::parse_line_to_order(const std::string_view* fields, size_t field_count,
+                                          Order& order) const {
+    // Minimum expected fields for MBO
+    if (field_count < 15) {
+        return false;
+    }
+    
+    size_t stored_fields = std::min(field_count, MAX_FIELDS);
+    auto get = [&](int index) -> std::string_view {
+        return (index >= 0 && static_cast<size_t>(index) < stored_fields)
+            ? Utils::trim_view(fields[index]) : std::string_view();
+    };
+    
+    // Timestamps are converted straight from the mapping, no copy
+    order.ts_recv = Utils::parse_timestamp_ns(get(column_indices.ts_recv));
+    order.ts_event = Utils::parse_timestamp_ns(get(column_indices.ts_event));
+    
+    std::string_view action = get(column_indices.action);
+    order.action = action.empty() ? ' ' : action[0];
+    
+    std::string_view side = get(column_indices.side);
+    order.side = side.empty() ? 'N' : side[0];
+    
+    // Price might be empty for some actions (parses to 0)
+    order.price_scaled = Utils::parse_price_scaled(get(column_indices.price));
+    
+    order.size = Utils::fast_string_to_uint32(get(column_indices.size));
+    order.order_id = Utils::fast_string_to_uint64(get(column_indices.order_id));
+    order.sequence = Utils::fast_string_to_uint64(get(column_indices.sequence));
+    order.flags = Utils::fast_string_to_uint32(get(column_indices.flags));
+    order.ts_in_delta = Utils::fast_string_to_uint64(get(column_indices.ts_in_delta));
+    order.symbol_id = SymbolTable::instance().intern(get(column_indices.symbol));
+    order.instrument_id = Utils::fast_string_to_uint32(get(column_indices.instrument_id));
+    order.publisher_id = static_cast<uint16_t>(Utils::fast_string_to_uint32(get(column_indices.publisher_id)));
+    
+    return true;
+}
+
+MappedCsvReader::ParseResult MappedCsvReader::parse_all_orders() {
+    Utils::Timer parse_timer("Mapped CSV Parsing");
+    ParseResult result;
+    
+    if (!read_header(result)) {
+        return result;
+    }
+    
+    // Size the output up front from the average MBO line length
+    result.orders.reserve(mapped_size / 100 + 1);
+    
+    std::string_view line;
+    std::string_view fields[MAX_FIELDS];
+    size_t field_count = 0;
+    Order current_order;
+    
+    while (next_line(line, fields, field_count)) {
+        result.total_lines_read++;
+        
+        // Skip empty lines
+        if (Utils::trim_view(line).empty()) {
+            continue;
+        }
+        
+        if (parse_line_to_order(fields, field_count, current_order)) {
+            if (CsvReader::validate_order(current_order)) {
+                result.orders.push_back(current_order);
+                result.successful_parses++;
+            } else {
+                std::string error_msg = "Order validation failed at line " +
+                                      std::to_string(result.total_lines_read);
+                handle_parsing_error(result.total_lines_read, error_msg, result);
+            }
+        } else {
+            std::string error_msg = "Failed to parse line " +
+                                  std::to_string(result.total_lines_read);
+            handle_parsing_error(result.total_lines_read, error_msg, result);
+        }
+    }
+    
+    result.parsing_time_ms = parse_timer.elapsed_ms();
+    
+    std::cout << "\nParsing completed:" << std::endl;
+    result.print_summary();
+    
+    return result;
+}
+
+MappedCsvReader::ParseResult MappedCsvReader::parse_in_chunks(size_t chunk_size,
+                                                           std::function<void(const std::vector<Order>&)> callback) {
+    Utils::Timer parse_timer("Chunked Mapped CSV Parsing");
+    ParseResult result;
+    
+    if (!read_header(result)) {
+        return result;
+    }
+    
+    if (chunk_size == 0) {
+        chunk_size = 1;
+    }
+    
+    std::vector<Order> chunk(chunk_size);
+    size_t chunk_fill = 0;
+    
+    std::string_view line;
+    std::string_view fields[MAX_FIELDS];
+    size_t field_count = 0;
+    
+    while (next_line(line, fields, field_count)) {
+        result.total_lines_read++;
+        
+        if (Utils::trim_view(line).empty()) {
+            continue;
+        }
+        
+        // Parse straight into the chunk slot so its strings keep their capacity
+        Order& slot = chunk[chunk_fill];
+        if (parse_line_to_order(fields, field_count, slot) && CsvReader::validate_order(slot)) {
+            result.successful_parses++;
+            
+            if (++chunk_fill == chunk_size) {
+                callback(chunk);
+                chunk_fill = 0;
+                release_consumed(record_cursor.position());
+            }
+        } else {
+            result.parsing_errors++;
+        }
+    }
+    
+    // Process remaining orders
+    if (chunk_fill > 0) {
+        chunk.resize(chunk_fill);
+        callback(chunk);
+    }
+    
+    result.parsing_time_ms = parse_timer.elapsed_ms();
+    return result;
+}
+
+MappedCsvReader::ParseResult MappedCsvReader::parse_in_chunks_parallel(size_t chunk_size, size_t num_threads,
+                                                                    std::function<void(const std::vector<Order>&)> callback) {
+    Utils::Timer parse_timer("Parallel Mapped CSV Parsing");
+    ParseResult result;
+    
+    if (!read_header(result)) {
+        return result;
+    }
+    
+    if (chunk_size == 0) {
+        chunk_size = 1;
+    }
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    // Size ranges from the average line length of the first window
+    const char* data_begin = record_cursor.position();
+    const char* data_end = mapped_data + mapped_size;
+    size_t sample_bytes = std::min<size_t>(DelimiterScanner::RecordCursor::WINDOW_SIZE,
+                                           static_cast<size_t>(data_end - data_begin));
+    size_t sample_lines = static_cast<size_t>(std::count(data_begin, data_begin + sample_bytes, '\n'));
+    size_t avg_line_bytes = sample_lines > 0 ? sample_bytes / sample_lines : sample_bytes;
+    
+    std::vector<const char*> boundaries = split_at_newlines(data_begin, data_end,
+                                                            std::max<size_t>(chunk_size * avg_line_bytes, 4096));
+    size_t range_count = boundaries.size() - 1;
+    
+    std::cout << "Parsing " << range_count << " ranges on " << num_threads << " threads" << std::endl;
+    
+    // Ring of batches bounds how far workers may run ahead of delivery
+    const size_t ring_size = num_threads * 2;
+    std::vector<RangeBatch> ring(ring_size);
+    
+    std::mutex ring_mutex;
+    std::condition_variable batch_ready;
+    std::condition_variable slot_free;
+    size_t next_range = 0;
+    size_t delivered = 0;
+    bool aborted = false;
+    std::exception_ptr worker_error;
+    
+    auto worker = [&]() {
+        while (true) {
+            size_t range;
+            {
+                std::unique_lock<std::mutex> lock(ring_mutex);
+                range = next_range++;
+                if (range >= range_count) {
+                    return;
+                }
+                slot_free.wait(lock, [&] { return aborted || range < delivered + ring_size; });
+                if (aborted) {
+                    return;
+                }
+            }
+            
+            RangeBatch& batch = ring[range % ring_size];
+            try {
+                parse_range(boundaries[range], boundaries[range + 1], batch);
+            } catch (...) {
+                // Stop the other workers and the delivery loop; rethrown after join
+                {
+                    std::lock_guard<std::mutex> lock(ring_mutex);
+                    if (!worker_error) {
+                        worker_error = std::current_exception();
+                    }
+                    aborted = true;
+                }
+                batch_ready.notify_all();
+                slot_free.notify_all();
+                return;
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock(ring_mutex);
+                batch.ready = true;
+            }
+            batch_ready.notify_all();
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers.emplace_back(worker);
+    }
+    
+    // Ordered merge: deliver ranges strictly in file order on this thread
+    std::exception_ptr callback_error;
+    for (size_t range = 0; range < range_count; ++range) {
+        RangeBatch& batch = ring[range % ring_size];
+        {
+            std::unique_lock<std::mutex> lock(ring_mutex);
+            batch_ready.wait(lock, [&] { return batch.ready || worker_error != nullptr; });
+            if (!batch.ready) {
+                break; // A worker failed; this range will never arrive
+            }
+        }
+        
+        result.total_lines_read += batch.lines_read;
+        result.successful_parses += batch.orders.size();
+        result.parsing_errors += batch.parsing_errors;
+        
+        try {
+            if (!batch.orders.empty()) {
+                callback(batch.orders);
+            }
+        } catch (...) {
+            callback_error = std::current_exception();
+        }
+        
+        release_consumed(boundaries[range + 1]);
+        
+        {
+            std::lock_guard<std::mutex> lock(ring_mutex);
+            batch.ready = false;
+            delivered++;
+            aborted = callback_error != nullptr;
+        }
+        slot_free.notify_all();
+        
+        if (callback_error) {
+            break;
+        }
+    }
+    
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    
+    if (worker_error) {
+        std::rethrow_exception(worker_error);
+    }
+    if (callback_error) {
+        std::rethrow_exception(callback_error);
+    }
+    
+    result.parsing_time_ms = parse_timer.elapsed_ms();
+    return result;
+}
+
+void MappedCsvReader::release_consumed(const char* consumed_end) {
+    // Only bother once a sizeable run of pages has been consumed
+    constexpr size_t RELEASE_GRANULARITY = 16 * 1024 * 1024;
+    
+    size_t consumed = static_cast<size_t>(consumed_end - mapped_data);
+    size_t release_end = consumed - consumed % RELEASE_GRANULARITY;
+    if (release_end <= released_bytes) {
+        return;
+    }
+
+#ifndef _WIN32
+    ::madvise(const_cast<char*>(mapped_data) + released_bytes, release_end - released_bytes, MADV_DONTNEED);
+#endif
+    released_bytes = release_end;
+}
+
+void MappedCsvReader::parse_range(const char* begin, const char* end, RangeBatch& batch) const {
+    batch.cursor.reset(begin, end);
+    batch.lines_read = 0;
+    batch.parsing_errors = 0;
+    
+    std::string_view line;
+    std::string_view fields[MAX_FIELDS];
+    size_t field_count = 0;
+    size_t order_count = 0;
+    
+    while (batch.cursor.next(line, fields, MAX_FIELDS, field_count)) {
+        batch.lines_read++;
+        
+        if (Utils::trim_view(line).empty()) {
+            continue;
+        }
+        
+        // Parse into existing elements first so their strings keep their capacity
+        if (order_count == batch.orders.size()) {
+            batch.orders.emplace_back();
+        }
+        
+        Order& slot = batch.orders[order_count];
+        if (parse_line_to_order(fields, field_count, slot) && CsvReader::validate_order(slot)) {
+            order_count++;
+        } else {
+            batch.parsing_errors++;
+        }
+    }
+    
+    batch.orders.resize(order_count);
+}
+
+std::vector<const char*> MappedCsvReader::split_at_newlines(const char* begin, const char* end,
+                                                           size_t target_bytes) {
+    std::vector<const char*> boundaries;
+    boundaries.push_back(begin);
+    
+    const char* pos = begin;
+    while (static_cast<size_t>(end - pos) > target_bytes) {
+        const char* newline = static_cast<const char*>(
+            std::memchr(pos + target_bytes, '\n', static_cast<size_t>(end - pos - target_bytes)));
+        if (newline == nullptr) {
+            break;
+        }
+        pos = newline + 1;
+        boundaries.push_back(pos);
+    }
+    
+    if (boundaries.back() != end) {
+        boundaries.push_back(end);
+    }
+    
+    return boundaries;
+}
+
+void MappedCsvReader::handle_parsing_error(size_t line_number, const std::string& error_message,
+                                         ParseResult& result) const {
+    result.parsing_errors++;
+    
+    std::string detailed_error = "Line " + std::to_string(line_number) + ": " + error_message;
+    result.error_messages.push_back(detailed_error);
+    
+    // Print error for immediate feedback (but limit to avoid spam)
+    if (result.parsing_errors <= 10) {
+        std::cerr << "Parsing error: " << detailed_error << std::endl;
+    } else if (result.parsing_errors == 11) {
+        std::cerr << "... (suppressing further parsing error messages)" << std::endl;
+    }
+}
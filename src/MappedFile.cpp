@@ -0,0 +1,107 @@
+#include "MappedFile.hpp"
+
+// Platform-specific includes for file mapping
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @file MappedFile.cpp
+ * @brief Read-only file mapping for the binary readers
+ */
+
+MappedFile::MappedFile(const std::string& path, bool sequential)
+    : filename(path), mapped_data(nullptr), mapped_size(0),
+#ifdef _WIN32
+      file_handle(nullptr), mapping_handle(nullptr)
+#else
+      file_descriptor(-1)
+#endif
+    {
+    if (!map_file(sequential)) {
+        unmap_file();
+    }
+}
+
+MappedFile::~MappedFile() {
+    unmap_file();
+}
+
+bool MappedFile::map_file(bool sequential) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    file_handle = file;
+    
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        return false;
+    }
+    mapped_size = static_cast<size_t>(file_size.QuadPart);
+    
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        return false;
+    }
+    mapping_handle = mapping;
+    
+    mapped_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    return mapped_data != nullptr;
+#else
+    file_descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (file_descriptor < 0) {
+        return false;
+    }
+    
+    struct stat file_stat;
+    if (::fstat(file_descriptor, &file_stat) != 0 || file_stat.st_size == 0) {
+        return false;
+    }
+    mapped_size = static_cast<size_t>(file_stat.st_size);
+    
+    void* mapping = ::mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (mapping == MAP_FAILED) {
+        mapped_size = 0;
+        return false;
+    }
+    
+    ::madvise(mapping, mapped_size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    
+    mapped_data = static_cast<const char*>(mapping);
+    return true;
+#endif
+}
+
+void MappedFile::unmap_file() {
+#ifdef _WIN32
+    if (mapped_data != nullptr) {
+        UnmapViewOfFile(mapped_data);
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(mapping_handle));
+    }
+    if (file_handle != nullptr) {
+        CloseHandle(static_cast<HANDLE>(file_handle));
+    }
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+#else
+    if (mapped_data != nullptr) {
+        ::munmap(const_cast<char*>(mapped_data), mapped_size);
+    }
+    if (file_descriptor >= 0) {
+        ::close(file_descriptor);
+    }
+    file_descriptor = -1;
+#endif
+    mapped_data = nullptr;
+    mapped_size = 0;
+}
@@ -0,0 +1,205 @@
+#include "MbpDeltaReader.hpp"
+#include "CsvWriter.hpp"
+#include "SymbolTable.hpp"
+#include <iostream>
+#include <algorithm>
+
+/**
+ * @file MbpDeltaReader.cpp
+ * @brief Expansion of delta MBP rows back into full MBP-10 rows
+ */
+
+MbpDeltaReader::MbpDeltaReader(const std::string& delta_filename)
+    : filename(delta_filename), line_number(0), malformed(false) {
+    fields.reserve(EVENT_FIELDS + 2 * Utils::MAX_DEPTH * TUPLE_FIELDS);
+    
+    input_stream.open(filename, std::ios::in | std::ios::binary);
+    if (!input_stream.is_open()) {
+        std::cerr << "Error: Cannot open delta file '" << filename << "'" << std::endl;
+        return;
+    }
+    
+    // The header names the event columns and ends with "changes"
+    if (!std::getline(input_stream, line)) {
+        std::cerr << "Error: Delta file '" << filename << "' is empty" << std::endl;
+        input_stream.close();
+        return;
+    }
+    line_number = 1;
+    
+    split_line();
+    if (fields.size() != EVENT_FIELDS || fields.back() != "changes") {
+        std::cerr << "Error: '" << filename << "' does not have a delta MBP header" << std::endl;
+        input_stream.close();
+    }
+}
+
+bool MbpDeltaReader::is_open() const {
+    return input_stream.is_open();
+}
+
+bool MbpDeltaReader::next_row(OrderBook::MBPRow& mbp_row) {
+    if (!is_open() || !std::getline(input_stream, line)) {
+        return false;
+    }
+    line_number++;
+    
+    split_line();
+    if (fields.size() < EVENT_FIELDS) {
+        std::cerr << "Error: Delta row at line " << line_number << " has "
+                  << fields.size() << " fields, expected at least " << EVENT_FIELDS << std::endl;
+        malformed = true;
+        return false;
+    }
+    
+    size_t change_count = Utils::fast_string_to_uint64(fields[16]);
+    if (fields.size() != EVENT_FIELDS + change_count * TUPLE_FIELDS || !apply_changes(change_count)) {
+        std::cerr << "Error: Malformed level changes at line " << line_number << std::endl;
+        malformed = true;
+        return false;
+    }
+    
+    // Event columns, in CsvWriter order (fields[0] is the row index)
+    mbp_row.ts_recv = Utils::parse_timestamp_ns(fields[1]);
+    mbp_row.ts_event = Utils::parse_timestamp_ns(fields[2]);
+    mbp_row.rtype = static_cast<int>(parse_signed(fields[3]));
+    mbp_row.publisher_id = static_cast<int>(parse_signed(fields[4]));
+    mbp_row.instrument_id = static_cast<int>(parse_signed(fields[5]));
+    mbp_row.action = fields[6].empty() ? ' ' : fields[6][0];
+    mbp_row.side = fields[7].empty() ? 'N' : fields[7][0];
+    mbp_row.depth = static_cast<int>(parse_signed(fields[8]));
+    mbp_row.price_scaled = parse_price(fields[9]);
+    mbp_row.size = Utils::fast_string_to_uint64(fields[10]);
+    mbp_row.flags = Utils::fast_string_to_uint32(fields[11]);
+    mbp_row.ts_in_delta = Utils::fast_string_to_uint64(fields[12]);
+    mbp_row.sequence = Utils::fast_string_to_uint64(fields[13]);
+    mbp_row.symbol_id = SymbolTable::instance().intern(fields[14]);
+    mbp_row.order_id = Utils::fast_string_to_uint64(fields[15]);
+    
+    std::copy(bid_levels, bid_levels + Utils::MAX_DEPTH, mbp_row.bid_levels);
+    std::copy(ask_levels, ask_levels + Utils::MAX_DEPTH, mbp_row.ask_levels);
+    
+    return true;
+}
+
+long long MbpDeltaReader::expand_to_csv(const std::string& delta_filename, const std::string& output_filename) {
+    MbpDeltaReader reader(delta_filename);
+    if (!reader.is_open()) {
+        return -1;
+    }
+    
+    CsvWriter writer(output_filename, MbpOutputMode::FULL);
+    if (!writer.is_open() || !writer.write_header()) {
+        return -1;
+    }
+    
+    OrderBook::MBPRow mbp_row;
+    long long rows_written = 0;
+    
+    while (reader.next_row(mbp_row)) {
+        if (!writer.write_mbp_row(mbp_row)) {
+            return -1;
+        }
+        rows_written++;
+    }
+    
+    // next_row also stops on a malformed row, including a truncated last
+    // line that ends at EOF; only a clean EOF is success
+    if (reader.has_error() || !reader.input_stream.eof()) {
+        return -1;
+    }
+    
+    if (!writer.flush()) {
+        std::cerr << "Error: Failed to write expanded MBP output '" << output_filename << "'" << std::endl;
+        return -1;
+    }
+    return rows_written;
+}
+
+void MbpDeltaReader::split_line() {
+    fields.clear();
+    
+    std::string_view rest(line);
+    if (!rest.empty() && rest.back() == '\r') {
+        rest.remove_suffix(1);
+    }
+    
+    while (true) {
+        size_t comma = rest.find(',');
+        fields.push_back(rest.substr(0, comma));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        rest.remove_prefix(comma + 1);
+    }
+}
+
+bool MbpDeltaReader::apply_changes(size_t change_count) {
+    for (size_t i = 0; i < change_count; ++i) {
+        const std::string_view* tuple = &fields[EVENT_FIELDS + i * TUPLE_FIELDS];
+        if (tuple[0].size() != 1 || tuple[2].empty()) {
+            return false;
+        }
+        
+        bool is_bid = tuple[0][0] == Utils::SIDE_BID;
+        if (!is_bid && tuple[0][0] != Utils::SIDE_ASK) {
+            return false;
+        }
+        
+        OrderBook::MBPRow::Level change(parse_price(tuple[2]),
+                                        Utils::fast_string_to_uint64(tuple[3]),
+                                        Utils::fast_string_to_uint32(tuple[4]));
+        apply_change(is_bid ? bid_levels : ask_levels, is_bid, change);
+    }
+    
+    return true;
+}
+
+void MbpDeltaReader::apply_change(OrderBook::MBPRow::Level* levels, bool is_bid,
+                                  const OrderBook::MBPRow::Level& change) {
+    // Occupied levels are contiguous and sorted best first
+    int count = 0;
+    int position = 0;
+    while (count < Utils::MAX_DEPTH && levels[count].count != 0) {
+        count++;
+    }
+    while (position < count && (is_bid ? levels[position].price_scaled > change.price_scaled
+                                       : levels[position].price_scaled < change.price_scaled)) {
+        position++;
+    }
+    
+    bool exists = position < count && levels[position].price_scaled == change.price_scaled;
+    
+    if (change.count == 0) {
+        // Removal: close the gap
+        if (exists) {
+            std::copy(levels + position + 1, levels + count, levels + position);
+            levels[count - 1] = OrderBook::MBPRow::Level();
+        }
+        return;
+    }
+    
+    if (!exists) {
+        // Insertion: make room, pushing the worst level out if the side is full
+        if (position == Utils::MAX_DEPTH) {
+            return;
+        }
+        int last = std::min(count, Utils::MAX_DEPTH - 1);
+        std::copy_backward(levels + position, levels + last, levels + last + 1);
+    }
+    levels[position] = change;
+}
+
+uint64_t MbpDeltaReader::parse_price(std::string_view text) {
+    return text.empty() ? 0 : Utils::parse_price_scaled(text);
+}
+
+long long MbpDeltaReader::parse_signed(std::string_view text) {
+    bool negative = !text.empty() && text.front() == '-';
+    if (negative) {
+        text.remove_prefix(1);
+    }
+    
+    long long value = static_cast<long long>(Utils::fast_string_to_uint64(text));
+    return negative ? -value : value;
+}
@@ -1,4 +1,6 @@
 #include "Order.hpp"
+#include "SymbolTable.hpp"
+#include "Utils.hpp"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -72,8 +74,8 @@ namespace OrderUtils {
             return false;
         }
         
-        // For most actions, we need a valid order ID
-        if (order.action != 'R' && order.order_id == 0) {
+        // For most actions, we need a valid order ID (trades carry none)
+        if (order.action != 'R' && order.action != 'T' && order.order_id == 0) {
             return false;
         }
         
@@ -91,12 +93,12 @@ namespace OrderUtils {
         }
         
         // Timestamps should not be empty for most actions
-        if (order.action != 'R' && (order.ts_recv.empty() || order.ts_event.empty())) {
+        if (order.action != 'R' && (order.ts_recv == 0 || order.ts_event == 0)) {
             return false;
         }
         
         // Symbol should not be empty
-        if (order.symbol.empty()) {
+        if (order.symbol_id == SymbolTable::NO_SYMBOL) {
             return false;
         }
         
@@ -124,11 +126,11 @@ namespace OrderUtils {
             std::cout << " | Size: " << order.size;
         }
         
-        std::cout << " | Symbol: " << order.symbol;
+        std::cout << " | Symbol: " << SymbolTable::instance().lookup(order.symbol_id);
         
         if (detailed) {
-            std::cout << "\n  Timestamps: recv=" << order.ts_recv 
-                      << ", event=" << order.ts_event
+            std::cout << "\n  Timestamps: recv=" << Utils::format_timestamp_ns(order.ts_recv)
+                      << ", event=" << Utils::format_timestamp_ns(order.ts_event)
                       << "\n  Flags: " << order.flags
                       << ", Delta: " << order.ts_in_delta
                       << ", Sequence: " << order.sequence;
@@ -156,7 +158,7 @@ namespace OrderUtils {
                order1.flags == order2.flags &&
                order1.ts_in_delta == order2.ts_in_delta &&
                order1.sequence == order2.sequence &&
-               order1.symbol == order2.symbol;
+               order1.symbol_id == order2.symbol_id;
     }
     
     /**
@@ -181,7 +183,7 @@ namespace OrderUtils {
             oss << " x" << order.size;
         }
         
-        oss << " (" << order.symbol << ")";
+        oss << " (" << SymbolTable::instance().lookup(order.symbol_id) << ")";
         
         return oss.str();
     }
@@ -0,0 +1,171 @@
+#include "OrderIndex.hpp"
+#include <cstring>
+#include <new>
+#include <utility>
+
+/**
+ * @file OrderIndex.cpp
+ * @brief Robin Hood order index with incremental growth
+ * 
+ * Invariant of the retiring table during a migration: every slot below
+ * migration_cursor is empty. Entries are drained from the cursor with the
+ * same backward-shift deletion used by erase, so the old table stays a
+ * valid Robin Hood table after every step and lookups in it keep working.
+ */
+
+OrderIndex::Table::Table(size_t capacity)
+    : slots(static_cast<Slot*>(std::calloc(capacity, sizeof(Slot)))),
+      slot_count(capacity), mask(capacity - 1), shift(64), count(0) {
+    if (!slots) {
+        throw std::bad_alloc();
+    }
+    
+    for (size_t size = capacity; size > 1; size >>= 1) {
+        shift--;
+    }
+}
+
+void OrderIndex::Table::insert_new(uint64_t key, uint32_t value) {
+    Slot entry{key, value, 1};
+    size_t index = home(key);
+    
+    while (true) {
+        Slot& slot = slots[index];
+        if (slot.distance == 0) {
+            slot = entry;
+            count++;
+            return;
+        }
+        
+        // Robin Hood: take the slot from an entry that is closer to its home
+        if (slot.distance < entry.distance) {
+            std::swap(slot, entry);
+        }
+        
+        index = (index + 1) & mask;
+        entry.distance++;
+    }
+}
+
+void OrderIndex::Table::erase_at(size_t index) {
+    size_t next = (index + 1) & mask;
+    
+    // Pull displaced followers one slot closer to their home
+    while (slots[next].distance > 1) {
+        slots[index] = slots[next];
+        slots[index].distance--;
+        index = next;
+        next = (next + 1) & mask;
+    }
+    
+    slots[index].distance = 0;
+    count--;
+}
+
+OrderIndex::OrderIndex() : current(MIN_CAPACITY), migration_cursor(0) {}
+
+void OrderIndex::insert_or_assign(uint64_t key, uint32_t value) {
+    if (Slot* slot = current.find(key)) {
+        slot->value = value;
+        return;
+    }
+    
+    if (is_migrating()) {
+        if (Slot* slot = retiring.find(key)) {
+            slot->value = value;
+            return;
+        }
+        migrate(MIGRATION_STEPS);
+    }
+    
+    if ((current.count + 1) * LOAD_DENOMINATOR > current.capacity() * LOAD_NUMERATOR) {
+        start_growth();
+    }
+    
+    current.insert_new(key, value);
+}
+
+bool OrderIndex::erase(uint64_t key) {
+    bool erased = false;
+    
+    if (Slot* slot = current.find(key)) {
+        current.erase_at(static_cast<size_t>(slot - current.slots.get()));
+        erased = true;
+    } else if (is_migrating()) {
+        if (Slot* old_slot = retiring.find(key)) {
+            retiring.erase_at(static_cast<size_t>(old_slot - retiring.slots.get()));
+            erased = true;
+        }
+    }
+    
+    if (is_migrating()) {
+        migrate(MIGRATION_STEPS);
+    }
+    
+    return erased;
+}
+
+void OrderIndex::reserve(size_t expected_keys) {
+    size_t capacity = capacity_for(expected_keys);
+    if (capacity <= current.capacity()) {
+        return;
+    }
+    
+    // Drain any running migration, then rehash everything at once
+    migrate(static_cast<size_t>(-1));
+    
+    Table resized(capacity);
+    for (size_t i = 0; i < current.capacity(); ++i) {
+        const Slot& slot = current.slots[i];
+        if (slot.distance != 0) {
+            resized.insert_new(slot.key, slot.value);
+        }
+    }
+    current = std::move(resized);
+}
+
+void OrderIndex::clear() {
+    std::memset(current.slots.get(), 0, current.capacity() * sizeof(Slot));
+    current.count = 0;
+    
+    retiring = Table();
+    migration_cursor = 0;
+}
+
+void OrderIndex::start_growth() {
+    // A migration always finishes long before the new table fills up; this
+    // only drains when growth is forced early
+    migrate(static_cast<size_t>(-1));
+    
+    retiring = std::move(current);
+    current = Table(retiring.capacity() * 2);
+    migration_cursor = 0;
+}
+
+void OrderIndex::migrate(size_t steps) {
+    while (is_migrating() && steps > 0) {
+        if (retiring.count == 0 || migration_cursor >= retiring.capacity()) {
+            retiring = Table();
+            migration_cursor = 0;
+            return;
+        }
+        
+        Slot& slot = retiring.slots[migration_cursor];
+        if (slot.distance == 0) {
+            migration_cursor++;
+        } else {
+            // erase_at refills the cursor slot with the next displaced entry, if any
+            current.insert_new(slot.key, slot.value);
+            retiring.erase_at(migration_cursor);
+        }
+        steps--;
+    }
+}
+
+size_t OrderIndex::capacity_for(size_t keys) {
+    size_t capacity = MIN_CAPACITY;
+    while (capacity * LOAD_NUMERATOR < keys * LOAD_DENOMINATOR) {
+        capacity *= 2;
+    }
+    return capacity;
+}
@@ -1,49 +1,110 @@
 #include "OrderBook.hpp"
+#include "MappedFile.hpp"
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <algorithm>
+#include <cstring>
+#include <type_traits>
 
 /**
  * @file OrderBook.cpp
- * @brief Implementation of the high-performance order book for MBP-10 reconstruction
+ * @brief Implementation of the high-performance order book for MBP-N reconstruction
  * 
  * This file contains the core logic for maintaining the order book state and
  * generating MBP-10 updates. The implementation is heavily optimized for speed
  * while maintaining correctness according to the specified requirements.
  */
 
-OrderBook::OrderBook() {
+static_assert(sizeof(OrderBook::SnapshotHeader) == 64, "SnapshotHeader layout changed");
+static_assert(sizeof(OrderBook::SnapshotLevel) == 16, "SnapshotLevel layout changed");
+static_assert(sizeof(OrderBook::SnapshotOrder) == 16, "SnapshotOrder layout changed");
+
+namespace {
+    // Pending trades are held as a full Order whatever the input type;
+    // widening a CompactOrder is lossless, narrowing an Order is not
+    const Order& to_pending(const Order& order) { return order; }
+    Order to_pending(const CompactOrder& order) { return order.to_order(); }
+}
+
+template <int Depth>
+BasicOrderBook<Depth>::BasicOrderBook(LadderType ladder_type, bool verbose_logging)
+    : bid_levels(true, ladder_type), ask_levels(false, ladder_type),
+      bid_top(true), ask_top(false), last_sequence(0), pending_fill_order_id(0),
+      trade_pending(false), fill_matched(false), verbose(verbose_logging) {
     // Pre-allocate memory for better performance
     active_orders.reserve(Utils::INITIAL_RESERVE_SIZE);
+    order_pool.reserve(Utils::INITIAL_RESERVE_SIZE);
     
     // Initialize statistics
     stats.reset();
     
-    std::cout << "OrderBook initialized with optimizations for MBP-10 reconstruction" << std::endl;
+    if (verbose) {
+        std::cout << "OrderBook initialized with optimizations for MBP-" << Depth << " reconstruction ("
+                  << ladder_type_name(ladder_type) << " price ladder)" << std::endl;
+    }
 }
 
-OrderBook::~OrderBook() {
+template <int Depth>
+BasicOrderBook<Depth>::~BasicOrderBook() {
     // Print final statistics when order book is destroyed
-    std::cout << "\nOrderBook destruction - Final Statistics:" << std::endl;
-    stats.print();
+    if (verbose) {
+        std::cout << "\nOrderBook destruction - Final Statistics:" << std::endl;
+        stats.print();
+    }
 }
 
-void OrderBook::clear() {
-    // Clear all data structures
-    bid_levels.clear();
-    ask_levels.clear();
-    active_orders.clear();
+template <int Depth>
+void BasicOrderBook<Depth>::clear() {
+    clear_state();
     
     // Reset statistics
     stats.reset();
     
-    std::cout << "OrderBook cleared (R action processed)" << std::endl;
+    if (verbose) {
+        std::cout << "OrderBook cleared (R action processed)" << std::endl;
+    }
+}
+
+template <int Depth>
+void BasicOrderBook<Depth>::clear_state() {
+    // Clear all data structures
+    bid_levels.clear();
+    ask_levels.clear();
+    bid_top.clear();
+    ask_top.clear();
+    active_orders.clear();
+    order_pool.clear();
+    trade_pending = false;
+    fill_matched = false;
+    emitted_best_bid = typename MBPRow::Level();
+    emitted_best_ask = typename MBPRow::Level();
+}
+
+template <int Depth>
+const typename BasicOrderBook<Depth>::MBPRow* BasicOrderBook<Depth>::process_order(const Order& order) {
+    return process_order_impl(order);
+}
+
+template <int Depth>
+const typename BasicOrderBook<Depth>::MBPRow* BasicOrderBook<Depth>::process_order(const CompactOrder& order) {
+    return process_order_impl(order);
 }
 
-const OrderBook::MBPRow* OrderBook::process_order(const Order& order) {
+template <int Depth>
+template <typename OrderT>
+const typename BasicOrderBook<Depth>::MBPRow* BasicOrderBook<Depth>::process_order_impl(const OrderT& order) {
     Utils::Timer processing_timer("");  // Anonymous timer for this operation
     
     bool should_generate_mbp = false;
+    bool fused_trade = false;
+    
+    // A pending trade only survives into its own fill and cancel; anything
+    // else means the sequence was broken and the trade changed nothing
+    if (trade_pending && !continues_pending_trade(order)) {
+        trade_pending = false;
+        fill_matched = false;
+    }
     
     // Process based on action type
     switch (order.action) {
@@ -58,7 +119,11 @@ const OrderBook::MBPRow* OrderBook::process_order(const Order& order) {
             break;
             
         case Utils::ACTION_CANCEL:
-            should_generate_mbp = cancel_order(order);
+            if (trade_pending) {
+                fused_trade = complete_trade(order);
+            } else {
+                should_generate_mbp = cancel_order(order);
+            }
             stats.total_cancellations_processed++;
             break;
             
@@ -68,9 +133,18 @@ const OrderBook::MBPRow* OrderBook::process_order(const Order& order) {
             stats.total_trades_processed++;
             break;
             
+        case Utils::ACTION_MODIFY:
+            should_generate_mbp = modify_order(order);
+            stats.total_modifications_processed++;
+            break;
+            
         case Utils::ACTION_FILL:
-            // Fill actions don't directly affect order book per requirements
-            // They are handled as part of T->F->C sequences
+            // Fills don't change the book; one following a trade names the
+            // resting order that the trade's cancel will remove
+            if (trade_pending) {
+                pending_fill_order_id = order.order_id;
+                fill_matched = true;
+            }
             break;
             
         default:
@@ -80,9 +154,19 @@ const OrderBook::MBPRow* OrderBook::process_order(const Order& order) {
             break;
     }
     
+    last_sequence = order.sequence;
     stats.total_orders_processed++;
     stats.total_processing_time_ms += processing_timer.elapsed_ms();
     
+    // A BBO book has nothing to report unless the top of a side moved. A
+    // fused trade always took size off a best level, and its row is built
+    // already, so only plain updates are dropped
+    if constexpr (Depth == 1) {
+        if ((should_generate_mbp || fused_trade) && !best_levels_changed()) {
+            should_generate_mbp = false;
+        }
+    }
+    
     // Generate MBP snapshot if needed
     if (should_generate_mbp) {
         generate_mbp_snapshot(order);
@@ -90,80 +174,217 @@ const OrderBook::MBPRow* OrderBook::process_order(const Order& order) {
         return &current_mbp_row;
     }
     
+    if (fused_trade) {
+        // complete_trade() already built the combined row
+        stats.mbp_updates_generated++;
+        return &current_mbp_row;
+    }
+    
     return nullptr;
 }
 
-bool OrderBook::add_order(const Order& order) {
+template <int Depth>
+bool BasicOrderBook<Depth>::best_levels_changed() {
+    const auto& best_bid = bid_top.levels[0];
+    const auto& best_ask = ask_top.levels[0];
+    if (best_bid.price_scaled == emitted_best_bid.price_scaled && best_bid.size == emitted_best_bid.size &&
+        best_bid.count == emitted_best_bid.count && best_ask.price_scaled == emitted_best_ask.price_scaled &&
+        best_ask.size == emitted_best_ask.size && best_ask.count == emitted_best_ask.count) {
+        return false;
+    }
+    
+    emitted_best_bid = best_bid;
+    emitted_best_ask = best_ask;
+    return true;
+}
+
+template <int Depth>
+template <typename OrderT>
+bool BasicOrderBook<Depth>::continues_pending_trade(const OrderT& order) const {
+    if (order.action == Utils::ACTION_FILL) {
+        return !fill_matched && order.price_scaled == pending_trade.price_scaled;
+    }
+    if (order.action == Utils::ACTION_CANCEL) {
+        return fill_matched && order.order_id == pending_fill_order_id;
+    }
+    return false;
+}
+
+template <int Depth>
+template <typename OrderT>
+bool BasicOrderBook<Depth>::complete_trade(const OrderT& cancel) {
+    trade_pending = false;
+    fill_matched = false;
+    
+    // Depth of the traded level before the fill leaves the book
+    int depth = get_price_depth(cancel.side, cancel.price_scaled);
+    if (!cancel_order(cancel)) {
+        return false;
+    }
+    
+    // One T row for the whole sequence, on the resting (changed) side
+    pending_trade.side = cancel.side;
+    generate_mbp_snapshot(pending_trade);
+    current_mbp_row.depth = depth;
+    stats.trades_fused++;
+    return true;
+}
+
+template <int Depth>
+template <typename OrderT>
+bool BasicOrderBook<Depth>::add_order(const OrderT& order) {
     // Validate order
     if (!order.is_valid() || order.price_scaled == 0 || order.size == 0) {
         return false;
     }
     
     // Add to active orders tracking
-    active_orders[order.order_id] = OrderInfo(order.side, order.price_scaled, order.size);
-    
-    // Add to appropriate side
-    if (order.is_bid()) {
-        auto& level = bid_levels[order.price_scaled];
-        if (level.order_count == 0) {
-            // New price level
-            level = PriceLevel(order.price_scaled, order.size, order.order_id);
-        } else {
-            // Existing price level
-            level.add_order(order.order_id, order.size);
-        }
-    } else if (order.is_ask()) {
-        auto& level = ask_levels[order.price_scaled];
-        if (level.order_count == 0) {
-            // New price level
-            level = PriceLevel(order.price_scaled, order.size, order.order_id);
-        } else {
-            // Existing price level
-            level.add_order(order.order_id, order.size);
-        }
-    }
+    uint32_t node_index = order_pool.allocate(order.order_id, order.side, order.price_scaled, order.size);
+    active_orders.insert_or_assign(order.order_id, node_index);
     
-    // Check if this affects the top 10 levels
-    return affects_top_levels(order.side, order.price_scaled);
+    // The depth tells us directly whether this affects the top 10 levels
+    return attach_order(node_index) >= 0;
 }
 
-bool OrderBook::cancel_order(const Order& order) {
+template <int Depth>
+template <typename OrderT>
+bool BasicOrderBook<Depth>::cancel_order(const OrderT& order) {
     // Find the order in our tracking
-    auto order_iter = active_orders.find(order.order_id);
-    if (order_iter == active_orders.end()) {
+    const uint32_t* order_entry = active_orders.find(order.order_id);
+    if (order_entry == nullptr) {
         // Order not found - might have been already cancelled or never existed
         return false;
     }
     
-    const OrderInfo& order_info = order_iter->second;
-    bool affects_top = affects_top_levels(order_info.side, order_info.price_scaled);
+    uint32_t node_index = *order_entry;
+    OrderNode& node = order_pool[node_index];
     
-    // Remove from appropriate side
-    if (order_info.side == Utils::SIDE_BID) {
-        auto level_iter = bid_levels.find(order_info.price_scaled);
-        if (level_iter != bid_levels.end()) {
-            bool level_empty = level_iter->second.remove_order(order.order_id, order_info.size);
-            if (level_empty) {
-                bid_levels.erase(level_iter);
-            }
-        }
-    } else if (order_info.side == Utils::SIDE_ASK) {
-        auto level_iter = ask_levels.find(order_info.price_scaled);
-        if (level_iter != ask_levels.end()) {
-            bool level_empty = level_iter->second.remove_order(order.order_id, order_info.size);
-            if (level_empty) {
-                ask_levels.erase(level_iter);
-            }
-        }
+    // Partial cancel: shrink in place, the order keeps its place in the queue
+    if (order.size != 0 && order.size < node.size) {
+        return resize_order(node_index, node.size - order.size) >= 0;
     }
     
+    bool affects_top = detach_order(node_index) >= 0;
+    
     // Remove from active orders
-    active_orders.erase(order_iter);
+    active_orders.erase(order.order_id);
+    order_pool.release(node_index);
     
     return affects_top;
 }
 
-bool OrderBook::process_trade(const Order& order) {
+template <int Depth>
+template <typename OrderT>
+bool BasicOrderBook<Depth>::modify_order(const OrderT& order) {
+    const uint32_t* order_entry = active_orders.find(order.order_id);
+    if (order_entry == nullptr) {
+        return add_order(order);
+    }
+    
+    if (!order.is_valid() || order.price_scaled == 0 || order.size == 0) {
+        return false;
+    }
+    
+    uint32_t node_index = *order_entry;
+    OrderNode& node = order_pool[node_index];
+    
+    if (node.price_scaled == order.price_scaled && node.side == order.side) {
+        // Size change only: update in place, queue priority is kept
+        return resize_order(node_index, order.size) >= 0;
+    }
+    
+    // Price (or side) change: move the node to the back of its new level
+    int old_depth = detach_order(node_index);
+    node.price_scaled = order.price_scaled;
+    node.side = order.side;
+    node.size = order.size;
+    int new_depth = attach_order(node_index);
+    
+    return old_depth >= 0 || new_depth >= 0;
+}
+
+template <int Depth>
+int BasicOrderBook<Depth>::attach_order(uint32_t node_index) {
+    const OrderNode& node = order_pool[node_index];
+    bool is_bid = node.side == Utils::SIDE_BID;
+    
+    // Queue at the back of the level on the appropriate side
+    auto& level = is_bid ? bid_levels.insert(node.price_scaled)
+                         : ask_levels.insert(node.price_scaled);
+    bool new_level = level.order_count == 0;
+    if (new_level) {
+        // New price level
+        level = PriceLevel(node.price_scaled);
+    }
+    level.add_order(order_pool, node_index);
+    
+    // Mirror the change into the cached top levels
+    TopLevels& top = is_bid ? bid_top : ask_top;
+    int depth;
+    if (new_level) {
+        depth = top.insert(level);
+    } else {
+        depth = top.find(node.price_scaled);
+        if (depth >= 0) {
+            top.update(depth, level);
+        }
+    }
+    
+    return depth;
+}
+
+template <int Depth>
+int BasicOrderBook<Depth>::resize_order(uint32_t node_index, uint64_t new_size) {
+    const OrderNode& node = order_pool[node_index];
+    bool is_bid = node.side == Utils::SIDE_BID;
+    
+    PriceLevel* level = (is_bid ? bid_levels : ask_levels).find(node.price_scaled);
+    if (level == nullptr) {
+        return -1;
+    }
+    level->resize_order(order_pool, node_index, new_size);
+    
+    TopLevels& top = is_bid ? bid_top : ask_top;
+    int depth = top.find(node.price_scaled);
+    if (depth >= 0) {
+        top.update(depth, *level);
+    }
+    return depth;
+}
+
+template <int Depth>
+int BasicOrderBook<Depth>::detach_order(uint32_t node_index) {
+    const OrderNode& node = order_pool[node_index];
+    
+    // Unlink from its level on the appropriate side
+    bool is_bid = node.side == Utils::SIDE_BID;
+    PriceLadder<PriceLevel>& levels = is_bid ? bid_levels : ask_levels;
+    TopLevels& top = is_bid ? bid_top : ask_top;
+    int depth = top.find(node.price_scaled);
+    
+    PriceLevel* level = levels.find(node.price_scaled);
+    if (level != nullptr) {
+        bool level_empty = level->remove_order(order_pool, node_index);
+        if (level_empty) {
+            levels.erase(node.price_scaled);
+            if (depth >= 0) {
+                bool was_full = top.is_full();
+                top.remove(depth);
+                if (was_full) {
+                    refill_top_levels(top, levels);
+                }
+            }
+        } else if (depth >= 0) {
+            top.update(depth, *level);
+        }
+    }
+    
+    return depth;
+}
+
+template <int Depth>
+template <typename OrderT>
+bool BasicOrderBook<Depth>::process_trade(const OrderT& order) {
     // As per requirements:
     // 1. If side is 'N', ignore the trade
     if (order.side == Utils::SIDE_NEUTRAL) {
@@ -173,39 +394,19 @@ bool OrderBook::process_trade(const Order& order) {
     // 2. T actions are combined with F->C actions
     // 3. The T action should be placed on the side that actually changes
     // 
-    // The trade order represents a trade that will be followed by F and C actions.
-    // According to the requirements, the T action should go on the side that
-    // is actually affected in the book (the side being consumed).
-    //
-    // If we see a T action on the ASK side at price X, but there's no order
-    // at that price on the ASK side, it means the trade is consuming a BID
-    // order, so we should treat it as affecting the BID side.
-    
-    char effective_side = order.side;
-    
-    // Check if there's actually an order on the specified side at this price
-    if (order.side == Utils::SIDE_ASK) {
-        auto ask_iter = ask_levels.find(order.price_scaled);
-        if (ask_iter == ask_levels.end() || ask_iter->second.order_count == 0) {
-            // No orders on ASK side at this price, so trade affects BID side
-            effective_side = Utils::SIDE_BID;
-        }
-    } else if (order.side == Utils::SIDE_BID) {
-        auto bid_iter = bid_levels.find(order.price_scaled);
-        if (bid_iter == bid_levels.end() || bid_iter->second.order_count == 0) {
-            // No orders on BID side at this price, so trade affects ASK side
-            effective_side = Utils::SIDE_ASK;
-        }
-    }
-    
-    // For now, we'll process the trade as a reduction on the effective side
-    // The actual F and C actions will handle the detailed order modifications
-    
-    // Check if this trade affects the top 10 levels
-    return affects_top_levels(effective_side, order.price_scaled);
+    // The trade's own side is the aggressor's; the book only changes on the
+    // resting side, which the following F and C name. So the trade is held
+    // until that cancel, which emits one T row on its side (complete_trade).
+    pending_trade = to_pending(order);
+    trade_pending = true;
+    fill_matched = false;
+    
+    return false;
 }
 
-void OrderBook::generate_mbp_snapshot(const Order& triggering_order) const {
+template <int Depth>
+template <typename OrderT>
+void BasicOrderBook<Depth>::generate_mbp_snapshot(const OrderT& triggering_order) const {
     // Clear the current MBP row
     current_mbp_row = MBPRow();
     
@@ -214,119 +415,295 @@ void OrderBook::generate_mbp_snapshot(const Order& triggering_order) const {
     current_mbp_row.ts_event = triggering_order.ts_event;
     current_mbp_row.action = triggering_order.action;
     current_mbp_row.side = triggering_order.side;
-    current_mbp_row.price = triggering_order.get_price();
+    current_mbp_row.price_scaled = triggering_order.price_scaled;
     current_mbp_row.size = triggering_order.size;
     current_mbp_row.flags = triggering_order.flags;
-    current_mbp_row.ts_in_delta = triggering_order.ts_in_delta;
+    current_mbp_row.ts_in_delta = static_cast<uint64_t>(triggering_order.ts_in_delta);
     current_mbp_row.sequence = triggering_order.sequence;
-    current_mbp_row.symbol = triggering_order.symbol;
+    current_mbp_row.symbol_id = triggering_order.symbol_id;
+    current_mbp_row.instrument_id = static_cast<int>(triggering_order.instrument_id);
+    current_mbp_row.publisher_id = triggering_order.publisher_id;
     current_mbp_row.order_id = triggering_order.order_id;
     
     // Determine depth based on action and position
     current_mbp_row.depth = get_price_depth(triggering_order.side, triggering_order.price_scaled);
     
-    // Update bid and ask levels
-    update_bid_levels(current_mbp_row);
-    update_ask_levels(current_mbp_row);
+    // The cached top levels already have the output layout (zeroed past the last level)
+    static_assert(std::is_trivially_copyable<typename MBPRow::Level>::value,
+                  "MBPRow::Level must be memcpy-able");
+    std::memcpy(current_mbp_row.bid_levels, bid_top.levels, sizeof(bid_top.levels));
+    std::memcpy(current_mbp_row.ask_levels, ask_top.levels, sizeof(ask_top.levels));
 }
 
-bool OrderBook::affects_top_levels(char side, uint64_t price_scaled) const {
-    int depth = get_price_depth(side, price_scaled);
-    return depth >= 0 && depth < Utils::MAX_DEPTH;
+template <int Depth>
+int BasicOrderBook<Depth>::get_price_depth(char side, uint64_t price_scaled) const {
+    if (side == Utils::SIDE_BID) {
+        return bid_top.find(price_scaled);
+    }
+    if (side == Utils::SIDE_ASK) {
+        return ask_top.find(price_scaled);
+    }
+    return -1;
 }
 
-void OrderBook::update_bid_levels(MBPRow& mbp_row) const {
-    int level = 0;
+template <int Depth>
+void BasicOrderBook<Depth>::refill_top_levels(TopLevels& top, const PriceLadder<PriceLevel>& levels) {
+    if (levels.size() <= static_cast<size_t>(top.count)) {
+        return;
+    }
     
-    // Iterate through bid levels (highest price first due to greater<> comparator)
-    for (const auto& [price, level_info] : bid_levels) {
-        if (level >= Utils::MAX_DEPTH) break;
-        
-        mbp_row.bid_levels[level] = MBPRow::Level(
-            level_info.get_price(),
-            level_info.total_size,
-            level_info.order_count
-        );
-        
-        level++;
+    // The first count ladder levels are exactly the cached ones
+    int skipped = 0;
+    levels.for_each_best([&](uint64_t, const PriceLevel& level) {
+        if (skipped < top.count) {
+            skipped++;
+            return true;
+        }
+        top.append(level);
+        return false;
+    });
+}
+
+template <int Depth>
+void BasicOrderBook<Depth>::rebuild_top_levels(TopLevels& top, const PriceLadder<PriceLevel>& levels) {
+    top.clear();
+    levels.for_each_best([&](uint64_t, const PriceLevel& level) {
+        top.append(level);
+        return !top.is_full();
+    });
+}
+
+template <int Depth>
+bool BasicOrderBook<Depth>::save_snapshot(const std::string& filename, uint64_t resume_position,
+                                          uint64_t rows_written) const {
+    std::ofstream output(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "Error: Cannot create snapshot file '" << filename << "'" << std::endl;
+        return false;
     }
     
-    // Clear remaining levels
-    for (int i = level; i < Utils::MAX_DEPTH; ++i) {
-        mbp_row.bid_levels[i] = MBPRow::Level(); // Default constructor gives zeros
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.depth = Depth;
+    header.last_sequence = last_sequence;
+    header.resume_position = resume_position;
+    header.rows_written = rows_written;
+    header.order_count = active_orders.size();
+    header.bid_level_count = bid_levels.size();
+    header.ask_level_count = ask_levels.size();
+    
+    // Records are staged in memory and written with a single call
+    std::vector<char> buffer(sizeof(header) + (header.bid_level_count + header.ask_level_count) * sizeof(SnapshotLevel)
+                             + header.order_count * sizeof(SnapshotOrder));
+    char* cursor = buffer.data();
+    std::memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+    
+    auto write_level = [&](uint64_t, const PriceLevel& level) {
+        SnapshotLevel level_record{level.price_scaled, level.order_count, 0};
+        std::memcpy(cursor, &level_record, sizeof(level_record));
+        cursor += sizeof(level_record);
+        
+        for (uint32_t node_index = level.head; node_index != OrderPool::NO_NODE; node_index = order_pool[node_index].next) {
+            const OrderNode& node = order_pool[node_index];
+            SnapshotOrder order_record{node.order_id, node.size};
+            std::memcpy(cursor, &order_record, sizeof(order_record));
+            cursor += sizeof(order_record);
+        }
+        return true;
+    };
+    bid_levels.for_each_best(write_level);
+    ask_levels.for_each_best(write_level);
+    
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    output.close();
+    
+    if (!output.good()) {
+        std::cerr << "Error: Failed to write snapshot file '" << filename << "'" << std::endl;
+        return false;
     }
+    return true;
 }
 
-void OrderBook::update_ask_levels(MBPRow& mbp_row) const {
-    int level = 0;
+template <int Depth>
+bool BasicOrderBook<Depth>::load_snapshot(const std::string& filename, uint64_t& resume_position,
+                                          uint64_t& rows_written) {
+    MappedFile snapshot(filename);
+    if (!snapshot.is_open()) {
+        std::cerr << "Error: Cannot map snapshot file '" << filename << "'" << std::endl;
+        return false;
+    }
     
-    // Iterate through ask levels (lowest price first due to less<> comparator)
-    for (const auto& [price, level_info] : ask_levels) {
-        if (level >= Utils::MAX_DEPTH) break;
-        
-        mbp_row.ask_levels[level] = MBPRow::Level(
-            level_info.get_price(),
-            level_info.total_size,
-            level_info.order_count
-        );
-        
-        level++;
+    SnapshotHeader header;
+    if (snapshot.size() < sizeof(header) ||
+        std::memcmp(snapshot.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        std::cerr << "Error: '" << filename << "' is not an order book snapshot" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, snapshot.data(), sizeof(header));
+    if (header.version != SNAPSHOT_VERSION) {
+        std::cerr << "Error: '" << filename << "' has snapshot version " << header.version
+                  << ", expected " << SNAPSHOT_VERSION << std::endl;
+        return false;
+    }
+    if (header.depth != Depth) {
+        std::cerr << "Error: '" << filename << "' was saved by a depth " << header.depth
+                  << " book, this book has depth " << Depth << std::endl;
+        return false;
     }
     
-    // Clear remaining levels
-    for (int i = level; i < Utils::MAX_DEPTH; ++i) {
-        mbp_row.ask_levels[i] = MBPRow::Level(); // Default constructor gives zeros
+    clear_state();
+    active_orders.reserve(header.order_count);
+    order_pool.reserve(header.order_count);
+    
+    const char* cursor = snapshot.data() + sizeof(header);
+    const char* end = snapshot.data() + snapshot.size();
+    if (!load_snapshot_side(cursor, end, header.bid_level_count, true) ||
+        !load_snapshot_side(cursor, end, header.ask_level_count, false) ||
+        active_orders.size() != header.order_count) {
+        std::cerr << "Error: Snapshot file '" << filename << "' is truncated or inconsistent" << std::endl;
+        clear_state();
+        return false;
     }
+    
+    rebuild_top_levels(bid_top, bid_levels);
+    rebuild_top_levels(ask_top, ask_levels);
+    emitted_best_bid = bid_top.levels[0];
+    emitted_best_ask = ask_top.levels[0];
+    last_sequence = header.last_sequence;
+    resume_position = header.resume_position;
+    rows_written = header.rows_written;
+    
+    if (verbose) {
+        std::cout << "OrderBook restored from " << filename << ": " << header.order_count << " orders, "
+                  << header.bid_level_count << " bid / " << header.ask_level_count
+                  << " ask levels, last sequence " << last_sequence << std::endl;
+    }
+    return true;
 }
 
-int OrderBook::get_price_depth(char side, uint64_t price_scaled) const {
-    if (side == Utils::SIDE_BID) {
-        int depth = 0;
-        for (const auto& [price, level_info] : bid_levels) {
-            if (price == price_scaled) {
-                return depth;
-            }
-            depth++;
-            if (depth >= Utils::MAX_DEPTH) break;
+template <int Depth>
+bool BasicOrderBook<Depth>::load_snapshot_side(const char*& cursor, const char* end, uint64_t level_count, bool is_bid) {
+    PriceLadder<PriceLevel>& levels = is_bid ? bid_levels : ask_levels;
+    char side = is_bid ? Utils::SIDE_BID : Utils::SIDE_ASK;
+    
+    for (uint64_t i = 0; i < level_count; ++i) {
+        SnapshotLevel level_record;
+        if (static_cast<size_t>(end - cursor) < sizeof(level_record)) {
+            return false;
         }
-    } else if (side == Utils::SIDE_ASK) {
-        int depth = 0;
-        for (const auto& [price, level_info] : ask_levels) {
-            if (price == price_scaled) {
-                return depth;
-            }
-            depth++;
-            if (depth >= Utils::MAX_DEPTH) break;
+        std::memcpy(&level_record, cursor, sizeof(level_record));
+        cursor += sizeof(level_record);
+        
+        if (level_record.order_count == 0 || level_record.price_scaled == 0 ||
+            static_cast<size_t>(end - cursor) / sizeof(SnapshotOrder) < level_record.order_count ||
+            levels.find(level_record.price_scaled) != nullptr) {
+            return false;
+        }
+        
+        PriceLevel& level = levels.insert(level_record.price_scaled);
+        level = PriceLevel(level_record.price_scaled);
+        
+        // Orders come oldest first, so appending restores queue priority
+        for (uint32_t j = 0; j < level_record.order_count; ++j) {
+            SnapshotOrder order_record;
+            std::memcpy(&order_record, cursor, sizeof(order_record));
+            cursor += sizeof(order_record);
+            
+            uint32_t node_index = order_pool.allocate(order_record.order_id, side,
+                                                      level_record.price_scaled, order_record.size);
+            active_orders.insert_or_assign(order_record.order_id, node_index);
+            level.add_order(order_pool, node_index);
         }
     }
+    return true;
+}
+
+template <int Depth>
+int BasicOrderBook<Depth>::TopLevels::insert(const PriceLevel& level) {
+    int depth = 0;
+    while (depth < count && (is_bid ? prices[depth] > level.price_scaled
+                                    : prices[depth] < level.price_scaled)) {
+        depth++;
+    }
+    
+    if (depth == Depth) {
+        return -1;
+    }
+    
+    // Shift worse levels down one slot; the last one falls off when full
+    int last = std::min(count, Depth - 1);
+    for (int i = last; i > depth; --i) {
+        prices[i] = prices[i - 1];
+        levels[i] = levels[i - 1];
+    }
+    if (count < Depth) {
+        count++;
+    }
     
-    return -1; // Not found in top 10
+    prices[depth] = level.price_scaled;
+    levels[depth] = typename MBPRow::Level(level.price_scaled, level.total_size, level.order_count);
+    return depth;
 }
 
-std::pair<double, double> OrderBook::get_spread() const {
+template <int Depth>
+void BasicOrderBook<Depth>::TopLevels::update(int depth, const PriceLevel& level) {
+    levels[depth].size = level.total_size;
+    levels[depth].count = level.order_count;
+}
+
+template <int Depth>
+void BasicOrderBook<Depth>::TopLevels::remove(int depth) {
+    std::copy(prices + depth + 1, prices + count, prices + depth);
+    std::copy(levels + depth + 1, levels + count, levels + depth);
+    count--;
+    prices[count] = 0;
+    levels[count] = typename MBPRow::Level();
+}
+
+template <int Depth>
+void BasicOrderBook<Depth>::TopLevels::append(const PriceLevel& level) {
+    prices[count] = level.price_scaled;
+    levels[count] = typename MBPRow::Level(level.price_scaled, level.total_size, level.order_count);
+    count++;
+}
+
+template <int Depth>
+void BasicOrderBook<Depth>::TopLevels::clear() {
+    std::fill(prices, prices + Depth, 0);
+    std::fill(levels, levels + Depth, typename MBPRow::Level());
+    count = 0;
+}
+
+template <int Depth>
+std::pair<double, double> BasicOrderBook<Depth>::get_spread() const {
     double best_bid = 0.0;
     double best_ask = 0.0;
     
-    if (!bid_levels.empty()) {
-        best_bid = bid_levels.begin()->second.get_price();
+    if (const PriceLevel* best_bid_level = bid_levels.best()) {
+        best_bid = best_bid_level->get_price();
     }
     
-    if (!ask_levels.empty()) {
-        best_ask = ask_levels.begin()->second.get_price();
+    if (const PriceLevel* best_ask_level = ask_levels.best()) {
+        best_ask = best_ask_level->get_price();
     }
     
     return std::make_pair(best_bid, best_ask);
 }
 
-size_t OrderBook::get_total_orders() const {
+template <int Depth>
+size_t BasicOrderBook<Depth>::get_total_orders() const {
     return active_orders.size();
 }
 
-std::pair<size_t, size_t> OrderBook::get_level_counts() const {
+template <int Depth>
+std::pair<size_t, size_t> BasicOrderBook<Depth>::get_level_counts() const {
     return std::make_pair(bid_levels.size(), ask_levels.size());
 }
 
-void OrderBook::print_book_state(int max_levels) const {
+template <int Depth>
+void BasicOrderBook<Depth>::print_book_state(int max_levels) const {
     std::cout << "\n=== Order Book State ===" << std::endl;
     
     auto [best_bid, best_ask] = get_spread();
@@ -341,26 +718,44 @@ void OrderBook::print_book_state(int max_levels) const {
     
     std::cout << "\nASK Levels (lowest first):" << std::endl;
     int level = 0;
-    for (const auto& [price, level_info] : ask_levels) {
-        if (level >= max_levels) break;
+    auto print_level = [&](uint64_t, const PriceLevel& level_info) {
+        if (level >= max_levels) return false;
         std::cout << "  L" << level << ": " << std::fixed << std::setprecision(6)
                   << level_info.get_price() << " x " << level_info.total_size 
                   << " (" << level_info.order_count << " orders)" << std::endl;
         level++;
-    }
+        return true;
+    };
+    ask_levels.for_each_best(print_level);
     
     std::cout << "\nBID Levels (highest first):" << std::endl;
     level = 0;
-    for (const auto& [price, level_info] : bid_levels) {
-        if (level >= max_levels) break;
-        std::cout << "  L" << level << ": " << std::fixed << std::setprecision(6)
-                  << level_info.get_price() << " x " << level_info.total_size 
-                  << " (" << level_info.order_count << " orders)" << std::endl;
-        level++;
-    }
+    bid_levels.for_each_best(print_level);
     
     auto [bid_count, ask_count] = get_level_counts();
     std::cout << "\nTotal levels - Bids: " << bid_count << ", Asks: " << ask_count << std::endl;
     std::cout << "Total active orders: " << get_total_orders() << std::endl;
     std::cout << "=======================" << std::endl;
-}
\ No newline at end of file
+}
+
+// Book depths offered on the command line (MBP-1, MBP-10, MBP-50)
+template class BasicOrderBook<1>;
+template class BasicOrderBook<Utils::MAX_DEPTH>;
+template class BasicOrderBook<50>;
+
+// The mutation paths are shared by both order representations
+#define INSTANTIATE_ORDER_PATHS(DEPTH, ORDER_T) \
+    template bool BasicOrderBook<DEPTH>::add_order<ORDER_T>(const ORDER_T&); \
+    template bool BasicOrderBook<DEPTH>::cancel_order<ORDER_T>(const ORDER_T&); \
+    template bool BasicOrderBook<DEPTH>::modify_order<ORDER_T>(const ORDER_T&); \
+    template bool BasicOrderBook<DEPTH>::process_trade<ORDER_T>(const ORDER_T&); \
+    template void BasicOrderBook<DEPTH>::generate_mbp_snapshot<ORDER_T>(const ORDER_T&) const;
+
+INSTANTIATE_ORDER_PATHS(1, Order)
+INSTANTIATE_ORDER_PATHS(1, CompactOrder)
+INSTANTIATE_ORDER_PATHS(Utils::MAX_DEPTH, Order)
+INSTANTIATE_ORDER_PATHS(Utils::MAX_DEPTH, CompactOrder)
+INSTANTIATE_ORDER_PATHS(50, Order)
+INSTANTIATE_ORDER_PATHS(50, CompactOrder)
+
+#undef INSTANTIATE_ORDER_PATHS
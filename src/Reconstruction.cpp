@@ -0,0 +1,303 @@
+#include "Reconstruction.hpp"
+#include "SpscRing.hpp"
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <cstdio>
+
+/**
+ * @file Reconstruction.cpp
+ * @brief Event application, checkpoints, conflation and the --pipeline stages
+ */
+
+namespace {
+
+/**
+ * @brief Throughput and stall counters of one --pipeline stage
+ */
+struct PipelineStageStats {
+    const char* name;
+    size_t events = 0;
+    double active_ms = 0.0;             // Stage lifetime, first wait to last event
+    double blocked_ms = 0.0;            // Waiting on an empty input or a full output queue
+    
+    explicit PipelineStageStats(const char* stage_name) : name(stage_name) {}
+    
+    double get_events_per_second() const {
+        return active_ms > 0.0 ? events * 1000.0 / active_ms : 0.0;
+    }
+    
+    double get_blocked_percent() const {
+        return active_ms > 0.0 ? blocked_ms / active_ms * 100.0 : 0.0;
+    }
+    
+    void print() const {
+        std::cout << "  " << std::left << std::setw(8) << name << std::right
+                  << std::setw(10) << events << " events  "
+                  << std::fixed << std::setprecision(0) << std::setw(10) << get_events_per_second() << " events/sec  "
+                  << std::setprecision(1) << std::setw(9) << active_ms << " ms active  "
+                  << std::setw(9) << blocked_ms << " ms blocked ("
+                  << get_blocked_percent() << "%)" << std::endl;
+    }
+};
+
+/**
+ * @brief Order batch handed from the pipeline reader stage to the book stage
+ * Recycled through a free queue, so its storage is only allocated once
+ */
+struct OrderBatch {
+    std::vector<Order> orders;
+};
+
+} // namespace
+
+template <int Depth>
+bool save_checkpoint(const BasicOrderBook<Depth>& order_book, const ReconstructionProgress& progress) {
+    std::string temp_filename = progress.checkpoint_filename + ".tmp";
+    uint64_t rows_written = progress.resume_rows + progress.mbp_updates;
+    if (!order_book.save_snapshot(temp_filename, progress.processed_orders, rows_written)) {
+        return false;
+    }
+
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    std::remove(progress.checkpoint_filename.c_str());
+#endif
+    if (std::rename(temp_filename.c_str(), progress.checkpoint_filename.c_str()) != 0) {
+        std::cerr << "Error: Cannot replace checkpoint file '" << progress.checkpoint_filename << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <int Depth>
+bool write_conflated_row(const BasicOrderBook<Depth>& order_book, BasicCsvWriter<Depth>& csv_writer,
+                         ReconstructionProgress& progress) {
+    if (!progress.conflated_row_pending) {
+        return true;
+    }
+    
+    progress.conflated_row_pending = false;
+    if (!csv_writer.write_mbp_row(order_book.get_last_mbp_row())) {
+        std::cerr << "Error: Failed to write MBP row to output" << std::endl;
+        return false;
+    }
+    progress.mbp_updates++;
+    return true;
+}
+
+template <int Depth, typename OrderT>
+bool apply_order(const OrderT& order, BasicOrderBook<Depth>& order_book, BasicCsvWriter<Depth>& csv_writer,
+                 ReconstructionProgress& progress) {
+    // Events up to a restored checkpoint are already reflected in the book
+    if (progress.processed_orders < progress.resume_position) {
+        if (++progress.processed_orders == progress.resume_position &&
+            order.sequence != order_book.get_last_sequence()) {
+            std::cerr << "Error: Checkpoint does not match the input (sequence " << order.sequence
+                      << " at event " << progress.resume_position << ", checkpoint has "
+                      << order_book.get_last_sequence() << ")" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+    // Special handling for first 'R' action as per requirements
+    if (!progress.first_clear_ignored && order.action == Utils::ACTION_CLEAR) {
+        std::cout << "Ignoring initial clear action (R) as per requirements" << std::endl;
+        progress.first_clear_ignored = true;
+        progress.processed_orders++;
+        return true;
+    }
+    
+    // Conflation: once an event falls in a later time bucket, the held row
+    // is the final state of its bucket; write it before the book moves on.
+    // ts_event is only nearly sorted, so an earlier bucket never reopens.
+    if (progress.conflate_interval_ns != 0) {
+        int64_t bucket = (progress.conflate_on_recv ? order.ts_recv : order.ts_event) / progress.conflate_interval_ns;
+        if (bucket > progress.conflation_bucket) {
+            if (!write_conflated_row(order_book, csv_writer, progress)) {
+                return false;
+            }
+            progress.conflation_bucket = bucket;
+        }
+    }
+    
+    // Process order through order book
+    const typename BasicOrderBook<Depth>::MBPRow* mbp_row = order_book.process_order(order);
+    
+    if (mbp_row != nullptr && progress.conflate_interval_ns != 0) {
+        // Hold the row; a later row in the same bucket replaces it unformatted
+        if (progress.conflated_row_pending) {
+            progress.conflated_rows++;
+        }
+        progress.conflated_row_pending = true;
+    } else if (mbp_row != nullptr) {
+        // If we got an MBP update, write it to output
+        if (!csv_writer.write_mbp_row(*mbp_row)) {
+            std::cerr << "Error: Failed to write MBP row to output" << std::endl;
+            return false;
+        }
+        progress.mbp_updates++;
+    }
+    
+    progress.processed_orders++;
+    
+    // A checkpoint inside a T -> F -> C sequence would lose the pending
+    // trade, so it waits until the sequence completes
+    if (progress.checkpoint_interval != 0 && progress.processed_orders >= progress.next_checkpoint &&
+        !order_book.has_pending_trade()) {
+        if (!save_checkpoint(order_book, progress)) {
+            return false;
+        }
+        progress.next_checkpoint = progress.processed_orders + progress.checkpoint_interval;
+    }
+    
+    // Progress reporting
+    if (progress.processed_orders % 50000 == 0) {
+        double percent = (static_cast<double>(progress.processed_orders) / progress.total_orders) * 100.0;
+        std::cout << "Progress: " << std::fixed << std::setprecision(1) << percent 
+                  << "% (" << progress.processed_orders << "/" << progress.total_orders << " orders, "
+                  << progress.mbp_updates << " MBP updates)" << std::endl;
+        
+        // Memory usage check
+        Utils::MemoryTracker::print_memory_usage("Current memory");
+        
+        // Periodic flush; an async writer owns the stream, so don't stall on it
+        if (!csv_writer.is_async()) {
+            csv_writer.flush();
+        }
+    }
+    
+    return true;
+}
+
+CsvReader::ParseResult parse_chunks(CsvReader* csv_reader, MappedCsvReader* mapped_reader,
+                                    BinaryMboReader* binary_reader, size_t chunk_size, size_t parse_threads,
+                                    std::function<void(const std::vector<Order>&)> callback) {
+    // Records decode at memory speed; extra parser threads would only add hand-off cost
+    if (binary_reader) {
+        return binary_reader->parse_in_chunks(chunk_size, callback);
+    }
+    if (mapped_reader && parse_threads != 1) {
+        return mapped_reader->parse_in_chunks_parallel(chunk_size, parse_threads, callback);
+    }
+    if (mapped_reader) {
+        return mapped_reader->parse_in_chunks(chunk_size, callback);
+    }
+    return csv_reader->parse_in_chunks(chunk_size, callback, parse_threads);
+}
+
+template <int Depth>
+bool run_pipeline(CsvReader* csv_reader, MappedCsvReader* mapped_reader, BinaryMboReader* binary_reader,
+                  size_t parse_threads, BasicOrderBook<Depth>& order_book, BasicCsvWriter<Depth>& csv_writer,
+                  ReconstructionProgress& progress, CsvReader::ParseResult& parse_result) {
+    if (!csv_writer.is_async() && !csv_writer.start_async()) {
+        return false;
+    }
+    
+    std::vector<OrderBatch> batches(PIPELINE_BATCHES);
+    SpscRing<OrderBatch*> free_batches(PIPELINE_BATCHES);
+    SpscRing<OrderBatch*> filled_batches(PIPELINE_BATCHES);
+    for (auto& batch : batches) {
+        batch.orders.reserve(PARSE_CHUNK_SIZE);
+        free_batches.push(&batch);
+    }
+    
+    PipelineStageStats reader_stats("reader");
+    PipelineStageStats book_stats("book");
+    PipelineStageStats writer_stats("writer");
+    
+    std::atomic<bool> book_failed(false);
+    std::exception_ptr reader_error;
+    
+    // Stage 1: parse into recycled batches
+    std::thread reader_thread([&]() {
+        Utils::Timer stage_timer("");
+        try {
+            parse_result = parse_chunks(csv_reader, mapped_reader, binary_reader, PARSE_CHUNK_SIZE, parse_threads,
+                                        [&](const std::vector<Order>& chunk) {
+                // Once the book stage has failed, only drain the input
+                if (book_failed.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                
+                OrderBatch* batch = nullptr;
+                free_batches.pop(batch);
+                batch->orders.assign(chunk.begin(), chunk.end());
+                filled_batches.push(batch);
+                reader_stats.events += chunk.size();
+            });
+        } catch (...) {
+            reader_error = std::current_exception();
+        }
+        
+        filled_batches.close();
+        reader_stats.active_ms = stage_timer.elapsed_ms();
+    });
+    
+    // Stage 2: apply batches on this thread, rows go to the writer thread
+    Utils::Timer book_timer("");
+    OrderBatch* batch = nullptr;
+    while (filled_batches.pop(batch)) {
+        if (!book_failed.load(std::memory_order_relaxed)) {
+            for (const auto& order : batch->orders) {
+                if (!apply_order(order, order_book, csv_writer, progress)) {
+                    book_failed.store(true, std::memory_order_relaxed);
+                    break;
+                }
+            }
+            book_stats.events += batch->orders.size();
+        }
+        free_batches.push(batch);
+    }
+    book_stats.active_ms = book_timer.elapsed_ms();
+    
+    reader_thread.join();
+    
+    // Stage 3: drain and join the writer so its counters are final
+    csv_writer.stop_async();
+    const auto& write_result = csv_writer.get_write_result();
+    
+    reader_stats.blocked_ms = free_batches.get_consumer_blocked_ms() + filled_batches.get_producer_blocked_ms();
+    book_stats.blocked_ms = filled_batches.get_consumer_blocked_ms() + write_result.async_blocked_ms;
+    writer_stats.events = write_result.rows_written;
+    writer_stats.active_ms = write_result.async_thread_ms;
+    writer_stats.blocked_ms = write_result.async_idle_ms;
+    
+    std::cout << "\nPipeline stages:" << std::endl;
+    const PipelineStageStats* bottleneck = &reader_stats;
+    for (const PipelineStageStats* stage : {&reader_stats, &book_stats, &writer_stats}) {
+        stage->print();
+        if (stage->get_blocked_percent() < bottleneck->get_blocked_percent()) {
+            bottleneck = stage;
+        }
+    }
+    std::cout << "  Bottleneck (least blocked stage): " << bottleneck->name << std::endl;
+    
+    if (reader_error) {
+        std::rethrow_exception(reader_error);
+    }
+    
+    return !book_failed.load(std::memory_order_relaxed);
+}
+
+// Loop instantiations matching the compiled order books (MBP-1, MBP-10, MBP-50)
+#define INSTANTIATE_RECONSTRUCTION(DEPTH) \
+    template bool save_checkpoint<DEPTH>(const BasicOrderBook<DEPTH>&, const ReconstructionProgress&); \
+    template bool write_conflated_row<DEPTH>(const BasicOrderBook<DEPTH>&, BasicCsvWriter<DEPTH>&, \
+                                             ReconstructionProgress&); \
+    template bool apply_order<DEPTH, Order>(const Order&, BasicOrderBook<DEPTH>&, BasicCsvWriter<DEPTH>&, \
+                                            ReconstructionProgress&); \
+    template bool apply_order<DEPTH, CompactOrder>(const CompactOrder&, BasicOrderBook<DEPTH>&, \
+                                                   BasicCsvWriter<DEPTH>&, ReconstructionProgress&); \
+    template bool run_pipeline<DEPTH>(CsvReader*, MappedCsvReader*, BinaryMboReader*, size_t, \
+                                      BasicOrderBook<DEPTH>&, BasicCsvWriter<DEPTH>&, \
+                                      ReconstructionProgress&, CsvReader::ParseResult&);
+
+INSTANTIATE_RECONSTRUCTION(1)
+INSTANTIATE_RECONSTRUCTION(Utils::MAX_DEPTH)
+INSTANTIATE_RECONSTRUCTION(50)
+
+#undef INSTANTIATE_RECONSTRUCTION
@@ -0,0 +1,57 @@
+#include "SymbolTable.hpp"
+
+/**
+ * @file SymbolTable.cpp
+ * @brief Implementation of the symbol interning table
+ */
+
+SymbolTable::SymbolTable() {
+    symbols.emplace_back();
+    symbol_ids.emplace(std::string(), NO_SYMBOL);
+}
+
+SymbolTable& SymbolTable::instance() {
+    static SymbolTable table;
+    return table;
+}
+
+uint32_t SymbolTable::intern(std::string_view symbol) {
+    // Fast path: same symbol as this thread's previous call
+    thread_local const SymbolTable* cached_table = nullptr;
+    thread_local std::string cached_symbol;
+    thread_local uint32_t cached_id = NO_SYMBOL;
+    
+    if (cached_table == this && cached_symbol == symbol) {
+        return cached_id;
+    }
+    
+    std::string key(symbol);
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(table_mutex);
+        auto iter = symbol_ids.find(key);
+        if (iter != symbol_ids.end()) {
+            id = iter->second;
+        } else {
+            id = static_cast<uint32_t>(symbols.size());
+            symbols.push_back(key);
+            symbol_ids.emplace(key, id);
+        }
+    }
+    
+    cached_table = this;
+    cached_symbol = std::move(key);
+    cached_id = id;
+    return id;
+}
+
+const std::string& SymbolTable::lookup(uint32_t id) const {
+    static const std::string unknown;
+    std::lock_guard<std::mutex> lock(table_mutex);
+    return id < symbols.size() ? symbols[id] : unknown;
+}
+
+size_t SymbolTable::size() const {
+    std::lock_guard<std::mutex> lock(table_mutex);
+    return symbols.size();
+}
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cstring>
+#include <cstdio>
 #include <iostream>
 #include <iomanip>
 
@@ -84,23 +85,173 @@ double fast_string_to_double(const std::string& str) {
 }
 
 /**
- * @brief Fast string to uint64_t conversion for order IDs and sequences
+ * @brief String view variant of fast_string_to_double
  * 
- * Optimized for parsing large integer values commonly found in
- * order IDs and sequence numbers.
+ * strtod needs a terminated string, so the (short) price text is copied
+ * into a stack buffer first. Anything longer than a price is rejected.
+ */
+double fast_string_to_double(std::string_view str) {
+    char buffer[64];
+    if (str.empty() || str.size() >= sizeof(buffer)) {
+        return 0.0;
+    }
+    
+    std::memcpy(buffer, str.data(), str.size());
+    buffer[str.size()] = '\0';
+    
+    char* end_ptr;
+    double result = std::strtod(buffer, &end_ptr);
+    
+    if (end_ptr == buffer) {
+        return 0.0; // No conversion occurred
+    }
+    
+    return result;
+}
+
+namespace {
+
+/**
+ * @brief Check that 8 bytes loaded little-endian are all ASCII digits
+ */
+inline bool is_eight_digits(uint64_t val) {
+    return ((val & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((val + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
+}
+
+/**
+ * @brief Convert 8 ASCII digits (loaded little-endian) to their value
+ * 
+ * SWAR reduction: adjacent digits are combined into 2-digit, then
+ * 4-digit, then 8-digit values with three multiplies instead of eight.
+ */
+inline uint32_t parse_eight_digits(uint64_t val) {
+    const uint64_t mask = 0x000000FF000000FFULL;
+    const uint64_t mul1 = 100 + (1000000ULL << 32);
+    const uint64_t mul2 = 1 + (10000ULL << 32);
+    val -= 0x3030303030303030ULL;
+    val = (val * 10) + (val >> 8);
+    val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(val);
+}
+
+constexpr bool is_little_endian() {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+    return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#else
+    return true; // x86 / ARM targets this project is built for
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief Parse decimal price text into the 1e9 fixed-point scale
+ * 
+ * Fast path: "<integer digits>.<exactly 9 digits>", which is what every
+ * MBO price looks like. The first 8 fraction digits are converted with a
+ * single SWAR step, the 9th is added separately.
+ * 
+ * 10 integer digits at 1e9 scale stay below 2^64 even after rounding
+ * up, so longer integer parts are rejected rather than wrapped.
  */
-uint64_t fast_string_to_uint64(const std::string& str) {
+uint64_t parse_price_scaled(std::string_view str) {
     if (str.empty()) {
         return 0;
     }
     
+    const char* ptr = str.data();
+    const char* end = ptr + str.size();
+    
+    if (*ptr == '+') {
+        ++ptr;
+    }
+    
+    // Integer part (usually 1-3 digits)
+    uint64_t integer_part = 0;
+    const char* integer_start = ptr;
+    while (ptr < end && static_cast<unsigned>(*ptr - '0') < 10) {
+        integer_part = integer_part * 10 + static_cast<uint64_t>(*ptr - '0');
+        ++ptr;
+    }
+    bool has_integer_digits = ptr != integer_start;
+    
+    // More digits would overflow integer_part * PRICE_SCALE
+    if (ptr - integer_start > MAX_PRICE_INTEGER_DIGITS) {
+        return 0;
+    }
+    
+    if (ptr == end) {
+        return has_integer_digits ? integer_part * PRICE_SCALE : 0;
+    }
+    
+    if (*ptr != '.') {
+        return 0; // Negative, exponent or garbage
+    }
+    ++ptr;
+    
+    size_t fraction_length = static_cast<size_t>(end - ptr);
+    
+    // SWAR fast path for the feed's fixed 9-decimal layout
+    if (is_little_endian() && fraction_length == static_cast<size_t>(PRICE_DECIMALS)) {
+        uint64_t chunk;
+        std::memcpy(&chunk, ptr, sizeof(chunk));
+        unsigned last_digit = static_cast<unsigned>(ptr[8] - '0');
+        
+        if (is_eight_digits(chunk) && last_digit < 10) {
+            uint64_t fraction = static_cast<uint64_t>(parse_eight_digits(chunk)) * 10 + last_digit;
+            return integer_part * PRICE_SCALE + fraction;
+        }
+        return 0;
+    }
+    
+    // General path: up to 9 decimals, round half-up on the 10th
+    uint64_t fraction = 0;
+    int digits = 0;
+    bool round_up = false;
+    
+    for (; ptr < end; ++ptr) {
+        unsigned digit = static_cast<unsigned>(*ptr - '0');
+        if (digit >= 10) {
+            return 0;
+        }
+        
+        if (digits < PRICE_DECIMALS) {
+            fraction = fraction * 10 + digit;
+            ++digits;
+        } else if (digits == PRICE_DECIMALS) {
+            round_up = digit >= 5;
+            ++digits;
+        }
+    }
+    
+    if (!has_integer_digits && digits == 0) {
+        return 0; // A lone "."
+    }
+    
+    for (int i = std::min(digits, PRICE_DECIMALS); i < PRICE_DECIMALS; ++i) {
+        fraction *= 10;
+    }
+    
+    return integer_part * PRICE_SCALE + fraction + (round_up ? 1 : 0);
+}
+
+/**
+ * @brief Fast string to uint64_t conversion for order IDs and sequences
+ * 
+ * Optimized for parsing large integer values commonly found in
+ * order IDs and sequence numbers. Stops at the first non-digit.
+ */
+uint64_t fast_string_to_uint64(std::string_view str) {
     uint64_t result = 0;
-    const char* ptr = str.c_str();
     
     // Manual parsing for maximum speed
-    while (*ptr && std::isdigit(*ptr)) {
-        result = result * 10 + (*ptr - '0');
-        ++ptr;
+    for (char c : str) {
+        if (!std::isdigit(static_cast<unsigned char>(c))) {
+            break;
+        }
+        result = result * 10 + (c - '0');
     }
     
     return result;
@@ -111,23 +262,326 @@ uint64_t fast_string_to_uint64(const std::string& str) {
  * 
  * Similar to uint64_t version but for smaller values.
  */
-uint32_t fast_string_to_uint32(const std::string& str) {
-    if (str.empty()) {
-        return 0;
-    }
-    
+uint32_t fast_string_to_uint32(std::string_view str) {
     uint32_t result = 0;
-    const char* ptr = str.c_str();
     
     // Manual parsing for maximum speed
-    while (*ptr && std::isdigit(*ptr)) {
-        result = result * 10 + (*ptr - '0');
-        ++ptr;
+    for (char c : str) {
+        if (!std::isdigit(static_cast<unsigned char>(c))) {
+            break;
+        }
+        result = result * 10 + (c - '0');
     }
     
     return result;
 }
 
+namespace {
+
+/**
+ * @brief Days since 1970-01-01 for a proleptic Gregorian date
+ * (H. Hinnant's days_from_civil)
+ */
+int64_t days_from_civil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned year_of_era = static_cast<unsigned>(year - era * 400);
+    const unsigned day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<int64_t>(day_of_era) - 719468;
+}
+
+/**
+ * @brief Inverse of days_from_civil
+ */
+void civil_from_days(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned day_of_era = static_cast<unsigned>(days - era * 146097);
+    const unsigned year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const unsigned day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const unsigned mp = (5 * day_of_year + 2) / 153;
+    day = day_of_year - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int64_t>(year_of_era) + era * 400 + (month <= 2);
+}
+
+/**
+ * @brief Days in a month of the proleptic Gregorian calendar
+ * Branch-free; any month value indexes the table safely, callers reject
+ * months outside 1-12 themselves
+ */
+inline uint32_t days_in_month(uint32_t year, uint32_t month) {
+    static constexpr uint8_t DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    uint32_t leap_year = (year % 4 == 0) & ((year % 100 != 0) | (year % 400 == 0));
+    return DAYS[(month - 1) % 12] + (leap_year & (month == 2));
+}
+
+/**
+ * @brief Parse exactly count digits starting at ptr, -1 if any is not a digit
+ */
+int64_t parse_fixed_digits(const char* ptr, int count) {
+    int64_t value = 0;
+    for (int i = 0; i < count; ++i) {
+        unsigned digit = static_cast<unsigned>(ptr[i] - '0');
+        if (digit >= 10) {
+            return -1;
+        }
+        value = value * 10 + digit;
+    }
+    return value;
+}
+
+/**
+ * @brief Parse the canonical 30-byte layout without data-dependent branches
+ * 
+ * Every digit is converted unconditionally and all checks (separators,
+ * digit ranges, field ranges) are OR-ed into a single error flag that is
+ * only looked at once, at the end. The 9 fraction digits go through the
+ * same SWAR step as prices.
+ */
+int64_t parse_timestamp_fixed(const char* ptr) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(ptr);
+    auto digit = [bytes](size_t i) { return static_cast<uint32_t>(bytes[i]) - '0'; };
+    
+    uint32_t invalid = 0;
+    invalid |= (bytes[4] ^ '-') | (bytes[7] ^ '-') | (bytes[10] ^ 'T') |
+               (bytes[13] ^ ':') | (bytes[16] ^ ':') | (bytes[19] ^ '.') | (bytes[29] ^ 'Z');
+    
+    // Non-digits wrap around to values above 9
+    static constexpr uint8_t DIGIT_POSITIONS[] = {0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18, 28};
+    for (uint8_t pos : DIGIT_POSITIONS) {
+        invalid |= digit(pos) > 9;
+    }
+    
+    uint64_t fraction_chunk;
+    std::memcpy(&fraction_chunk, ptr + 20, sizeof(fraction_chunk));
+    invalid |= !is_eight_digits(fraction_chunk);
+    
+    uint32_t year = digit(0) * 1000 + digit(1) * 100 + digit(2) * 10 + digit(3);
+    uint32_t month = digit(5) * 10 + digit(6);
+    uint32_t day = digit(8) * 10 + digit(9);
+    uint32_t hour = digit(11) * 10 + digit(12);
+    uint32_t minute = digit(14) * 10 + digit(15);
+    uint32_t second = digit(17) * 10 + digit(18);
+    
+    // Unsigned wrap-around turns each range check into one compare
+    invalid |= (month - 1 > 11) | (day - 1 >= days_in_month(year, month)) |
+               (hour > 23) | (minute > 59) | (second > 60);
+    
+    int64_t nanos = static_cast<int64_t>(parse_eight_digits(fraction_chunk)) * 10 + digit(28);
+    int64_t days = days_from_civil(year, month, day);
+    int64_t value = (days * 86400 + hour * 3600 + minute * 60 + second) * 1000000000LL + nanos;
+    
+    return invalid ? 0 : value;
+}
+
+/**
+ * @brief Parse any accepted layout (fraction of 0-9 digits)
+ */
+int64_t parse_timestamp_general(std::string_view str) {
+    // Shortest accepted form: "YYYY-MM-DDTHH:MM:SSZ"
+    if (str.size() < 20 || str[4] != '-' || str[7] != '-' || str[10] != 'T' ||
+        str[13] != ':' || str[16] != ':' || str.back() != 'Z') {
+        return 0;
+    }
+    
+    const char* ptr = str.data();
+    int64_t year = parse_fixed_digits(ptr, 4);
+    int64_t month = parse_fixed_digits(ptr + 5, 2);
+    int64_t day = parse_fixed_digits(ptr + 8, 2);
+    int64_t hour = parse_fixed_digits(ptr + 11, 2);
+    int64_t minute = parse_fixed_digits(ptr + 14, 2);
+    int64_t second = parse_fixed_digits(ptr + 17, 2);
+    
+    if (year < 0 || month < 1 || month > 12 || hour < 0 || hour > 23 ||
+        minute < 0 || minute > 59 || second < 0 || second > 60) {
+        return 0;
+    }
+    if (day < 1 || day > days_in_month(static_cast<uint32_t>(year), static_cast<uint32_t>(month))) {
+        return 0;
+    }
+    
+    // Optional fraction between the seconds and the 'Z'
+    int64_t nanos = 0;
+    size_t fraction_length = str.size() - 20;
+    if (fraction_length > 0) {
+        if (str[19] != '.' || fraction_length > 10) {
+            return 0;
+        }
+        // A '.' must be followed by at least one digit
+        int digits = static_cast<int>(fraction_length - 1);
+        nanos = digits > 0 ? parse_fixed_digits(ptr + 20, digits) : -1;
+        if (nanos < 0) {
+            return 0;
+        }
+        for (int i = digits; i < 9; ++i) {
+            nanos *= 10;
+        }
+    }
+    
+    int64_t days = days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    int64_t seconds = days * 86400 + hour * 3600 + minute * 60 + second;
+    return seconds * 1000000000LL + nanos;
+}
+
+// "00" "01" ... "99", so two digits are emitted with one 2-byte copy
+constexpr char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+inline char* write_two_digits(char* out, uint32_t value) {
+    std::memcpy(out, DIGIT_PAIRS + value * 2, 2);
+    return out + 2;
+}
+
+} // namespace
+
+/**
+ * @brief Parse an ISO-8601 UTC timestamp into epoch nanoseconds
+ */
+int64_t parse_timestamp_ns(std::string_view str) {
+    // The SWAR fraction step assumes a little-endian load
+    if (is_little_endian() && str.size() == TIMESTAMP_LENGTH) {
+        return parse_timestamp_fixed(str.data());
+    }
+    return parse_timestamp_general(str);
+}
+
+/**
+ * @brief Write epoch nanoseconds as "YYYY-MM-DDTHH:MM:SS.fffffffffZ"
+ * 
+ * Table-driven: every 2-digit group is a single lookup in DIGIT_PAIRS.
+ */
+size_t write_timestamp_ns(int64_t timestamp_ns, char* output) {
+    int64_t seconds = timestamp_ns / 1000000000LL;
+    int64_t nanos = timestamp_ns % 1000000000LL;
+    if (nanos < 0) {
+        nanos += 1000000000LL;
+        seconds -= 1;
+    }
+    
+    int64_t days = seconds / 86400;
+    int64_t second_of_day = seconds % 86400;
+    if (second_of_day < 0) {
+        second_of_day += 86400;
+        days -= 1;
+    }
+    
+    int64_t year;
+    unsigned month;
+    unsigned day;
+    civil_from_days(days, year, month, day);
+    
+    uint32_t year_digits = static_cast<uint32_t>(((year % 10000) + 10000) % 10000);
+    uint32_t time_of_day = static_cast<uint32_t>(second_of_day);
+    uint32_t fraction = static_cast<uint32_t>(nanos);
+    
+    char* out = output;
+    out = write_two_digits(out, year_digits / 100);
+    out = write_two_digits(out, year_digits % 100);
+    *out++ = '-';
+    out = write_two_digits(out, month);
+    *out++ = '-';
+    out = write_two_digits(out, day);
+    *out++ = 'T';
+    out = write_two_digits(out, time_of_day / 3600);
+    *out++ = ':';
+    out = write_two_digits(out, time_of_day / 60 % 60);
+    *out++ = ':';
+    out = write_two_digits(out, time_of_day % 60);
+    *out++ = '.';
+    out = write_two_digits(out, fraction / 10000000);
+    out = write_two_digits(out, fraction / 100000 % 100);
+    out = write_two_digits(out, fraction / 1000 % 100);
+    out = write_two_digits(out, fraction / 10 % 100);
+    *out++ = static_cast<char>('0' + fraction % 10);
+    *out++ = 'Z';
+    
+    return TIMESTAMP_LENGTH;
+}
+
+/**
+ * @brief Format epoch nanoseconds as a timestamp string
+ */
+std::string format_timestamp_ns(int64_t timestamp_ns) {
+    char buffer[TIMESTAMP_LENGTH];
+    return std::string(buffer, write_timestamp_ns(timestamp_ns, buffer));
+}
+
+/**
+ * @brief Write an unsigned integer in decimal
+ * 
+ * Digits are produced two at a time from DIGIT_PAIRS, right to left into
+ * a scratch buffer, then copied out in one go.
+ */
+char* write_uint64(uint64_t value, char* output) {
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    
+    while (value >= 100) {
+        start -= 2;
+        write_two_digits(start, static_cast<uint32_t>(value % 100));
+        value /= 100;
+    }
+    
+    if (value >= 10) {
+        start -= 2;
+        write_two_digits(start, static_cast<uint32_t>(value));
+    } else {
+        *--start = static_cast<char>('0' + value);
+    }
+    
+    size_t length = static_cast<size_t>(end - start);
+    std::memcpy(output, start, length);
+    return output + length;
+}
+
+/**
+ * @brief Write a signed integer in decimal
+ */
+char* write_int64(int64_t value, char* output) {
+    if (value < 0) {
+        *output++ = '-';
+        // Negate in unsigned arithmetic so INT64_MIN does not overflow
+        return write_uint64(0 - static_cast<uint64_t>(value), output);
+    }
+    return write_uint64(static_cast<uint64_t>(value), output);
+}
+
+/**
+ * @brief Write a fixed-point price with trailing fraction zeros removed
+ */
+char* write_price_scaled(uint64_t price_scaled, char* output) {
+    output = write_uint64(price_scaled / PRICE_SCALE, output);
+    
+    uint32_t fraction = static_cast<uint32_t>(price_scaled % PRICE_SCALE);
+    if (fraction == 0) {
+        return output;
+    }
+    
+    // All PRICE_DECIMALS digits, then drop the trailing zeros
+    char digits[PRICE_DECIMALS];
+    digits[0] = static_cast<char>('0' + fraction / 100000000);
+    write_two_digits(digits + 1, fraction / 1000000 % 100);
+    write_two_digits(digits + 3, fraction / 10000 % 100);
+    write_two_digits(digits + 5, fraction / 100 % 100);
+    write_two_digits(digits + 7, fraction % 100);
+    
+    size_t length = PRICE_DECIMALS;
+    while (digits[length - 1] == '0') {
+        length--;
+    }
+    
+    *output++ = '.';
+    std::memcpy(output, digits, length);
+    return output + length;
+}
+
 /**
  * @brief Format double to string with specified precision
  * 
@@ -178,6 +632,26 @@ void trim_string(std::string& str) {
               str.end());
 }
 
+/**
+ * @brief Trim whitespace from both ends of a string view
+ * 
+ * Used by the zero-copy reader, where fields are views into the
+ * mapped file and must not be modified.
+ */
+std::string_view trim_view(std::string_view str) {
+    size_t start = 0;
+    size_t end = str.size();
+    
+    while (start < end && std::isspace(static_cast<unsigned char>(str[start]))) {
+        ++start;
+    }
+    while (end > start && std::isspace(static_cast<unsigned char>(str[end - 1]))) {
+        --end;
+    }
+    
+    return str.substr(start, end - start);
+}
+
 // Timer class implementation
 Timer::Timer(const std::string& name) : timer_name(name) {
     start_time = std::chrono::high_resolution_clock::now();
@@ -274,7 +748,9 @@ void Statistics::print() const {
     std::cout << "Total orders processed: " << total_orders_processed << std::endl;
     std::cout << "  - Additions: " << total_additions_processed << std::endl;
     std::cout << "  - Cancellations: " << total_cancellations_processed << std::endl;
-    std::cout << "  - Trades: " << total_trades_processed << std::endl;
+    std::cout << "  - Modifications: " << total_modifications_processed << std::endl;
+    std::cout << "  - Trades: " << total_trades_processed << " (" << trades_fused
+              << " fused with their fill and cancel)" << std::endl;
     std::cout << "MBP updates generated: " << mbp_updates_generated << std::endl;
     std::cout << "Total processing time: " << std::fixed << std::setprecision(3) 
               << total_processing_time_ms << " ms" << std::endl;
@@ -297,8 +773,10 @@ void Statistics::print() const {
 void Statistics::reset() {
     total_orders_processed = 0;
     total_trades_processed = 0;
+    trades_fused = 0;
     total_cancellations_processed = 0;
     total_additions_processed = 0;
+    total_modifications_processed = 0;
     mbp_updates_generated = 0;
     total_processing_time_ms = 0.0;
 }
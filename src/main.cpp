@@ -1,10 +1,19 @@
 #include "CsvReader.hpp"
+#include "MappedCsvReader.hpp"
 #include "CsvWriter.hpp"
+#include "MbpDeltaReader.hpp"
+#include "BinaryMbpReader.hpp"
+#include "BinaryMboReader.hpp"
+#include "BookManager.hpp"
 #include "OrderBook.hpp"
+#include "Reconstruction.hpp"
 #include "Utils.hpp"
 #include <iostream>
+#include <iomanip>
 #include <string>
+#include <vector>
 #include <memory>
+#include <exception>
 
 /**
  * @file main.cpp
@@ -19,19 +28,82 @@
  * 3. Places T actions on the side that actually changes in the book
  * 4. Ignores T actions with side 'N'
  * 
- * Usage: ./reconstruction_<name> input.csv [output.csv]
+ * Usage: ./reconstruction_<name> input.csv [output.csv] [options]
  */
 
+// Input events between --checkpoint snapshots unless --checkpoint-every is given
+constexpr size_t DEFAULT_CHECKPOINT_INTERVAL = 1000000;
+
+/**
+ * @brief Command line options controlling how reconstruction runs
+ */
+struct ReconstructionOptions {
+    bool use_mapped_reader = false;     // --mmap: zero-copy memory-mapped reader
+    size_t parse_threads = 1;           // --threads=N: parallel chunked parsing (0 = all cores)
+    bool streaming = false;             // --stream: never hold more than one chunk of orders
+    bool compact_orders = false;        // --compact: hold parsed orders as 64-byte CompactOrder records
+    LadderType ladder = DEFAULT_LADDER; // --ladder=map|array: price level container
+    MbpOutputMode output_mode = MbpOutputMode::FULL;   // --output=full|delta|binary: row layout
+    bool expand_deltas = false;         // --expand-deltas: input is delta output, write full rows
+    bool expand_binary = false;         // --expand-binary: input is binary output, write full rows
+    bool convert_mbo = false;           // --convert-mbo: write the input CSV as binary MBO records
+    bool async_writer = false;          // --async-write: format and write rows on a writer thread
+    bool pipeline = false;              // --pipeline: reader, book and writer stages on their own threads
+    bool per_instrument_books = false;  // --books=N: one book per instrument_id, sharded over N threads
+    size_t book_shards = 0;             // Shard threads for --books (0 = all cores)
+    std::string checkpoint_filename;    // --checkpoint=FILE: periodic order book snapshot
+    size_t checkpoint_interval = DEFAULT_CHECKPOINT_INTERVAL;  // --checkpoint-every=N: events between snapshots
+    std::string resume_filename;        // --resume=FILE: restore a snapshot and skip the events it covers
+    int book_depth = Utils::MAX_DEPTH;  // --depth=1|10|50: levels per side in each output row
+    int64_t conflate_interval_ns = 0;   // --conflate=INTERVAL: at most one row per time bucket (0 = off)
+    bool conflate_on_recv = false;      // --conflate-clock=event|recv: timestamp that picks the bucket
+};
+
+// Smaller batches for --stream, so the batch stays cache resident
+constexpr size_t STREAM_CHUNK_SIZE = 256;
+
+// Orders per chunk routed by --books; keeps the per-shard row buffers small
+constexpr size_t BOOK_CHUNK_SIZE = 2048;
+
 /**
  * @brief Print usage information
  */
 void print_usage(const std::string& program_name) {
-    std::cout << "Usage: " << program_name << " <input_mbo.csv> [output_mbp.csv]" << std::endl;
+    std::cout << "Usage: " << program_name << " <input_mbo.csv> [output_mbp.csv] [options]" << std::endl;
+    std::cout << "       " << program_name << " --expand-deltas <input_delta.csv> [output_mbp.csv]" << std::endl;
+    std::cout << "       " << program_name << " --expand-binary <input_mbp.bin> [output_mbp.csv]" << std::endl;
+    std::cout << "       " << program_name << " --convert-mbo <input_mbo.csv> [output_mbo.bin]" << std::endl;
     std::cout << std::endl;
     std::cout << "Arguments:" << std::endl;
-    std::cout << "  input_mbo.csv   : Input MBO CSV file to process" << std::endl;
+    std::cout << "  input_mbo.csv   : Input MBO CSV file (or binary MBO file, detected by its header) to process" << std::endl;
     std::cout << "  output_mbp.csv  : Output MBP-10 CSV file (optional, defaults to 'output_mbp.csv')" << std::endl;
     std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --mmap          : Parse input through the zero-copy memory-mapped reader" << std::endl;
+    std::cout << "  --threads=N     : Parse input on N threads, results applied in file order (0 = all cores)" << std::endl;
+    std::cout << "  --stream        : Stream orders into the book in small batches (constant memory)" << std::endl;
+    std::cout << "  --compact       : Keep parsed orders as compact fixed-size records (in-memory parsing only)" << std::endl;
+    std::cout << "  --ladder=TYPE   : Price ladder, 'map' (std::map) or 'array' (tick-indexed) (default: "
+              << ladder_type_name(DEFAULT_LADDER) << ")" << std::endl;
+    std::cout << "  --output=MODE   : 'full' MBP-10 rows, 'delta' rows with changed levels only, or 'binary'" << std::endl;
+    std::cout << "                    fixed-width columns (default: full)" << std::endl;
+    std::cout << "  --expand-deltas : Expand a delta output file back into full MBP-10 rows" << std::endl;
+    std::cout << "  --expand-binary : Convert a binary output file back into full MBP-10 rows" << std::endl;
+    std::cout << "  --convert-mbo   : Convert an MBO CSV file into binary MBO records for faster re-runs" << std::endl;
+    std::cout << "  --async-write   : Format and write output on a separate writer thread" << std::endl;
+    std::cout << "  --pipeline      : Run parsing, book updates and output writing as three threaded stages" << std::endl;
+    std::cout << "  --books=N       : Keep one book per instrument_id, sharded over N threads (0 = all cores)" << std::endl;
+    std::cout << "  --checkpoint=FILE    : Snapshot the order book to FILE every --checkpoint-every events" << std::endl;
+    std::cout << "  --checkpoint-every=N : Events between snapshots (default: " << DEFAULT_CHECKPOINT_INTERVAL << ")" << std::endl;
+    std::cout << "  --resume=FILE   : Restore a snapshot and only output rows for the events after it" << std::endl;
+    std::cout << "                    (indexed from where the checkpointed run stopped)" << std::endl;
+    std::cout << "  --depth=N       : Levels per side in each row: 1, 10 or 50 (default: "
+              << Utils::MAX_DEPTH << ")" << std::endl;
+    std::cout << "                    1 is the BBO fast path: a row only when the best bid or ask changes" << std::endl;
+    std::cout << "  --conflate=T    : At most one row per T-long time bucket, the book state at its end" << std::endl;
+    std::cout << "                    (T like 100ms, 250us, 1s, 500ns; a bare number is milliseconds)" << std::endl;
+    std::cout << "  --conflate-clock=CLOCK : Bucket by 'event' (ts_event) or 'recv' (ts_recv) time (default: event)" << std::endl;
+    std::cout << std::endl;
     std::cout << "This program reconstructs MBP-10 data from MBO data with the following rules:" << std::endl;
     std::cout << "- Ignores initial 'R' (clear) actions" << std::endl;
     std::cout << "- Combines T->F->C sequences into single T actions" << std::endl;
@@ -58,20 +130,66 @@ void print_header() {
 }
 
 /**
- * @brief Process MBO file and generate MBP-10 output
+ * @brief Parse a conflation interval such as "100ms", "250us", "1s" or "500ns"
+ * A bare number is taken as milliseconds
+ * 
+ * @return false if the value is not a positive duration
+ */
+bool parse_interval_ns(const std::string& value, int64_t& interval_ns) {
+    size_t digits_end = value.find_first_not_of("0123456789");
+    std::string digits = value.substr(0, digits_end);
+    std::string unit = digits_end == std::string::npos ? "ms" : value.substr(digits_end);
+    if (digits.empty() || digits.size() > 12) {
+        return false;
+    }
+    
+    int64_t scale;
+    if (unit == "ns") {
+        scale = 1;
+    } else if (unit == "us") {
+        scale = 1000;
+    } else if (unit == "ms") {
+        scale = 1000000;
+    } else if (unit == "s") {
+        scale = 1000000000;
+    } else {
+        return false;
+    }
+    
+    interval_ns = static_cast<int64_t>(Utils::fast_string_to_uint64(digits)) * scale;
+    return interval_ns > 0;
+}
+
+/**
+ * @brief Order count for progress output, estimated from the input size for CSV
+ */
+size_t estimate_order_count(const CsvReader* csv_reader, const MappedCsvReader* mapped_reader,
+                            const BinaryMboReader* binary_reader) {
+    if (binary_reader) {
+        return binary_reader->get_record_count();
+    }
+    return mapped_reader ? mapped_reader->get_file_size() / 175 : csv_reader->estimate_order_count();
+}
+
+/**
+ * @brief Process MBO file and generate MBP output
  * 
  * This is the main processing function that coordinates reading MBO data,
- * processing it through the order book, and writing MBP-10 output.
+ * processing it through the order book, and writing MBP output.
  * 
+ * @tparam Depth Levels per side in each output row (options.book_depth)
  * @param input_filename Path to input MBO CSV file
- * @param output_filename Path to output MBP-10 CSV file
+ * @param output_filename Path to output MBP CSV file
+ * @param options Reader/processing options from the command line
  * @return 0 on success, non-zero on error
  */
-int process_reconstruction(const std::string& input_filename, const std::string& output_filename) {
+template <int Depth>
+int process_reconstruction(const std::string& input_filename, const std::string& output_filename,
+                           const ReconstructionOptions& options) {
     // Overall processing timer
     Utils::Timer total_timer("Total Processing");
     
-    std::cout << "Starting MBP-10 reconstruction..." << std::endl;
+    std::cout << "Starting MBP-" << Depth << " reconstruction..." << std::endl;
     std::cout << "Input file: " << input_filename << std::endl;
     std::cout << "Output file: " << output_filename << std::endl;
     std::cout << std::endl;
@@ -81,9 +199,23 @@ int process_reconstruction(const std::string& input_filename, const std::string&
     
     // Step 1: Initialize CSV reader
     std::cout << "=== Step 1: Initializing CSV Reader ===" << std::endl;
-    auto csv_reader = std::make_unique<CsvReader>(input_filename);
+    std::unique_ptr<CsvReader> csv_reader;
+    std::unique_ptr<MappedCsvReader> mapped_reader;
+    std::unique_ptr<BinaryMboReader> binary_reader;
     
-    if (!csv_reader->is_open()) {
+    if (BinaryMboReader::is_binary_mbo_file(input_filename)) {
+        std::cout << "Input is a binary MBO record file" << std::endl;
+        binary_reader = std::make_unique<BinaryMboReader>(input_filename);
+    } else if (options.use_mapped_reader) {
+        mapped_reader = std::make_unique<MappedCsvReader>(input_filename);
+    } else {
+        csv_reader = std::make_unique<CsvReader>(input_filename);
+    }
+    
+    bool reader_open = binary_reader ? binary_reader->is_open()
+                     : mapped_reader ? mapped_reader->is_open()
+                                     : csv_reader->is_open();
+    if (!reader_open) {
         std::cerr << "Error: Failed to open input file: " << input_filename << std::endl;
         return 1;
     }
@@ -92,13 +224,29 @@ int process_reconstruction(const std::string& input_filename, const std::string&
     
     // Step 2: Initialize order book
     std::cout << "\n=== Step 2: Initializing Order Book ===" << std::endl;
-    auto order_book = std::make_unique<OrderBook>();
+    std::unique_ptr<BasicOrderBook<Depth>> order_book;
+    if (options.per_instrument_books) {
+        std::cout << "Books are created per instrument as events arrive" << std::endl;
+    } else {
+        order_book = std::make_unique<BasicOrderBook<Depth>>(options.ladder);
+    }
+    
+    uint64_t resume_position = 0;
+    uint64_t resume_rows = 0;
+    if (!options.resume_filename.empty()) {
+        Utils::Timer restore_timer("Checkpoint Restore");
+        if (!order_book->load_snapshot(options.resume_filename, resume_position, resume_rows)) {
+            std::cerr << "Error: Failed to restore checkpoint: " << options.resume_filename << std::endl;
+            return 1;
+        }
+        std::cout << "Resuming after input event " << resume_position << ", output row " << resume_rows << std::endl;
+    }
     
     Utils::MemoryTracker::print_memory_usage("After order book initialization");
     
     // Step 3: Initialize CSV writer
     std::cout << "\n=== Step 3: Initializing CSV Writer ===" << std::endl;
-    auto csv_writer = std::make_unique<CsvWriter>(output_filename);
+    auto csv_writer = std::make_unique<BasicCsvWriter<Depth>>(output_filename, options.output_mode);
     
     if (!csv_writer->is_open()) {
         std::cerr << "Error: Failed to create output file: " << output_filename << std::endl;
@@ -111,87 +259,242 @@ int process_reconstruction(const std::string& input_filename, const std::string&
         return 1;
     }
     
-    // Step 4: Parse input file
-    std::cout << "\n=== Step 4: Parsing Input File ===" << std::endl;
-    auto parse_result = csv_reader->parse_all_orders();
+    // Resumed rows carry on the index column of the run that wrote the checkpoint
+    csv_writer->set_next_row_index(resume_rows);
     
-    if (!parse_result.is_successful()) {
-        std::cerr << "Error: Failed to parse input file successfully" << std::endl;
-        std::cerr << "Success rate: " << parse_result.get_success_rate() << "%" << std::endl;
+    if (options.async_writer && !csv_writer->start_async()) {
+        std::cerr << "Error: Failed to start the async writer thread" << std::endl;
         return 1;
     }
     
-    Utils::MemoryTracker::print_memory_usage("After parsing input file");
-    
-    // Step 5: Process orders through order book
-    std::cout << "\n=== Step 5: Processing Orders Through Order Book ===" << std::endl;
-    
-    size_t total_orders = parse_result.orders.size();
-    size_t processed_orders = 0;
-    size_t mbp_updates = 0;
-    bool first_clear_ignored = false;
-    
-    Utils::Timer processing_timer("Order Processing");
+    ReconstructionProgress progress;
+    progress.resume_position = resume_position;
+    progress.resume_rows = resume_rows;
+    progress.first_clear_ignored = resume_position != 0;
+    progress.conflate_interval_ns = options.conflate_interval_ns;
+    progress.conflate_on_recv = options.conflate_on_recv;
+    if (!options.checkpoint_filename.empty()) {
+        progress.checkpoint_filename = options.checkpoint_filename;
+        progress.checkpoint_interval = options.checkpoint_interval;
+        progress.next_checkpoint = resume_position + options.checkpoint_interval;
+    }
+    std::unique_ptr<BookManager> book_manager;
     
-    for (const auto& order : parse_result.orders) {
-        // Special handling for first 'R' action as per requirements
-        if (!first_clear_ignored && order.action == Utils::ACTION_CLEAR) {
-            std::cout << "Ignoring initial clear action (R) as per requirements" << std::endl;
-            first_clear_ignored = true;
-            processed_orders++;
-            continue;
+    if (options.per_instrument_books) {
+        // BookManager keeps MBP-10 books; main() rejects --books with any other depth
+        if constexpr (Depth == Utils::MAX_DEPTH) {
+            // Steps 4+5: route each chunk to per-instrument books on the shard threads;
+            // rows come back merged in input order
+            std::cout << "\n=== Step 4+5: Routing Orders to Per-Instrument Books ===" << std::endl;
+            
+            book_manager = std::make_unique<BookManager>(options.book_shards, options.ladder, *csv_writer);
+            bool write_failed = false;
+            
+            Utils::Timer processing_timer("Order Processing");
+            
+            auto process_chunk = [&](const std::vector<Order>& chunk) {
+                if (!write_failed && !book_manager->process_orders(chunk)) {
+                    write_failed = true;
+                }
+                progress.processed_orders += chunk.size();
+            };
+            
+            CsvReader::ParseResult parse_result = parse_chunks(csv_reader.get(), mapped_reader.get(), binary_reader.get(), BOOK_CHUNK_SIZE,
+                                                               options.parse_threads, process_chunk);
+            
+            if (!book_manager->finish() || write_failed) {
+                return 1;
+            }
+            progress.mbp_updates = book_manager->get_mbp_updates();
+            
+            if (!parse_result.is_successful()) {
+                std::cerr << "Error: Failed to parse input file successfully" << std::endl;
+                std::cerr << "Success rate: " << parse_result.get_success_rate() << "%" << std::endl;
+                return 1;
+            }
+            
+            std::cout << "\nParsing completed:" << std::endl;
+            parse_result.print_summary();
+            
+            processing_timer.print_elapsed();
         }
+    } else if (options.pipeline) {
+        // Steps 4+5 as concurrent stages: reader thread -> book (this thread) -> writer thread
+        std::cout << "\n=== Step 4+5: Pipelined Parse / Book / Write ===" << std::endl;
         
-        // Process order through order book
-        const OrderBook::MBPRow* mbp_row = order_book->process_order(order);
+        progress.total_orders = estimate_order_count(csv_reader.get(), mapped_reader.get(), binary_reader.get());
         
-        // If we got an MBP update, write it to output
-        if (mbp_row != nullptr) {
-            if (!csv_writer->write_mbp_row(*mbp_row)) {
-                std::cerr << "Error: Failed to write MBP row to output" << std::endl;
-                return 1;
+        Utils::Timer processing_timer("Order Processing");
+        
+        CsvReader::ParseResult parse_result;
+        if (!run_pipeline(csv_reader.get(), mapped_reader.get(), binary_reader.get(), options.parse_threads,
+                          *order_book, *csv_writer, progress, parse_result)) {
+            return 1;
+        }
+        
+        if (!parse_result.is_successful()) {
+            std::cerr << "Error: Failed to parse input file successfully" << std::endl;
+            std::cerr << "Success rate: " << parse_result.get_success_rate() << "%" << std::endl;
+            return 1;
+        }
+        
+        std::cout << "\nParsing completed:" << std::endl;
+        parse_result.print_summary();
+        
+        processing_timer.print_elapsed();
+    } else if (options.streaming || options.parse_threads != 1) {
+        // Steps 4+5: parse in chunks (optionally on worker threads) and apply each
+        // chunk in file order as it arrives; the full order list never exists
+        std::cout << "\n=== Step 4+5: Streaming Orders Through Order Book ===" << std::endl;
+        
+        progress.total_orders = estimate_order_count(csv_reader.get(), mapped_reader.get(), binary_reader.get());
+        size_t chunk_size = options.parse_threads != 1 ? PARSE_CHUNK_SIZE : STREAM_CHUNK_SIZE;
+        bool write_failed = false;
+        
+        Utils::Timer processing_timer("Order Processing");
+        
+        auto process_chunk = [&](const std::vector<Order>& chunk) {
+            for (const auto& order : chunk) {
+                if (write_failed || !apply_order(order, *order_book, *csv_writer, progress)) {
+                    write_failed = true;
+                    return;
+                }
             }
-            mbp_updates++;
+        };
+        
+        CsvReader::ParseResult parse_result = parse_chunks(csv_reader.get(), mapped_reader.get(), binary_reader.get(), chunk_size,
+                                                           options.parse_threads, process_chunk);
+        
+        if (write_failed) {
+            return 1;
         }
         
-        processed_orders++;
+        if (!parse_result.is_successful()) {
+            std::cerr << "Error: Failed to parse input file successfully" << std::endl;
+            std::cerr << "Success rate: " << parse_result.get_success_rate() << "%" << std::endl;
+            return 1;
+        }
+        
+        std::cout << "\nParsing completed:" << std::endl;
+        parse_result.print_summary();
+        
+        Utils::MemoryTracker::print_memory_usage("After streaming input file");
+        
+        processing_timer.print_elapsed();
+    } else {
+        // Step 4: Parse input file
+        std::cout << "\n=== Step 4: Parsing Input File ===" << std::endl;
+        auto parse_result = binary_reader ? binary_reader->parse_all_orders()
+                          : mapped_reader ? mapped_reader->parse_all_orders()
+                                          : csv_reader->parse_all_orders();
+        
+        if (!parse_result.is_successful()) {
+            std::cerr << "Error: Failed to parse input file successfully" << std::endl;
+            std::cerr << "Success rate: " << parse_result.get_success_rate() << "%" << std::endl;
+            return 1;
+        }
+        
+        Utils::MemoryTracker::print_memory_usage("After parsing input file");
+        
+        // Step 5: Process orders through order book
+        std::cout << "\n=== Step 5: Processing Orders Through Order Book ===" << std::endl;
+        
+        progress.total_orders = parse_result.orders.size();
+        
+        // Convert once, then drop the full orders; an order whose metadata
+        // does not fit the compact widths sends the run down the full path
+        std::vector<CompactOrder> compact_orders;
+        if (options.compact_orders) {
+            compact_orders.reserve(parse_result.orders.size());
+            CompactOrder compact;
+            for (size_t i = 0; i < parse_result.orders.size(); ++i) {
+                if (!CompactOrder::from_order(parse_result.orders[i], compact)) {
+                    std::cout << "Warning: Order " << i + 1 << " has a sequence, ts_in_delta or flags value too wide "
+                              << "for a compact record; processing full orders instead" << std::endl;
+                    std::vector<CompactOrder>().swap(compact_orders);
+                    break;
+                }
+                compact_orders.push_back(compact);
+            }
+        }
         
-        // Progress reporting
-        if (processed_orders % 50000 == 0) {
-            double progress = (static_cast<double>(processed_orders) / total_orders) * 100.0;
-            std::cout << "Progress: " << std::fixed << std::setprecision(1) << progress 
-                      << "% (" << processed_orders << "/" << total_orders << " orders, "
-                      << mbp_updates << " MBP updates)" << std::endl;
+        if (!compact_orders.empty()) {
+            std::vector<Order>().swap(parse_result.orders);
             
-            // Memory usage check
-            Utils::MemoryTracker::print_memory_usage("Current memory");
+            Utils::MemoryTracker::print_memory_usage("After compacting orders");
             
-            // Periodic flush
-            csv_writer->flush();
+            Utils::Timer processing_timer("Order Processing");
+            
+            for (const auto& order : compact_orders) {
+                if (!apply_order(order, *order_book, *csv_writer, progress)) {
+                    return 1;
+                }
+            }
+            
+            processing_timer.print_elapsed();
+        } else {
+            Utils::Timer processing_timer("Order Processing");
+            
+            for (const auto& order : parse_result.orders) {
+                if (!apply_order(order, *order_book, *csv_writer, progress)) {
+                    return 1;
+                }
+            }
+            
+            processing_timer.print_elapsed();
         }
     }
     
-    processing_timer.print_elapsed();
+    if (progress.processed_orders < progress.resume_position) {
+        std::cerr << "Error: Input ends after " << progress.processed_orders << " events, before the checkpoint position "
+                  << progress.resume_position << std::endl;
+        return 1;
+    }
+    
+    // The last bucket has no later event to close it
+    if (order_book && !write_conflated_row(*order_book, *csv_writer, progress)) {
+        return 1;
+    }
     
     // Step 6: Finalize output
     std::cout << "\n=== Step 6: Finalizing Output ===" << std::endl;
-    csv_writer->flush();
+    if (!csv_writer->flush()) {
+        std::cerr << "Error: Failed to write MBP output" << std::endl;
+        return 1;
+    }
+    
+    // A binary file is only readable once its last block and header totals are written
+    if (options.output_mode == MbpOutputMode::BINARY) {
+        csv_writer->close();
+        if (!csv_writer->get_write_result().success) {
+            std::cerr << "Error: Failed to complete binary MBP output" << std::endl;
+            return 1;
+        }
+    }
     
     // Final statistics
     std::cout << "\n=== Final Statistics ===" << std::endl;
-    std::cout << "Total orders processed: " << processed_orders << std::endl;
-    std::cout << "MBP updates generated: " << mbp_updates << std::endl;
+    std::cout << "Total orders processed: " << progress.processed_orders << std::endl;
+    std::cout << "MBP updates generated: " << progress.mbp_updates << std::endl;
     std::cout << "Update ratio: " << std::fixed << std::setprecision(2) 
-              << (static_cast<double>(mbp_updates) / processed_orders * 100.0) << "%" << std::endl;
+              << (static_cast<double>(progress.mbp_updates) / progress.processed_orders * 100.0) << "%" << std::endl;
+    if (progress.conflate_interval_ns != 0) {
+        std::cout << "Rows conflated away: " << progress.conflated_rows << " (" << progress.conflate_interval_ns
+                  << " ns buckets on " << (progress.conflate_on_recv ? "ts_recv" : "ts_event") << ")" << std::endl;
+    }
     
     // Order book statistics
-    auto [best_bid, best_ask] = order_book->get_spread();
-    auto [bid_levels, ask_levels] = order_book->get_level_counts();
-    
-    std::cout << "Final book state:" << std::endl;
-    std::cout << "  Best bid/ask: " << best_bid << " / " << best_ask << std::endl;
-    std::cout << "  Active levels: " << bid_levels << " bids, " << ask_levels << " asks" << std::endl;
-    std::cout << "  Total active orders: " << order_book->get_total_orders() << std::endl;
+    if (book_manager) {
+        book_manager->print_shard_statistics();
+    } else {
+        auto [best_bid, best_ask] = order_book->get_spread();
+        auto [bid_levels, ask_levels] = order_book->get_level_counts();
+        
+        std::cout << "Final book state:" << std::endl;
+        std::cout << "  Best bid/ask: " << best_bid << " / " << best_ask << std::endl;
+        std::cout << "  Active levels: " << bid_levels << " bids, " << ask_levels << " asks" << std::endl;
+        std::cout << "  Total active orders: " << order_book->get_total_orders() << std::endl;
+    }
     
     // Memory usage final check
     Utils::MemoryTracker::print_memory_usage("Final memory");
@@ -218,14 +521,151 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    std::string input_filename = argv[1];
+    // Separate positional arguments from --options
+    ReconstructionOptions options;
+    std::vector<std::string> positional_args;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        
+        if (arg == "--mmap") {
+            options.use_mapped_reader = true;
+        } else if (arg == "--stream") {
+            options.streaming = true;
+        } else if (arg == "--compact") {
+            options.compact_orders = true;
+        } else if (arg == "--pipeline") {
+            options.pipeline = true;
+        } else if (arg == "--async-write") {
+            options.async_writer = true;
+        } else if (arg == "--expand-deltas") {
+            options.expand_deltas = true;
+        } else if (arg == "--expand-binary") {
+            options.expand_binary = true;
+        } else if (arg == "--convert-mbo") {
+            options.convert_mbo = true;
+        } else if (arg.rfind("--output=", 0) == 0) {
+            std::string value = arg.substr(9);
+            if (value == "full") {
+                options.output_mode = MbpOutputMode::FULL;
+            } else if (value == "delta") {
+                options.output_mode = MbpOutputMode::DELTA;
+            } else if (value == "binary") {
+                options.output_mode = MbpOutputMode::BINARY;
+            } else {
+                std::cerr << "Error: Invalid output mode '" << value << "' (expected 'full', 'delta' or 'binary')" << std::endl;
+                return 1;
+            }
+        } else if (arg.rfind("--ladder=", 0) == 0) {
+            std::string value = arg.substr(9);
+            if (value == "map") {
+                options.ladder = LadderType::MAP;
+            } else if (value == "array") {
+                options.ladder = LadderType::ARRAY;
+            } else {
+                std::cerr << "Error: Invalid ladder type '" << value << "' (expected 'map' or 'array')" << std::endl;
+                return 1;
+            }
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            std::string value = arg.substr(10);
+            if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+                std::cerr << "Error: Invalid thread count '" << value << "'" << std::endl;
+                return 1;
+            }
+            options.parse_threads = static_cast<size_t>(Utils::fast_string_to_uint64(value));
+        } else if (arg.rfind("--books=", 0) == 0) {
+            std::string value = arg.substr(8);
+            if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+                std::cerr << "Error: Invalid book shard count '" << value << "'" << std::endl;
+                return 1;
+            }
+            options.per_instrument_books = true;
+            options.book_shards = static_cast<size_t>(Utils::fast_string_to_uint64(value));
+        } else if (arg.rfind("--checkpoint=", 0) == 0) {
+            options.checkpoint_filename = arg.substr(13);
+        } else if (arg.rfind("--checkpoint-every=", 0) == 0) {
+            std::string value = arg.substr(19);
+            if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos || value == "0") {
+                std::cerr << "Error: Invalid checkpoint interval '" << value << "'" << std::endl;
+                return 1;
+            }
+            options.checkpoint_interval = static_cast<size_t>(Utils::fast_string_to_uint64(value));
+        } else if (arg.rfind("--resume=", 0) == 0) {
+            options.resume_filename = arg.substr(9);
+        } else if (arg.rfind("--conflate=", 0) == 0) {
+            std::string value = arg.substr(11);
+            if (!parse_interval_ns(value, options.conflate_interval_ns)) {
+                std::cerr << "Error: Invalid conflation interval '" << value << "' (e.g. 100ms, 250us, 1s)" << std::endl;
+                return 1;
+            }
+        } else if (arg.rfind("--conflate-clock=", 0) == 0) {
+            std::string value = arg.substr(17);
+            if (value == "event") {
+                options.conflate_on_recv = false;
+            } else if (value == "recv") {
+                options.conflate_on_recv = true;
+            } else {
+                std::cerr << "Error: Invalid conflation clock '" << value << "' (expected 'event' or 'recv')" << std::endl;
+                return 1;
+            }
+        } else if (arg.rfind("--depth=", 0) == 0) {
+            std::string value = arg.substr(8);
+            if (value == "1" || value == "10" || value == "50") {
+                options.book_depth = static_cast<int>(Utils::fast_string_to_uint64(value));
+            } else {
+                std::cerr << "Error: Invalid book depth '" << value << "' (expected 1, 10 or 50)" << std::endl;
+                return 1;
+            }
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Error: Unknown option '" << arg << "'" << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            positional_args.push_back(arg);
+        }
+    }
+    
+    if (options.per_instrument_books && (!options.checkpoint_filename.empty() || !options.resume_filename.empty())) {
+        std::cerr << "Error: --checkpoint and --resume work with a single book, not --books" << std::endl;
+        return 1;
+    }
+    
+    // Compact records are built from the fully parsed order list; the
+    // chunked paths hand Order batches straight to the book(s)
+    if (options.compact_orders && (options.per_instrument_books || options.pipeline ||
+        options.streaming || options.parse_threads != 1)) {
+        std::cerr << "Error: --compact works with in-memory parsing, without --books, --pipeline, --stream or --threads" << std::endl;
+        return 1;
+    }
+    
+    // A checkpoint cannot carry the row held for the open bucket
+    if (options.conflate_interval_ns != 0 && (options.per_instrument_books ||
+        !options.checkpoint_filename.empty() || !options.resume_filename.empty())) {
+        std::cerr << "Error: --conflate works with a single book, without --books, --checkpoint or --resume" << std::endl;
+        return 1;
+    }
+    
+    // Per-instrument books, delta expansion and the binary layout are MBP-10 only
+    if (options.book_depth != Utils::MAX_DEPTH &&
+        (options.per_instrument_books || options.output_mode != MbpOutputMode::FULL)) {
+        std::cerr << "Error: --depth=" << options.book_depth << " supports --output=full only, without --books" << std::endl;
+        return 1;
+    }
+    
+    if (positional_args.empty()) {
+        std::cerr << "Error: Missing required input file argument" << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    std::string input_filename = positional_args[0];
     std::string output_filename;
     
-    if (argc >= 3) {
-        output_filename = argv[2];
+    if (positional_args.size() >= 2) {
+        output_filename = positional_args[1];
     } else {
         // Default output filename
-        output_filename = "output_mbp.csv";
+        output_filename = options.convert_mbo ? "output_mbo.bin" : "output_mbp.csv";
         std::cout << "Using default output filename: " << output_filename << std::endl;
     }
     
@@ -237,9 +677,50 @@ int main(int argc, char* argv[]) {
     }
     test_input.close();
     
+    if (options.expand_deltas) {
+        long long rows = MbpDeltaReader::expand_to_csv(input_filename, output_filename);
+        if (rows < 0) {
+            std::cerr << "Error: Failed to expand delta file: " << input_filename << std::endl;
+            return 1;
+        }
+        std::cout << "\nExpanded " << rows << " delta rows to: " << output_filename << std::endl;
+        return 0;
+    }
+    
+    if (options.expand_binary) {
+        long long rows = BinaryMbpReader::expand_to_csv(input_filename, output_filename);
+        if (rows < 0) {
+            std::cerr << "Error: Failed to expand binary file: " << input_filename << std::endl;
+            return 1;
+        }
+        std::cout << "\nExpanded " << rows << " binary rows to: " << output_filename << std::endl;
+        return 0;
+    }
+    
+    if (options.convert_mbo) {
+        long long records = BinaryMboWriter::convert_csv(input_filename, output_filename);
+        if (records < 0) {
+            std::cerr << "Error: Failed to convert MBO file: " << input_filename << std::endl;
+            return 1;
+        }
+        std::cout << "\nConverted " << records << " MBO records to: " << output_filename << std::endl;
+        return 0;
+    }
+    
     // Process the reconstruction
     try {
-        int result = process_reconstruction(input_filename, output_filename);
+        int result;
+        switch (options.book_depth) {
+            case 1:
+                result = process_reconstruction<1>(input_filename, output_filename, options);
+                break;
+            case 50:
+                result = process_reconstruction<50>(input_filename, output_filename, options);
+                break;
+            default:
+                result = process_reconstruction<Utils::MAX_DEPTH>(input_filename, output_filename, options);
+                break;
+        }
         
         if (result == 0) {
             std::cout << "\n🎉 SUCCESS: MBP-10 reconstruction completed!" << std::endl;
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "Order.hpp"
+#include "OrderBook.hpp"
+#include "CsvWriter.hpp"
+#include "SymbolTable.hpp"
+#include "Utils.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Shared fixtures: a deterministic MBO stream and the MBP rows it produces
+ */
+namespace TestData {
+    // 2025-07-17T08:00:00Z, the session the sample data comes from
+    constexpr int64_t START_TS = 1752739200000000000LL;
+    constexpr uint64_t BASE_PRICE = 100000000000ULL;   // 100.00
+    constexpr uint64_t TICK = 10000000ULL;             // 0.01
+    
+    /**
+     * @brief Append a trade at a resting order's price as the feed sends it
+     * 
+     * A side N trade is a lone T that leaves the book alone. Otherwise T on
+     * the aggressor side, then F and C on the resting order's side for the
+     * traded size, all with the trade's timestamps and sequence; the
+     * resting order shrinks or leaves.
+     */
+    inline void append_trade(std::vector<Order>& orders, Order& resting, uint32_t size, bool neutral,
+                             int64_t ts_event, uint64_t sequence) {
+        char aggressor = neutral ? Utils::SIDE_NEUTRAL : (resting.side == 'B' ? 'A' : 'B');
+        Order trade(0, resting.price_scaled, size, aggressor, Utils::ACTION_TRADE, ts_event + 150, ts_event,
+                    130, 165000, sequence, resting.symbol_id, resting.instrument_id, resting.publisher_id);
+        orders.push_back(trade);
+        if (neutral) {
+            return;
+        }
+        
+        Order fill = trade;
+        fill.order_id = resting.order_id;
+        fill.side = resting.side;
+        fill.action = Utils::ACTION_FILL;
+        orders.push_back(fill);
+        
+        Order cancel = fill;
+        cancel.action = Utils::ACTION_CANCEL;
+        orders.push_back(cancel);
+        
+        resting.size -= size;
+    }
+    
+    /**
+     * @brief Generate a random but reproducible stream of adds, cancels,
+     * modifies and T -> F -> C trades
+     * 
+     * Bids sit on 30 ticks from 100.00, asks on the 30 ticks above them, so
+     * both sides have more levels than the book reports and levels keep
+     * entering and leaving the top. About one step in ten is a trade, one
+     * trade in five on side N. The stream is cut at count events, so it
+     * may end inside a trade.
+     */
+    inline std::vector<Order> generate_orders(size_t count, uint64_t seed = 42) {
+        std::mt19937_64 rng(seed);
+        uint32_t symbol_id = SymbolTable::instance().intern("TEST");
+        
+        std::vector<Order> orders;
+        std::vector<Order> live;
+        orders.reserve(count + 2);
+        uint64_t next_order_id = 1000;
+        
+        for (size_t i = 0; orders.size() < count; ++i) {
+            int64_t ts_event = START_TS + static_cast<int64_t>(i) * 1000;
+            unsigned kind = static_cast<unsigned>(rng() % 100);
+            Order order;
+            
+            if (!live.empty() && kind >= 90) {
+                size_t victim = static_cast<size_t>(rng() % live.size());
+                uint32_t size = static_cast<uint32_t>(1 + rng() % live[victim].size);
+                append_trade(orders, live[victim], size, rng() % 5 == 0, ts_event, i + 1);
+                if (live[victim].size == 0) {
+                    live[victim] = live.back();
+                    live.pop_back();
+                }
+                continue;
+            }
+            
+            if (live.empty() || kind < 50) {
+                char side = rng() % 2 == 0 ? 'B' : 'A';
+                uint64_t tick = rng() % 30;
+                uint64_t price = side == 'B' ? BASE_PRICE + tick * TICK : BASE_PRICE + (30 + tick) * TICK;
+                order = Order(next_order_id++, price, static_cast<uint32_t>(1 + rng() % 500), side, 'A',
+                              ts_event + 150, ts_event, 130, 165000, i + 1, symbol_id, 1108, 2);
+                live.push_back(order);
+            } else {
+                size_t victim = static_cast<size_t>(rng() % live.size());
+                order = live[victim];
+                order.ts_event = ts_event;
+                order.ts_recv = ts_event + 150;
+                order.sequence = i + 1;
+                
+                if (kind < 80) {
+                    order.action = 'C';
+                    live[victim] = live.back();
+                    live.pop_back();
+                } else {
+                    // Modify: new size, and sometimes a new price on the same side
+                    order.action = 'M';
+                    order.size = static_cast<uint32_t>(1 + rng() % 500);
+                    if (rng() % 2 == 0) {
+                        uint64_t tick = rng() % 30;
+                        order.price_scaled = order.side == 'B' ? BASE_PRICE + tick * TICK
+                                                               : BASE_PRICE + (30 + tick) * TICK;
+                    }
+                    live[victim] = order;
+                }
+            }
+            
+            orders.push_back(order);
+        }
+        
+        orders.resize(count);
+        return orders;
+    }
+    
+    /**
+     * @brief Index of the first T -> F -> C trade (not side N) at or after from,
+     * orders.size() if there is none
+     */
+    inline size_t find_trade(const std::vector<Order>& orders, size_t from) {
+        for (size_t i = from; i + 2 < orders.size(); ++i) {
+            if (orders[i].action == Utils::ACTION_TRADE && orders[i].side != Utils::SIDE_NEUTRAL &&
+                orders[i + 1].action == Utils::ACTION_FILL && orders[i + 2].action == Utils::ACTION_CANCEL) {
+                return i;
+            }
+        }
+        return orders.size();
+    }
+    
+    /**
+     * @brief Run orders through a fresh book and collect every MBP row it emits
+     */
+    template <int Depth>
+    std::vector<typename BasicOrderBook<Depth>::MBPRow> reconstruct(const std::vector<Order>& orders) {
+        BasicOrderBook<Depth> book(DEFAULT_LADDER, false);
+        std::vector<typename BasicOrderBook<Depth>::MBPRow> rows;
+        
+        for (const Order& order : orders) {
+            if (const auto* row = book.process_order(order)) {
+                rows.push_back(*row);
+            }
+        }
+        return rows;
+    }
+    
+    /**
+     * @brief Write orders as an MBO CSV file in the feed's column layout
+     */
+    inline bool write_mbo_csv(const std::string& filename, const std::vector<Order>& orders) {
+        std::ofstream output(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        output << "ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,price,size,"
+                  "channel_id,order_id,flags,ts_in_delta,sequence,symbol\n";
+        
+        char price[32];
+        for (const Order& order : orders) {
+            *Utils::write_price_scaled(order.price_scaled, price) = '\0';
+            output << Utils::format_timestamp_ns(order.ts_recv) << ','
+                   << Utils::format_timestamp_ns(order.ts_event) << ",160,"
+                   << order.publisher_id << ',' << order.instrument_id << ','
+                   << order.action << ',' << order.side << ',' << price << ',' << order.size << ",0,"
+                   << order.order_id << ',' << order.flags << ',' << order.ts_in_delta << ','
+                   << order.sequence << ',' << SymbolTable::instance().lookup(order.symbol_id) << '\n';
+        }
+        return output.good();
+    }
+    
+    /**
+     * @brief Check that two orders agree on every field the readers fill in
+     */
+    inline bool same_order(const Order& a, const Order& b) {
+        return a.order_id == b.order_id && a.price_scaled == b.price_scaled && a.size == b.size &&
+               a.side == b.side && a.action == b.action && a.ts_recv == b.ts_recv && a.ts_event == b.ts_event &&
+               a.flags == b.flags && a.ts_in_delta == b.ts_in_delta && a.sequence == b.sequence &&
+               a.symbol_id == b.symbol_id && a.instrument_id == b.instrument_id && a.publisher_id == b.publisher_id;
+    }
+    
+    /**
+     * @brief Check that two MBP rows agree on every column
+     */
+    template <typename Row>
+    bool same_row(const Row& a, const Row& b) {
+        if (a.ts_recv != b.ts_recv || a.ts_event != b.ts_event || a.rtype != b.rtype ||
+            a.publisher_id != b.publisher_id || a.instrument_id != b.instrument_id || a.action != b.action ||
+            a.side != b.side || a.depth != b.depth || a.price_scaled != b.price_scaled || a.size != b.size ||
+            a.flags != b.flags || a.ts_in_delta != b.ts_in_delta || a.sequence != b.sequence ||
+            a.symbol_id != b.symbol_id || a.order_id != b.order_id) {
+            return false;
+        }
+        
+        for (size_t i = 0; i < std::size(a.bid_levels); ++i) {
+            const auto& bid_a = a.bid_levels[i];
+            const auto& bid_b = b.bid_levels[i];
+            const auto& ask_a = a.ask_levels[i];
+            const auto& ask_b = b.ask_levels[i];
+            if (bid_a.price_scaled != bid_b.price_scaled || bid_a.size != bid_b.size || bid_a.count != bid_b.count ||
+                ask_a.price_scaled != ask_b.price_scaled || ask_a.size != ask_b.size || ask_a.count != ask_b.count) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Whole file contents, empty if it cannot be read
+     */
+    inline std::string read_file(const std::string& filename) {
+        std::ifstream input(filename, std::ios::in | std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    
+    /**
+     * @brief Data lines of a CSV file, header dropped
+     */
+    inline std::vector<std::string> data_lines(const std::string& filename) {
+        std::vector<std::string> lines;
+        std::istringstream input(read_file(filename));
+        std::string line;
+        std::getline(input, line);
+        while (std::getline(input, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+    
+    /**
+     * @brief Write rows as MBP CSV, numbering them from first_index, and
+     * return the data lines; the file is removed afterwards
+     */
+    template <int Depth>
+    std::vector<std::string> csv_lines(const std::string& filename,
+                                       const std::vector<typename BasicOrderBook<Depth>::MBPRow>& rows,
+                                       size_t first_index = 0) {
+        {
+            BasicCsvWriter<Depth> writer(filename);
+            writer.set_next_row_index(first_index);
+            if (!writer.write_header() || !writer.write_mbp_rows(rows)) {
+                return {};
+            }
+        }
+        std::vector<std::string> lines = data_lines(filename);
+        std::remove(filename.c_str());
+        return lines;
+    }
+    
+    /**
+     * @brief Replace a file's contents
+     */
+    inline bool write_file(const std::string& filename, const std::string& contents) {
+        std::ofstream output(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        output.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        return output.good();
+    }
+}
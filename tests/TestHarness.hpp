@@ -0,0 +1,82 @@
+#pragma once
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Minimal self-registering test harness behind `make test`
+ * 
+ * TEST_CASE(name) defines a test and registers it with the runner in
+ * test_main.cpp. CHECK and CHECK_EQ record a failure and let the test
+ * continue; REQUIRE stops the current test. The runner executes every
+ * registered test and exits non-zero if any check failed.
+ */
+namespace TestHarness {
+    using TestFunction = void (*)();
+    
+    struct TestCase {
+        const char* name;
+        TestFunction function;
+    };
+    
+    /**
+     * @brief Every test registered by TEST_CASE, in static-initialization order
+     */
+    std::vector<TestCase>& registry();
+    
+    /**
+     * @brief Record a failed check for the test currently running
+     */
+    void record_failure(const char* file, int line, const std::string& message);
+    
+    /**
+     * @brief Thrown by REQUIRE to abandon the current test
+     */
+    struct RequireFailed {};
+    
+    struct Registrar {
+        Registrar(const char* name, TestFunction function) {
+            registry().push_back(TestCase{name, function});
+        }
+    };
+    
+    /**
+     * @brief Path for a scratch file in the system temp directory
+     * Tests remove their own files; the name should be unique per test
+     */
+    std::string temp_path(const std::string& name);
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static TestHarness::Registrar name##_registrar(#name, name); \
+    static void name()
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            TestHarness::record_failure(__FILE__, __LINE__, #condition); \
+        } \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        const auto& check_actual = (actual); \
+        const auto& check_expected = (expected); \
+        if (!(check_actual == check_expected)) { \
+            std::ostringstream check_message; \
+            check_message << #actual << " == " << #expected << " (got " << check_actual \
+                          << ", expected " << check_expected << ")"; \
+            TestHarness::record_failure(__FILE__, __LINE__, check_message.str()); \
+        } \
+    } while (0)
+
+#define REQUIRE(condition) \
+    do { \
+        if (!(condition)) { \
+            TestHarness::record_failure(__FILE__, __LINE__, #condition); \
+            throw TestHarness::RequireFailed(); \
+        } \
+    } while (0)
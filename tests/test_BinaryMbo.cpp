@@ -0,0 +1,158 @@
+#include "TestHarness.hpp"
+#include "TestData.hpp"
+#include "BinaryMboWriter.hpp"
+#include "BinaryMboReader.hpp"
+#include "MappedCsvReader.hpp"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @file test_BinaryMbo.cpp
+ * @brief Binary MBO record files: round trip, CSV conversion, truncation and foreign files
+ */
+
+namespace {
+    bool write_binary(const std::string& filename, const std::vector<Order>& orders) {
+        BinaryMboWriter writer(filename);
+        for (const Order& order : orders) {
+            if (!writer.write_order(order)) {
+                return false;
+            }
+        }
+        return writer.close();
+    }
+}
+
+TEST_CASE(binary_mbo_round_trips_orders) {
+    std::vector<Order> orders = TestData::generate_orders(5000);
+    std::string path = TestHarness::temp_path("binary_mbo.bin");
+    REQUIRE(write_binary(path, orders));
+    CHECK(BinaryMboReader::is_binary_mbo_file(path));
+    
+    BinaryMboReader reader(path);
+    REQUIRE(reader.is_open());
+    CHECK_EQ(reader.get_record_count(), orders.size());
+    
+    BinaryMboReader::ParseResult result = reader.parse_all_orders();
+    CHECK_EQ(result.parsing_errors, 0u);
+    REQUIRE(result.orders.size() == orders.size());
+    for (size_t i = 0; i < orders.size(); ++i) {
+        REQUIRE(TestData::same_order(result.orders[i], orders[i]));
+    }
+    
+    // Chunked decoding yields the same sequence
+    std::vector<Order> chunked;
+    reader.parse_in_chunks(333, [&](const std::vector<Order>& chunk) {
+        chunked.insert(chunked.end(), chunk.begin(), chunk.end());
+    });
+    REQUIRE(chunked.size() == orders.size());
+    for (size_t i = 0; i < orders.size(); ++i) {
+        REQUIRE(TestData::same_order(chunked[i], orders[i]));
+    }
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE(binary_mbo_conversion_matches_csv_reconstruction) {
+    std::vector<Order> orders = TestData::generate_orders(5000);
+    std::string csv_path = TestHarness::temp_path("binary_mbo_input.csv");
+    std::string binary_path = TestHarness::temp_path("binary_mbo_converted.bin");
+    REQUIRE(TestData::write_mbo_csv(csv_path, orders));
+    
+    CHECK_EQ(BinaryMboWriter::convert_csv(csv_path, binary_path), static_cast<long long>(orders.size()));
+    
+    MappedCsvReader csv_reader(csv_path);
+    BinaryMboReader binary_reader(binary_path);
+    REQUIRE(csv_reader.is_open());
+    REQUIRE(binary_reader.is_open());
+    
+    std::vector<Order> from_csv = csv_reader.parse_all_orders().orders;
+    std::vector<Order> from_binary = binary_reader.parse_all_orders().orders;
+    REQUIRE(from_csv.size() == from_binary.size());
+    
+    std::vector<OrderBook::MBPRow> csv_rows = TestData::reconstruct<Utils::MAX_DEPTH>(from_csv);
+    std::vector<OrderBook::MBPRow> binary_rows = TestData::reconstruct<Utils::MAX_DEPTH>(from_binary);
+    REQUIRE(csv_rows.size() == binary_rows.size());
+    for (size_t i = 0; i < csv_rows.size(); ++i) {
+        REQUIRE(TestData::same_row(csv_rows[i], binary_rows[i]));
+    }
+    
+    std::remove(csv_path.c_str());
+    std::remove(binary_path.c_str());
+}
+
+TEST_CASE(binary_mbo_rejects_truncated_files) {
+    std::vector<Order> orders = TestData::generate_orders(1000);
+    std::string path = TestHarness::temp_path("binary_mbo_truncated.bin");
+    REQUIRE(write_binary(path, orders));
+    std::string contents = TestData::read_file(path);
+    
+    // Inside the header, inside the records, and inside the symbol table at the end
+    const size_t cuts[] = {
+        sizeof(BinaryMboWriter::FileHeader) / 2,
+        contents.size() / 2,
+        contents.size() - 1,
+    };
+    for (size_t cut : cuts) {
+        REQUIRE(TestData::write_file(path, contents.substr(0, cut)));
+        CHECK(!BinaryMboReader(path).is_open());
+    }
+    
+    // A writer that was never closed leaves the symbol table offset unset
+    {
+        BinaryMboWriter writer(path);
+        for (const Order& order : orders) {
+            REQUIRE(writer.write_order(order));
+        }
+        
+        BinaryMboReader reader(path);
+        CHECK(!reader.is_open());
+    }
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE(binary_mbo_rejects_bad_magic_and_version) {
+    std::vector<Order> orders = TestData::generate_orders(100);
+    std::string path = TestHarness::temp_path("binary_mbo_magic.bin");
+    REQUIRE(write_binary(path, orders));
+    std::string contents = TestData::read_file(path);
+    
+    std::string bad_magic = contents;
+    bad_magic[3] = 'X';
+    REQUIRE(TestData::write_file(path, bad_magic));
+    CHECK(!BinaryMboReader::is_binary_mbo_file(path));
+    CHECK(!BinaryMboReader(path).is_open());
+    
+    // An MBO CSV is routed to the text readers, not here
+    REQUIRE(TestData::write_mbo_csv(path, orders));
+    CHECK(!BinaryMboReader::is_binary_mbo_file(path));
+    CHECK(!BinaryMboReader(path).is_open());
+    
+    std::string bad_version = contents;
+    BinaryMboWriter::FileHeader header;
+    std::memcpy(&header, bad_version.data(), sizeof(header));
+    header.version = BinaryMboWriter::FORMAT_VERSION + 1;
+    std::memcpy(&bad_version[0], &header, sizeof(header));
+    REQUIRE(TestData::write_file(path, bad_version));
+    CHECK(BinaryMboReader::is_binary_mbo_file(path));
+    CHECK(!BinaryMboReader(path).is_open());
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE(binary_mbo_rejects_orders_wider_than_a_record) {
+    std::vector<Order> orders = TestData::generate_orders(10);
+    orders[5].sequence = 5000000000ULL;
+    
+    std::string path = TestHarness::temp_path("binary_mbo_wide.bin");
+    BinaryMboWriter writer(path);
+    for (size_t i = 0; i < 5; ++i) {
+        CHECK(writer.write_order(orders[i]));
+    }
+    CHECK(!writer.write_order(orders[5]));
+    CHECK_EQ(writer.get_record_count(), 5u);
+    CHECK(writer.close());
+    
+    std::remove(path.c_str());
+}
@@ -0,0 +1,152 @@
+#include "TestHarness.hpp"
+#include "TestData.hpp"
+#include "BinaryMbpWriter.hpp"
+#include "BinaryMbpReader.hpp"
+#include "CsvWriter.hpp"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @file test_BinaryMbp.cpp
+ * @brief Binary columnar MBP files: round trip, truncation and foreign files
+ */
+
+namespace {
+    bool write_binary(const std::string& filename, const std::vector<OrderBook::MBPRow>& rows, uint32_t block_rows) {
+        BinaryMbpWriter writer(filename, block_rows);
+        if (!writer.is_open()) {
+            return false;
+        }
+        
+        for (const OrderBook::MBPRow& row : rows) {
+            if (!writer.write_mbp_row(row)) {
+                return false;
+            }
+        }
+        return writer.close();
+    }
+}
+
+TEST_CASE(binary_mbp_round_trips_rows) {
+    std::vector<OrderBook::MBPRow> rows = TestData::reconstruct<Utils::MAX_DEPTH>(TestData::generate_orders(4000));
+    REQUIRE(rows.size() > 1000);
+    
+    // Several full blocks plus a short last one
+    std::string path = TestHarness::temp_path("binary_mbp.bin");
+    REQUIRE(write_binary(path, rows, 256));
+    
+    BinaryMbpReader reader(path);
+    REQUIRE(reader.is_open());
+    CHECK_EQ(reader.get_file_header().row_count, rows.size());
+    CHECK_EQ(reader.get_block_count(), (rows.size() + 255) / 256);
+    
+    size_t index = 0;
+    OrderBook::MBPRow read_back;
+    for (size_t block = 0; block < reader.get_block_count(); ++block) {
+        for (size_t row = 0; row < reader.get_block(block).row_count(); ++row) {
+            REQUIRE(index < rows.size());
+            reader.read_row(block, row, read_back);
+            REQUIRE(TestData::same_row(read_back, rows[index]));
+            index++;
+        }
+    }
+    CHECK_EQ(index, rows.size());
+    
+    // Block timestamps bound the rows, so find_block lands on the right block
+    int64_t probe = rows[rows.size() / 2].ts_event;
+    size_t block = reader.find_block(probe);
+    REQUIRE(block < reader.get_block_count());
+    CHECK(reader.get_block(block).header->max_ts_event >= probe);
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE(binary_mbp_expands_to_the_csv_output) {
+    std::vector<OrderBook::MBPRow> rows = TestData::reconstruct<Utils::MAX_DEPTH>(TestData::generate_orders(1000));
+    
+    std::string binary_path = TestHarness::temp_path("binary_mbp_expand.bin");
+    std::string csv_path = TestHarness::temp_path("binary_mbp_direct.csv");
+    std::string expanded_path = TestHarness::temp_path("binary_mbp_expanded.csv");
+    REQUIRE(write_binary(binary_path, rows, BinaryMbpWriter::DEFAULT_ROWS_PER_BLOCK));
+    
+    {
+        CsvWriter writer(csv_path, MbpOutputMode::FULL);
+        REQUIRE(writer.write_header());
+        for (const OrderBook::MBPRow& row : rows) {
+            REQUIRE(writer.write_mbp_row(row));
+        }
+    }
+    
+    CHECK_EQ(BinaryMbpReader::expand_to_csv(binary_path, expanded_path), static_cast<long long>(rows.size()));
+    CHECK(TestData::read_file(expanded_path) == TestData::read_file(csv_path));
+    
+    std::remove(binary_path.c_str());
+    std::remove(csv_path.c_str());
+    std::remove(expanded_path.c_str());
+}
+
+TEST_CASE(binary_mbp_rejects_truncated_files) {
+    std::vector<OrderBook::MBPRow> rows = TestData::reconstruct<Utils::MAX_DEPTH>(TestData::generate_orders(1000));
+    
+    std::string path = TestHarness::temp_path("binary_mbp_truncated.bin");
+    REQUIRE(write_binary(path, rows, 128));
+    std::string contents = TestData::read_file(path);
+    
+    // Inside the header, inside a block, and inside the symbol table at the end
+    const size_t cuts[] = {
+        sizeof(BinaryMbpWriter::FileHeader) / 2,
+        contents.size() / 2,
+        contents.size() - 1,
+    };
+    for (size_t cut : cuts) {
+        REQUIRE(TestData::write_file(path, contents.substr(0, cut)));
+        BinaryMbpReader reader(path);
+        CHECK(!reader.is_open());
+        CHECK_EQ(reader.get_block_count(), 0u);
+    }
+    
+    // A writer that was never closed leaves the header totals unset
+    {
+        BinaryMbpWriter writer(path, 128);
+        for (const OrderBook::MBPRow& row : rows) {
+            REQUIRE(writer.write_mbp_row(row));
+        }
+        REQUIRE(writer.flush());
+        
+        BinaryMbpReader reader(path);
+        CHECK(!reader.is_open());
+    }
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE(binary_mbp_rejects_bad_magic_and_version) {
+    std::vector<OrderBook::MBPRow> rows = TestData::reconstruct<Utils::MAX_DEPTH>(TestData::generate_orders(200));
+    
+    std::string path = TestHarness::temp_path("binary_mbp_magic.bin");
+    REQUIRE(write_binary(path, rows, 64));
+    std::string contents = TestData::read_file(path);
+    
+    std::string bad_magic = contents;
+    bad_magic[0] = 'X';
+    REQUIRE(TestData::write_file(path, bad_magic));
+    CHECK(!BinaryMbpReader(path).is_open());
+    
+    // The MBO CSV header is not a binary file either
+    REQUIRE(TestData::write_file(path, "ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,price,size,"
+                                       "channel_id,order_id,flags,ts_in_delta,sequence,symbol\n"));
+    CHECK(!BinaryMbpReader(path).is_open());
+    
+    std::string bad_version = contents;
+    BinaryMbpWriter::FileHeader header;
+    std::memcpy(&header, bad_version.data(), sizeof(header));
+    header.version = BinaryMbpWriter::FORMAT_VERSION + 1;
+    std::memcpy(&bad_version[0], &header, sizeof(header));
+    REQUIRE(TestData::write_file(path, bad_version));
+    CHECK(!BinaryMbpReader(path).is_open());
+    
+    CHECK_EQ(BinaryMbpReader::expand_to_csv(path, TestHarness::temp_path("binary_mbp_magic.csv")), -1LL);
+    
+    std::remove(path.c_str());
+    std::remove(TestHarness::temp_path("binary_mbp_magic.csv").c_str());
+}
@@ -0,0 +1,77 @@
+#include "TestHarness.hpp"
+#include "TestData.hpp"
+#include "CompactOrder.hpp"
+#include <limits>
+
+/**
+ * @file test_CompactOrder.cpp
+ * @brief CompactOrder field limits: lossless inside them, rejected outside
+ */
+
+namespace {
+    Order make_order(uint64_t sequence, int64_t ts_in_delta, uint32_t flags) {
+        return Order(817593, 5510000000ULL, 100, 'B', 'A', TestData::START_TS + 150, TestData::START_TS,
+                     flags, static_cast<uint64_t>(ts_in_delta), sequence, 1, 1108, 2);
+    }
+}
+
+TEST_CASE(compact_order_round_trips_values_at_the_limits) {
+    const Order limits[] = {
+        make_order(0, 0, 0),
+        make_order(std::numeric_limits<uint32_t>::max(), std::numeric_limits<int32_t>::max(), 255),
+        make_order(851012, std::numeric_limits<int32_t>::min(), 130),
+        make_order(851013, -165200, 8),
+    };
+    
+    for (const Order& order : limits) {
+        CompactOrder compact;
+        CHECK(CompactOrder::fits(order));
+        REQUIRE(CompactOrder::from_order(order, compact));
+        
+        Order expanded = compact.to_order();
+        CHECK_EQ(expanded.sequence, order.sequence);
+        CHECK_EQ(expanded.ts_in_delta, order.ts_in_delta);
+        CHECK_EQ(expanded.flags, order.flags);
+        CHECK_EQ(expanded.order_id, order.order_id);
+        CHECK_EQ(expanded.price_scaled, order.price_scaled);
+        CHECK_EQ(expanded.ts_recv, order.ts_recv);
+    }
+}
+
+TEST_CASE(compact_order_rejects_out_of_range_values) {
+    const Order too_wide[] = {
+        make_order(uint64_t(std::numeric_limits<uint32_t>::max()) + 1, 0, 0),
+        make_order(5000000000ULL, 0, 0),
+        make_order(1, int64_t(std::numeric_limits<int32_t>::max()) + 1, 0),
+        make_order(1, int64_t(std::numeric_limits<int32_t>::min()) - 1, 0),
+        make_order(1, 0, 256),
+    };
+    
+    for (const Order& order : too_wide) {
+        CompactOrder compact;
+        compact.sequence = 7;
+        CHECK(!CompactOrder::fits(order));
+        CHECK(!CompactOrder::from_order(order, compact));
+        CHECK_EQ(compact.sequence, 7u);
+    }
+}
+
+TEST_CASE(fused_trade_keeps_full_order_metadata) {
+    // A T -> F -> C sequence is held inside the book; on the Order path its
+    // row must carry the trade's full 64-bit sequence and flags
+    const uint64_t sequence = 5000000000ULL;
+    const uint64_t price = TestData::BASE_PRICE;
+    
+    OrderBook book(DEFAULT_LADDER, false);
+    CHECK(book.process_order(Order(1, price, 10, 'B', 'A', 1, 1, 130, 0, sequence - 1, 1)) != nullptr);
+    CHECK(book.process_order(Order(0, price, 4, 'A', 'T', 2, 2, 300, 0, sequence, 1)) == nullptr);
+    CHECK(book.process_order(Order(1, price, 4, 'B', 'F', 3, 3, 130, 0, sequence + 1, 1)) == nullptr);
+    
+    const OrderBook::MBPRow* row = book.process_order(Order(1, price, 4, 'B', 'C', 4, 4, 130, 0, sequence + 2, 1));
+    REQUIRE(row != nullptr);
+    CHECK_EQ(row->action, 'T');
+    CHECK_EQ(row->side, 'B');
+    CHECK_EQ(row->sequence, sequence);
+    CHECK_EQ(row->flags, 300u);
+    CHECK_EQ(row->bid_levels[0].size, 6u);
+}
@@ -0,0 +1,61 @@
+#include "TestHarness.hpp"
+#include "TestData.hpp"
+#include "MappedCsvReader.hpp"
+#include <cstdio>
+#include <stdexcept>
+
+/**
+ * @file test_MappedCsvReader.cpp
+ * @brief Parallel range parsing: ordered delivery and error propagation
+ */
+
+TEST_CASE(parallel_parse_delivers_orders_in_file_order) {
+    std::vector<Order> orders = TestData::generate_orders(20000);
+    std::string path = TestHarness::temp_path("parallel_parse.csv");
+    REQUIRE(TestData::write_mbo_csv(path, orders));
+    
+    MappedCsvReader reader(path);
+    REQUIRE(reader.is_open());
+    
+    std::vector<Order> parsed;
+    MappedCsvReader::ParseResult result = reader.parse_in_chunks_parallel(500, 4, [&](const std::vector<Order>& chunk) {
+        parsed.insert(parsed.end(), chunk.begin(), chunk.end());
+    });
+    
+    CHECK_EQ(result.successful_parses, orders.size());
+    CHECK_EQ(result.parsing_errors, 0u);
+    REQUIRE(parsed.size() == orders.size());
+    for (size_t i = 0; i < orders.size(); ++i) {
+        REQUIRE(TestData::same_order(parsed[i], orders[i]));
+    }
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE(parallel_parse_rethrows_callback_error_after_join) {
+    std::vector<Order> orders = TestData::generate_orders(20000);
+    std::string path = TestHarness::temp_path("parallel_parse_error.csv");
+    REQUIRE(TestData::write_mbo_csv(path, orders));
+    
+    MappedCsvReader reader(path);
+    REQUIRE(reader.is_open());
+    
+    // Fail while workers are still running ahead; every thread must stop
+    // and the error must reach this thread instead of terminating
+    size_t chunks = 0;
+    bool caught = false;
+    try {
+        reader.parse_in_chunks_parallel(200, 4, [&](const std::vector<Order>&) {
+            if (++chunks == 3) {
+                throw std::runtime_error("book rejected chunk");
+            }
+        });
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()) == "book rejected chunk";
+    }
+    
+    CHECK(caught);
+    CHECK_EQ(chunks, 3u);
+    
+    std::remove(path.c_str());
+}
@@ -0,0 +1,85 @@
+#include "TestHarness.hpp"
+#include "TestData.hpp"
+#include "CsvWriter.hpp"
+#include "MbpDeltaReader.hpp"
+#include <cstdio>
+
+/**
+ * @file test_MbpDeltaReader.cpp
+ * @brief Delta output expanded with --expand-deltas must match the full output exactly
+ */
+
+namespace {
+    bool write_rows(const std::string& filename, MbpOutputMode mode, const std::vector<OrderBook::MBPRow>& rows) {
+        CsvWriter writer(filename, mode);
+        if (!writer.is_open() || !writer.write_header()) {
+            return false;
+        }
+        
+        for (const OrderBook::MBPRow& row : rows) {
+            if (!writer.write_mbp_row(row)) {
+                return false;
+            }
+        }
+        return writer.flush();
+    }
+}
+
+TEST_CASE(delta_expansion_reproduces_full_output) {
+    std::vector<OrderBook::MBPRow> rows = TestData::reconstruct<Utils::MAX_DEPTH>(TestData::generate_orders(5000));
+    REQUIRE(rows.size() > 1000);
+    
+    std::string full_path = TestHarness::temp_path("delta_full.csv");
+    std::string delta_path = TestHarness::temp_path("delta_delta.csv");
+    std::string expanded_path = TestHarness::temp_path("delta_expanded.csv");
+    
+    REQUIRE(write_rows(full_path, MbpOutputMode::FULL, rows));
+    REQUIRE(write_rows(delta_path, MbpOutputMode::DELTA, rows));
+    
+    CHECK_EQ(MbpDeltaReader::expand_to_csv(delta_path, expanded_path), static_cast<long long>(rows.size()));
+    
+    std::string full = TestData::read_file(full_path);
+    std::string delta = TestData::read_file(delta_path);
+    CHECK(!full.empty());
+    CHECK(delta.size() < full.size());
+    CHECK(TestData::read_file(expanded_path) == full);
+    
+    std::remove(full_path.c_str());
+    std::remove(delta_path.c_str());
+    std::remove(expanded_path.c_str());
+}
+
+TEST_CASE(delta_expansion_rejects_truncated_input) {
+    std::vector<OrderBook::MBPRow> rows = TestData::reconstruct<Utils::MAX_DEPTH>(TestData::generate_orders(500));
+    
+    std::string delta_path = TestHarness::temp_path("delta_truncated.csv");
+    std::string expanded_path = TestHarness::temp_path("delta_truncated_expanded.csv");
+    REQUIRE(write_rows(delta_path, MbpOutputMode::DELTA, rows));
+    
+    // Cut the last row off in the middle of its change tuples
+    std::string delta = TestData::read_file(delta_path);
+    size_t last_row = delta.rfind('\n', delta.size() - 2);
+    REQUIRE(TestData::write_file(delta_path, delta.substr(0, last_row + 1 + (delta.size() - last_row) / 2)));
+    
+    CHECK_EQ(MbpDeltaReader::expand_to_csv(delta_path, expanded_path), -1LL);
+    
+    // An output path that cannot be created is an error, not zero rows
+    CHECK_EQ(MbpDeltaReader::expand_to_csv(delta_path, TestHarness::temp_path("missing_dir/out.csv")), -1LL);
+    
+    std::remove(delta_path.c_str());
+    std::remove(expanded_path.c_str());
+}
+
+#ifdef __linux__
+TEST_CASE(delta_expansion_reports_write_failure) {
+    std::vector<OrderBook::MBPRow> rows = TestData::reconstruct<Utils::MAX_DEPTH>(TestData::generate_orders(5));
+    
+    std::string delta_path = TestHarness::temp_path("delta_device_full.csv");
+    REQUIRE(write_rows(delta_path, MbpOutputMode::DELTA, rows));
+    
+    // /dev/full accepts the open and fails every write, so only the final flush notices
+    CHECK_EQ(MbpDeltaReader::expand_to_csv(delta_path, "/dev/full"), -1LL);
+    
+    std::remove(delta_path.c_str());
+}
+#endif
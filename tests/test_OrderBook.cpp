@@ -0,0 +1,258 @@
+#include "TestHarness.hpp"
+#include "TestData.hpp"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @file test_OrderBook.cpp
+ * @brief Order book rows and snapshots: record types, resume equivalence and rejection of foreign files
+ */
+
+namespace {
+    /**
+     * @brief Process orders[begin, end) and append the emitted rows
+     */
+    template <int Depth>
+    void process_range(BasicOrderBook<Depth>& book, const std::vector<Order>& orders, size_t begin, size_t end,
+                       std::vector<typename BasicOrderBook<Depth>::MBPRow>& rows) {
+        for (size_t i = begin; i < end; ++i) {
+            if (const auto* row = book.process_order(orders[i])) {
+                rows.push_back(*row);
+            }
+        }
+    }
+    
+    /**
+     * @brief Save a snapshot part way through, resume in a fresh book, and
+     * check the combined output against an uninterrupted run
+     * 
+     * Like main, the snapshot waits until a trade that is in progress at
+     * split completes. The resumed run's CSV, numbered from the row count
+     * stored in the snapshot, must splice onto the first run's CSV line
+     * for line.
+     * 
+     * @return The event count the snapshot was taken at
+     */
+    template <int Depth>
+    size_t check_resume_matches_uninterrupted(const std::string& snapshot_name, const std::vector<Order>& orders,
+                                            size_t split) {
+        using MBPRow = typename BasicOrderBook<Depth>::MBPRow;
+        std::vector<MBPRow> expected = TestData::reconstruct<Depth>(orders);
+        std::string path = TestHarness::temp_path(snapshot_name);
+        std::string csv_path = TestHarness::temp_path(snapshot_name + ".csv");
+        
+        std::vector<MBPRow> rows_before;
+        BasicOrderBook<Depth> first(DEFAULT_LADDER, false);
+        process_range(first, orders, 0, split, rows_before);
+        while (first.has_pending_trade()) {
+            process_range(first, orders, split, split + 1, rows_before);
+            split++;
+        }
+        REQUIRE(first.save_snapshot(path, split, rows_before.size()));
+        
+        // The other ladder implementation restores the same book
+        LadderType other = DEFAULT_LADDER == LadderType::ARRAY ? LadderType::MAP : LadderType::ARRAY;
+        BasicOrderBook<Depth> resumed(other, false);
+        uint64_t resume_position = 0;
+        uint64_t rows_written = 0;
+        REQUIRE(resumed.load_snapshot(path, resume_position, rows_written));
+        CHECK_EQ(resume_position, static_cast<uint64_t>(split));
+        CHECK_EQ(rows_written, static_cast<uint64_t>(rows_before.size()));
+        CHECK_EQ(resumed.get_last_sequence(), first.get_last_sequence());
+        CHECK_EQ(resumed.get_total_orders(), first.get_total_orders());
+        CHECK(resumed.get_level_counts() == first.get_level_counts());
+        
+        std::vector<MBPRow> rows_after;
+        process_range(resumed, orders, static_cast<size_t>(resume_position), orders.size(), rows_after);
+        
+        std::vector<MBPRow> rows = rows_before;
+        rows.insert(rows.end(), rows_after.begin(), rows_after.end());
+        REQUIRE(rows.size() == expected.size());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            REQUIRE(TestData::same_row(rows[i], expected[i]));
+        }
+        
+        std::vector<std::string> expected_lines = TestData::csv_lines<Depth>(csv_path, expected, 0);
+        std::vector<std::string> lines = TestData::csv_lines<Depth>(csv_path, rows_before, 0);
+        std::vector<std::string> resumed_lines = TestData::csv_lines<Depth>(csv_path, rows_after, rows_written);
+        lines.insert(lines.end(), resumed_lines.begin(), resumed_lines.end());
+        REQUIRE(expected_lines.size() == expected.size());
+        CHECK(lines == expected_lines);
+        
+        std::remove(path.c_str());
+        return split;
+    }
+    
+    /**
+     * @brief An order on the test instrument with only the fields the book keys on varying
+     */
+    Order make_order(uint64_t order_id, uint64_t price_scaled, char side, char action, uint64_t sequence) {
+        int64_t ts_event = TestData::START_TS + static_cast<int64_t>(sequence) * 1000;
+        return Order(order_id, price_scaled, 100, side, action, ts_event + 150, ts_event, 130, 165000, sequence,
+                     SymbolTable::instance().intern("TEST"), 1108, 2);
+    }
+    
+    std::string save_sample_snapshot(const std::string& snapshot_name) {
+        OrderBook book(DEFAULT_LADDER, false);
+        for (const Order& order : TestData::generate_orders(2000)) {
+            book.process_order(order);
+        }
+        
+        std::string path = TestHarness::temp_path(snapshot_name);
+        return book.save_snapshot(path, 2000, 1500) ? path : std::string();
+    }
+}
+
+TEST_CASE(rows_carry_the_record_type_of_their_depth) {
+    std::vector<Order> orders = TestData::generate_orders(500);
+    
+    auto bbo_rows = TestData::reconstruct<1>(orders);
+    auto mbp10_rows = TestData::reconstruct<10>(orders);
+    auto mbp50_rows = TestData::reconstruct<50>(orders);
+    REQUIRE(!bbo_rows.empty() && !mbp10_rows.empty() && !mbp50_rows.empty());
+    
+    CHECK_EQ(bbo_rows.front().rtype, Utils::RTYPE_MBP1);
+    CHECK_EQ(mbp10_rows.front().rtype, Utils::RTYPE_MBP10);
+    CHECK_EQ(mbp50_rows.front().rtype, Utils::RTYPE_MBP50);
+    CHECK_EQ(mbp50_rows.back().rtype, Utils::RTYPE_MBP50);
+}
+
+TEST_CASE(array_and_map_ladders_agree_when_the_window_empties) {
+    // 100.00 centers the array ladder's ask window and 130.01-130.09 land in
+    // its overflow; cancelling 100.00 empties the window, then a worse ask arrives
+    std::vector<Order> orders;
+    uint64_t sequence = 1;
+    orders.push_back(make_order(1, 99 * Utils::PRICE_SCALE, 'B', 'A', sequence++));
+    orders.push_back(make_order(2, 100 * Utils::PRICE_SCALE, 'A', 'A', sequence++));
+    for (uint64_t cents = 1; cents <= 9; ++cents) {
+        orders.push_back(make_order(2 + cents, 130 * Utils::PRICE_SCALE + cents * TestData::TICK, 'A', 'A', sequence++));
+    }
+    orders.push_back(make_order(2, 100 * Utils::PRICE_SCALE, 'A', 'C', sequence++));
+    orders.push_back(make_order(20, 200 * Utils::PRICE_SCALE, 'A', 'A', sequence++));
+    
+    OrderBook array_book(LadderType::ARRAY, false);
+    OrderBook map_book(LadderType::MAP, false);
+    for (const Order& order : orders) {
+        const OrderBook::MBPRow* array_row = array_book.process_order(order);
+        const OrderBook::MBPRow* map_row = map_book.process_order(order);
+        REQUIRE((array_row != nullptr) == (map_row != nullptr));
+        if (array_row != nullptr) {
+            CHECK(TestData::same_row(*array_row, *map_row));
+        }
+    }
+    
+    const OrderBook::MBPRow& row = array_book.get_last_mbp_row();
+    CHECK_EQ(row.ask_levels[0].price_scaled, 130 * Utils::PRICE_SCALE + TestData::TICK);
+    CHECK_EQ(row.ask_levels[8].price_scaled, 130 * Utils::PRICE_SCALE + 9 * TestData::TICK);
+    CHECK_EQ(row.ask_levels[9].price_scaled, 200 * Utils::PRICE_SCALE);
+    CHECK(array_book.get_spread() == map_book.get_spread());
+    CHECK_EQ(array_book.get_spread().second, 130.01);
+}
+
+TEST_CASE(snapshot_resume_matches_uninterrupted_run) {
+    std::vector<Order> orders = TestData::generate_orders(6000);
+    check_resume_matches_uninterrupted<Utils::MAX_DEPTH>("snapshot_resume_10.bin", orders, orders.size() / 2);
+}
+
+TEST_CASE(snapshot_resume_matches_uninterrupted_bbo_run) {
+    // The BBO book only emits when the top changes, so the restored book
+    // must also restore what it last reported
+    std::vector<Order> orders = TestData::generate_orders(6000);
+    check_resume_matches_uninterrupted<1>("snapshot_resume_1.bin", orders, orders.size() / 2);
+}
+
+TEST_CASE(snapshot_waits_for_a_trade_in_progress) {
+    // Split right after a T: the snapshot is taken once its F and C are applied
+    std::vector<Order> orders = TestData::generate_orders(6000);
+    size_t trade = TestData::find_trade(orders, orders.size() / 2);
+    REQUIRE(trade < orders.size());
+    CHECK_EQ(check_resume_matches_uninterrupted<Utils::MAX_DEPTH>("snapshot_trade_10.bin", orders, trade + 1),
+             trade + 3);
+    CHECK_EQ(check_resume_matches_uninterrupted<1>("snapshot_trade_1.bin", orders, trade + 2), trade + 3);
+}
+
+TEST_CASE(snapshot_rejects_mismatched_depth) {
+    std::string path = save_sample_snapshot("snapshot_depth.bin");
+    REQUIRE(!path.empty());
+    
+    uint64_t resume_position = 0;
+    uint64_t rows_written = 0;
+    BasicOrderBook<1> bbo_book(DEFAULT_LADDER, false);
+    CHECK(!bbo_book.load_snapshot(path, resume_position, rows_written));
+    CHECK_EQ(bbo_book.get_total_orders(), 0u);
+    
+    BasicOrderBook<50> deep_book(DEFAULT_LADDER, false);
+    CHECK(!deep_book.load_snapshot(path, resume_position, rows_written));
+    CHECK_EQ(deep_book.get_total_orders(), 0u);
+    
+    OrderBook same_depth(DEFAULT_LADDER, false);
+    CHECK(same_depth.load_snapshot(path, resume_position, rows_written));
+    CHECK_EQ(resume_position, 2000u);
+    CHECK_EQ(rows_written, 1500u);
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE(snapshot_rejects_mismatched_version_and_magic) {
+    std::string path = save_sample_snapshot("snapshot_version.bin");
+    REQUIRE(!path.empty());
+    std::string contents = TestData::read_file(path);
+    
+    OrderBook::SnapshotHeader header;
+    std::memcpy(&header, contents.data(), sizeof(header));
+    CHECK_EQ(header.version, OrderBook::SNAPSHOT_VERSION);
+    CHECK_EQ(header.depth, static_cast<uint32_t>(Utils::MAX_DEPTH));
+    CHECK_EQ(header.rows_written, 1500u);
+    
+    uint64_t resume_position = 0;
+    uint64_t rows_written = 0;
+    for (uint32_t version : {OrderBook::SNAPSHOT_VERSION - 1, OrderBook::SNAPSHOT_VERSION + 1}) {
+        std::string patched = contents;
+        header.version = version;
+        std::memcpy(&patched[0], &header, sizeof(header));
+        REQUIRE(TestData::write_file(path, patched));
+        
+        OrderBook book(DEFAULT_LADDER, false);
+        CHECK(!book.load_snapshot(path, resume_position, rows_written));
+        CHECK_EQ(book.get_total_orders(), 0u);
+    }
+    
+    std::string bad_magic = contents;
+    bad_magic[0] = 'X';
+    REQUIRE(TestData::write_file(path, bad_magic));
+    OrderBook book(DEFAULT_LADDER, false);
+    CHECK(!book.load_snapshot(path, resume_position, rows_written));
+    
+    std::remove(path.c_str());
+}
+
+TEST_CASE(snapshot_rejects_truncated_file) {
+    std::string path = save_sample_snapshot("snapshot_truncated.bin");
+    REQUIRE(!path.empty());
+    std::string contents = TestData::read_file(path);
+    REQUIRE(contents.size() > sizeof(OrderBook::SnapshotHeader) + sizeof(OrderBook::SnapshotLevel));
+    
+    // Inside the header, inside the first level record, mid file, one byte short
+    const size_t cuts[] = {
+        sizeof(OrderBook::SnapshotHeader) / 2,
+        sizeof(OrderBook::SnapshotHeader) + sizeof(OrderBook::SnapshotLevel) / 2,
+        contents.size() / 2,
+        contents.size() - 1,
+    };
+    
+    uint64_t resume_position = 0;
+    uint64_t rows_written = 0;
+    for (size_t cut : cuts) {
+        REQUIRE(TestData::write_file(path, contents.substr(0, cut)));
+        
+        // A book with state of its own is emptied by a failed load past the header
+        OrderBook book(DEFAULT_LADDER, false);
+        book.process_order(TestData::generate_orders(1)[0]);
+        CHECK(!book.load_snapshot(path, resume_position, rows_written));
+        if (cut >= sizeof(OrderBook::SnapshotHeader)) {
+            CHECK_EQ(book.get_total_orders(), 0u);
+        }
+    }
+    
+    std::remove(path.c_str());
+}
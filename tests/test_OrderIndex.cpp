@@ -0,0 +1,227 @@
+#include "TestHarness.hpp"
+#include "OrderIndex.hpp"
+#include <random>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * @file test_OrderIndex.cpp
+ * @brief OrderIndex tests: growth, migration, wrap-around deletion, reference comparison
+ */
+
+namespace {
+    /**
+     * @brief Check that every key in reference is found with its value and the sizes agree
+     */
+    bool matches(OrderIndex& index, const std::unordered_map<uint64_t, uint32_t>& reference) {
+        if (index.size() != reference.size()) {
+            return false;
+        }
+        
+        for (const auto& [key, value] : reference) {
+            uint32_t* found = index.find(key);
+            if (found == nullptr || *found != value) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Home slot of a key in a table of MIN_CAPACITY (16) slots
+     * Mirrors OrderIndex::Table::home so tests can build collision chains
+     */
+    size_t home_in_16_slots(uint64_t key) {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 60);
+    }
+}
+
+TEST_CASE(order_index_insert_find_erase_across_growth) {
+    OrderIndex index;
+    size_t initial_capacity = index.capacity();
+    
+    // Insert until a migration starts, then keep going until it completes
+    uint64_t key = 1;
+    while (!index.is_migrating()) {
+        index.insert_or_assign(key, static_cast<uint32_t>(key * 3));
+        key++;
+    }
+    CHECK(index.capacity() > initial_capacity);
+    
+    while (index.is_migrating()) {
+        index.insert_or_assign(key, static_cast<uint32_t>(key * 3));
+        key++;
+    }
+    
+    uint64_t inserted = key - 1;
+    CHECK_EQ(index.size(), inserted);
+    for (uint64_t k = 1; k <= inserted; ++k) {
+        uint32_t* value = index.find(k);
+        REQUIRE(value != nullptr);
+        CHECK_EQ(*value, static_cast<uint32_t>(k * 3));
+    }
+    CHECK(index.find(inserted + 1) == nullptr);
+    CHECK(index.find(0) == nullptr);
+    
+    // Overwrite keeps the size
+    index.insert_or_assign(1, 99);
+    CHECK_EQ(index.size(), inserted);
+    CHECK_EQ(*index.find(1), 99u);
+    
+    for (uint64_t k = 1; k <= inserted; k += 2) {
+        CHECK(index.erase(k));
+    }
+    CHECK(!index.erase(1));
+    
+    for (uint64_t k = 1; k <= inserted; ++k) {
+        uint32_t* value = index.find(k);
+        if (k % 2 == 1) {
+            CHECK(value == nullptr);
+        } else {
+            REQUIRE(value != nullptr);
+            CHECK_EQ(*value, static_cast<uint32_t>(k * 3));
+        }
+    }
+    CHECK_EQ(index.size(), inserted / 2);
+}
+
+TEST_CASE(order_index_erase_during_migration) {
+    OrderIndex index;
+    std::unordered_map<uint64_t, uint32_t> reference;
+    
+    // Grow a few times first so the migration is long enough to interleave with
+    uint64_t key = 1000;
+    while (index.capacity() < 1024) {
+        index.insert_or_assign(key, static_cast<uint32_t>(key));
+        reference[key] = static_cast<uint32_t>(key);
+        key++;
+    }
+    while (!index.is_migrating()) {
+        index.insert_or_assign(key, static_cast<uint32_t>(key));
+        reference[key] = static_cast<uint32_t>(key);
+        key++;
+    }
+    
+    // Erase keys that are still in the retiring table as well as keys just
+    // inserted into the new one, checking every remaining key as we go
+    size_t erases_while_migrating = 0;
+    uint64_t oldest = 1000;
+    while (index.is_migrating()) {
+        CHECK(index.erase(oldest));
+        reference.erase(oldest);
+        oldest += 3;
+        
+        index.insert_or_assign(key, static_cast<uint32_t>(key));
+        CHECK(index.erase(key));
+        CHECK(index.find(key) == nullptr);
+        key++;
+        
+        erases_while_migrating++;
+        REQUIRE(matches(index, reference));
+    }
+    CHECK(erases_while_migrating > 1);
+    
+    CHECK(!index.erase(1000));
+    CHECK(matches(index, reference));
+}
+
+TEST_CASE(order_index_erase_with_wrap_around) {
+    // Collect keys that all hash to the last slot of the initial 16-slot table,
+    // so their probe chain wraps to slots 0, 1, 2
+    std::vector<uint64_t> chain;
+    for (uint64_t key = 1; chain.size() < 4; ++key) {
+        if (home_in_16_slots(key) == 15) {
+            chain.push_back(key);
+        }
+    }
+    
+    // And a key whose home is slot 0, which the wrapped chain displaces
+    uint64_t at_zero = 1;
+    while (home_in_16_slots(at_zero) != 0) {
+        at_zero++;
+    }
+    
+    OrderIndex index;
+    for (uint64_t key : chain) {
+        index.insert_or_assign(key, static_cast<uint32_t>(key + 1));
+    }
+    index.insert_or_assign(at_zero, 7);
+    REQUIRE(index.capacity() == 16);
+    REQUIRE(!index.is_migrating());
+    
+    // Erasing the head of the chain (slot 15) shifts the followers back across the wrap
+    CHECK(index.erase(chain[0]));
+    CHECK(index.find(chain[0]) == nullptr);
+    for (size_t i = 1; i < chain.size(); ++i) {
+        uint32_t* value = index.find(chain[i]);
+        REQUIRE(value != nullptr);
+        CHECK_EQ(*value, static_cast<uint32_t>(chain[i] + 1));
+    }
+    REQUIRE(index.find(at_zero) != nullptr);
+    CHECK_EQ(*index.find(at_zero), 7u);
+    
+    // Erase the wrapped entries from the middle and end as well
+    CHECK(index.erase(chain[2]));
+    CHECK(index.erase(at_zero));
+    CHECK(index.find(chain[2]) == nullptr);
+    CHECK(index.find(at_zero) == nullptr);
+    REQUIRE(index.find(chain[1]) != nullptr);
+    REQUIRE(index.find(chain[3]) != nullptr);
+    CHECK_EQ(*index.find(chain[3]), static_cast<uint32_t>(chain[3] + 1));
+    CHECK_EQ(index.size(), 2u);
+    
+    // Reinserting after the shifts still finds everything
+    index.insert_or_assign(chain[0], 1);
+    index.insert_or_assign(at_zero, 2);
+    CHECK_EQ(*index.find(chain[0]), 1u);
+    CHECK_EQ(*index.find(at_zero), 2u);
+    CHECK_EQ(index.size(), 4u);
+}
+
+TEST_CASE(order_index_matches_unordered_map_on_random_ops) {
+    OrderIndex index;
+    std::unordered_map<uint64_t, uint32_t> reference;
+    std::mt19937_64 rng(12345);
+    
+    // A small key space keeps hits, overwrites and misses all frequent; the
+    // insert bias lets the table grow through several migrations
+    for (int round = 0; round < 3; ++round) {
+        uint64_t key_space = 4096 << (round * 2);
+        
+        for (int op = 0; op < 200000; ++op) {
+            uint64_t key = rng() % key_space;
+            uint32_t value = static_cast<uint32_t>(rng());
+            unsigned kind = static_cast<unsigned>(rng() % 10);
+            
+            if (kind < 6) {
+                index.insert_or_assign(key, value);
+                reference[key] = value;
+            } else if (kind < 9) {
+                CHECK_EQ(index.erase(key), reference.erase(key) == 1);
+            } else {
+                uint32_t* found = index.find(key);
+                auto it = reference.find(key);
+                REQUIRE((found != nullptr) == (it != reference.end()));
+                if (found != nullptr) {
+                    CHECK_EQ(*found, it->second);
+                }
+            }
+            
+            REQUIRE(index.size() == reference.size());
+        }
+        
+        CHECK(matches(index, reference));
+    }
+    
+    index.clear();
+    CHECK(index.empty());
+    CHECK(index.find(reference.begin()->first) == nullptr);
+    
+    // Reserve rehashes synchronously, so the refill never migrates
+    index.reserve(reference.size());
+    for (const auto& [key, value] : reference) {
+        index.insert_or_assign(key, value);
+        REQUIRE(!index.is_migrating());
+    }
+    CHECK(matches(index, reference));
+}
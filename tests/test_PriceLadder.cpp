@@ -0,0 +1,123 @@
+#include "TestHarness.hpp"
+#include "PriceLadder.hpp"
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * @file test_PriceLadder.cpp
+ * @brief ArrayLadder against MapLadder: best-first order across recenters and overflow
+ */
+
+namespace {
+    using Levels = std::vector<std::pair<uint64_t, uint64_t>>;
+    
+    constexpr uint64_t CENT = Utils::PRICE_SCALE / 100;
+    
+    /**
+     * @brief Every (price, level) pair in best-first order
+     */
+    template <typename Ladder>
+    Levels best_first(const Ladder& ladder) {
+        Levels levels;
+        ladder.for_each_best([&levels](uint64_t price_scaled, const uint64_t& level) {
+            levels.emplace_back(price_scaled, level);
+            return true;
+        });
+        return levels;
+    }
+    
+    /**
+     * @brief Apply the same insert or erase to both ladders
+     */
+    struct LadderPair {
+        ArrayLadder<uint64_t> array_ladder;
+        MapLadder<uint64_t> map_ladder;
+        
+        explicit LadderPair(bool bid_side) : array_ladder(bid_side), map_ladder(bid_side) {}
+        
+        void insert(uint64_t price_scaled, uint64_t value) {
+            array_ladder.insert(price_scaled) = value;
+            map_ladder.insert(price_scaled) = value;
+        }
+        
+        void erase(uint64_t price_scaled) {
+            array_ladder.erase(price_scaled);
+            map_ladder.erase(price_scaled);
+        }
+        
+        bool agree() const {
+            return array_ladder.size() == map_ladder.size() && best_first(array_ladder) == best_first(map_ladder);
+        }
+    };
+}
+
+TEST_CASE(array_ladder_window_emptied_with_better_overflow_asks) {
+    LadderPair ladder(false);
+    
+    // 100.00 centers the window; 130.01-130.09 are past its far edge
+    ladder.insert(100 * Utils::PRICE_SCALE, 1);
+    for (uint64_t cents = 1; cents <= 9; ++cents) {
+        ladder.insert(130 * Utils::PRICE_SCALE + cents * CENT, cents);
+    }
+    REQUIRE(ladder.agree());
+    
+    // Emptying the window leaves only overflow levels, then a worse price arrives
+    ladder.erase(100 * Utils::PRICE_SCALE);
+    CHECK(ladder.agree());
+    ladder.insert(200 * Utils::PRICE_SCALE, 20);
+    CHECK(ladder.agree());
+    
+    Levels levels = best_first(ladder.array_ladder);
+    REQUIRE(levels.size() == 10u);
+    CHECK_EQ(levels.front().first, 130 * Utils::PRICE_SCALE + CENT);
+    CHECK_EQ(levels.back().first, 200 * Utils::PRICE_SCALE);
+    REQUIRE(ladder.array_ladder.find(130 * Utils::PRICE_SCALE + 9 * CENT) != nullptr);
+    CHECK_EQ(*ladder.array_ladder.find(130 * Utils::PRICE_SCALE + 9 * CENT), 9u);
+}
+
+TEST_CASE(array_ladder_window_emptied_with_better_overflow_bids) {
+    LadderPair ladder(true);
+    
+    ladder.insert(100 * Utils::PRICE_SCALE, 1);
+    for (uint64_t cents = 1; cents <= 9; ++cents) {
+        ladder.insert(70 * Utils::PRICE_SCALE - cents * CENT, cents);
+    }
+    
+    ladder.erase(100 * Utils::PRICE_SCALE);
+    CHECK(ladder.agree());
+    ladder.insert(10 * Utils::PRICE_SCALE, 20);
+    CHECK(ladder.agree());
+    
+    // A finer price narrows the tick and rebuilds around the best level
+    ladder.insert(70 * Utils::PRICE_SCALE - 5 * CENT - 1, 30);
+    CHECK(ladder.agree());
+    Levels levels = best_first(ladder.array_ladder);
+    REQUIRE(levels.size() == 11u);
+    CHECK_EQ(levels.front().first, 70 * Utils::PRICE_SCALE - CENT);
+}
+
+TEST_CASE(array_ladder_matches_map_ladder_on_random_ops) {
+    std::mt19937_64 rng(7);
+    
+    for (bool bid_side : {true, false}) {
+        LadderPair ladder(bid_side);
+        std::vector<uint64_t> prices;
+        
+        // Prices spread over several window widths so levels keep moving
+        // between the window and overflow, and the window keeps emptying
+        for (int op = 0; op < 20000; ++op) {
+            if (prices.empty() || rng() % 100 < 55) {
+                uint64_t price_scaled = 50 * Utils::PRICE_SCALE + (rng() % 20000) * CENT;
+                ladder.insert(price_scaled, rng());
+                prices.push_back(price_scaled);
+            } else {
+                size_t victim = static_cast<size_t>(rng() % prices.size());
+                ladder.erase(prices[victim]);
+                prices[victim] = prices.back();
+                prices.pop_back();
+            }
+            REQUIRE(ladder.agree());
+        }
+    }
+}
@@ -0,0 +1,291 @@
+#include "TestHarness.hpp"
+#include "TestData.hpp"
+#include "Reconstruction.hpp"
+#include "BookManager.hpp"
+#include <cstdio>
+#include <unordered_map>
+
+/**
+ * @file test_Reconstruction.cpp
+ * @brief Trades through the checkpoint, resume, --pipeline, --conflate and --books paths
+ * 
+ * Every run is compared line for line, index column included, with the
+ * plain run: each event straight through one book, every row written.
+ */
+
+namespace {
+    /**
+     * @brief How a run is set up, mirroring the command line options
+     */
+    struct RunSetup {
+        std::string checkpoint_filename;
+        size_t checkpoint_interval = 0;
+        std::string resume_filename;
+        int64_t conflate_interval_ns = 0;
+    };
+    
+    /**
+     * @brief Restore the checkpoint and fill in progress the way main does
+     */
+    void prepare(const RunSetup& setup, OrderBook& book, CsvWriter& writer, ReconstructionProgress& progress) {
+        uint64_t resume_position = 0;
+        uint64_t resume_rows = 0;
+        if (!setup.resume_filename.empty()) {
+            REQUIRE(book.load_snapshot(setup.resume_filename, resume_position, resume_rows));
+        }
+        REQUIRE(writer.write_header());
+        writer.set_next_row_index(resume_rows);
+        
+        progress.resume_position = resume_position;
+        progress.resume_rows = resume_rows;
+        progress.first_clear_ignored = resume_position != 0;
+        progress.conflate_interval_ns = setup.conflate_interval_ns;
+        if (!setup.checkpoint_filename.empty()) {
+            progress.checkpoint_filename = setup.checkpoint_filename;
+            progress.checkpoint_interval = setup.checkpoint_interval;
+            progress.next_checkpoint = resume_position + setup.checkpoint_interval;
+        }
+    }
+    
+    /**
+     * @brief Apply orders one by one on this thread (the in-memory path)
+     * @return The data lines written
+     */
+    std::vector<std::string> run_in_memory(const std::vector<Order>& orders, const RunSetup& setup,
+                                           const std::string& csv_path) {
+        {
+            OrderBook book(DEFAULT_LADDER, false);
+            CsvWriter writer(csv_path);
+            ReconstructionProgress progress;
+            prepare(setup, book, writer, progress);
+            
+            for (const Order& order : orders) {
+                REQUIRE(apply_order(order, book, writer, progress));
+            }
+            REQUIRE(write_conflated_row(book, writer, progress));
+            REQUIRE(writer.flush());
+        }
+        std::vector<std::string> lines = TestData::data_lines(csv_path);
+        std::remove(csv_path.c_str());
+        return lines;
+    }
+    
+    /**
+     * @brief Parse mbo_path on a reader thread and write on a writer thread (--pipeline)
+     * @return The data lines written
+     */
+    std::vector<std::string> run_pipelined(const std::string& mbo_path, const RunSetup& setup,
+                                           const std::string& csv_path) {
+        {
+            MappedCsvReader reader(mbo_path);
+            REQUIRE(reader.is_open());
+            OrderBook book(DEFAULT_LADDER, false);
+            CsvWriter writer(csv_path);
+            ReconstructionProgress progress;
+            prepare(setup, book, writer, progress);
+            
+            CsvReader::ParseResult parse_result;
+            REQUIRE(run_pipeline(nullptr, &reader, nullptr, 1, book, writer, progress, parse_result));
+            REQUIRE(parse_result.is_successful());
+            REQUIRE(writer.flush());
+        }
+        std::vector<std::string> lines = TestData::data_lines(csv_path);
+        std::remove(csv_path.c_str());
+        return lines;
+    }
+    
+    /**
+     * @brief Rows of the plain run, each event through one book
+     */
+    std::vector<std::string> plain_lines(const std::vector<Order>& orders, const std::string& csv_path) {
+        return TestData::csv_lines<Utils::MAX_DEPTH>(csv_path, TestData::reconstruct<Utils::MAX_DEPTH>(orders));
+    }
+    
+    /**
+     * @brief Number of fused T rows among the lines
+     */
+    size_t count_trade_rows(const std::vector<std::string>& lines) {
+        size_t trades = 0;
+        for (const std::string& line : lines) {
+            trades += line.find(",T,") != std::string::npos;
+        }
+        return trades;
+    }
+    
+    /**
+     * @brief Resume from checkpoint_filename and splice the result onto the
+     * rows the checkpointed run had written by then
+     */
+    template <typename Run>
+    std::vector<std::string> spliced_resume(const std::vector<std::string>& checkpointed_lines,
+                                            const std::string& checkpoint_filename, Run&& run) {
+        RunSetup resume;
+        resume.resume_filename = checkpoint_filename;
+        std::vector<std::string> resumed = run(resume);
+        
+        std::vector<std::string> lines(checkpointed_lines.begin(),
+                                       checkpointed_lines.begin() + (checkpointed_lines.size() - resumed.size()));
+        lines.insert(lines.end(), resumed.begin(), resumed.end());
+        return lines;
+    }
+}
+
+TEST_CASE(checkpoint_waits_for_trade_and_resume_matches_plain_run) {
+    std::vector<Order> orders = TestData::generate_orders(6000);
+    std::string checkpoint = TestHarness::temp_path("reconstruction_checkpoint.bin");
+    std::string csv = TestHarness::temp_path("reconstruction_checkpoint.csv");
+    
+    // The checkpoint comes due right after a T, one interval only
+    size_t trade = TestData::find_trade(orders, orders.size() / 2);
+    REQUIRE(trade < orders.size());
+    RunSetup setup;
+    setup.checkpoint_filename = checkpoint;
+    setup.checkpoint_interval = trade + 1;
+    
+    std::vector<std::string> expected = plain_lines(orders, csv);
+    REQUIRE(count_trade_rows(expected) > 10);
+    std::vector<std::string> lines = run_in_memory(orders, setup, csv);
+    CHECK(lines == expected);
+    
+    // Taken once the trade's F and C were applied
+    OrderBook book(DEFAULT_LADDER, false);
+    uint64_t resume_position = 0;
+    uint64_t resume_rows = 0;
+    REQUIRE(book.load_snapshot(checkpoint, resume_position, resume_rows));
+    CHECK_EQ(resume_position, static_cast<uint64_t>(trade + 3));
+    REQUIRE(resume_rows > 0 && resume_rows < expected.size());
+    
+    std::vector<std::string> resumed = spliced_resume(lines, checkpoint, [&](const RunSetup& resume) {
+        return run_in_memory(orders, resume, csv);
+    });
+    CHECK(resumed == expected);
+    
+    std::remove(checkpoint.c_str());
+}
+
+TEST_CASE(pipeline_trade_across_batches_checkpoint_and_resume) {
+    std::vector<Order> orders = TestData::generate_orders(PARSE_CHUNK_SIZE + 4000);
+    
+    // Pad with side N trades (no-ops for the book) so a T ends the first
+    // batch and its F and C start the second
+    size_t trade = TestData::find_trade(orders, PARSE_CHUNK_SIZE - 200);
+    REQUIRE(trade < PARSE_CHUNK_SIZE);
+    Order neutral = orders[trade];
+    neutral.side = Utils::SIDE_NEUTRAL;
+    orders.insert(orders.begin() + static_cast<std::ptrdiff_t>(trade), PARSE_CHUNK_SIZE - 1 - trade, neutral);
+    trade = PARSE_CHUNK_SIZE - 1;
+    REQUIRE(orders[trade].action == Utils::ACTION_TRADE && orders[trade].side != Utils::SIDE_NEUTRAL);
+    
+    std::string mbo = TestHarness::temp_path("reconstruction_pipeline_mbo.csv");
+    std::string checkpoint = TestHarness::temp_path("reconstruction_pipeline.bin");
+    std::string csv = TestHarness::temp_path("reconstruction_pipeline.csv");
+    REQUIRE(TestData::write_mbo_csv(mbo, orders));
+    
+    std::vector<std::string> expected = plain_lines(orders, csv);
+    CHECK(run_pipelined(mbo, RunSetup(), csv) == expected);
+    
+    RunSetup setup;
+    setup.checkpoint_filename = checkpoint;
+    setup.checkpoint_interval = trade + 1;
+    std::vector<std::string> lines = run_pipelined(mbo, setup, csv);
+    CHECK(lines == expected);
+    
+    OrderBook book(DEFAULT_LADDER, false);
+    uint64_t resume_position = 0;
+    uint64_t resume_rows = 0;
+    REQUIRE(book.load_snapshot(checkpoint, resume_position, resume_rows));
+    CHECK_EQ(resume_position, static_cast<uint64_t>(trade + 3));
+    
+    std::vector<std::string> resumed = spliced_resume(lines, checkpoint, [&](const RunSetup& resume) {
+        return run_pipelined(mbo, resume, csv);
+    });
+    CHECK(resumed == expected);
+    
+    std::remove(mbo.c_str());
+    std::remove(checkpoint.c_str());
+}
+
+TEST_CASE(conflation_closes_a_bucket_in_the_middle_of_a_trade) {
+    // Events are 1us apart; with 5us buckets, move the F and C of some
+    // trades that end a bucket into the next one
+    constexpr int64_t INTERVAL = 5000;
+    std::vector<Order> orders = TestData::generate_orders(6000);
+    size_t split_trades = 0;
+    for (size_t i = TestData::find_trade(orders, 0); i < orders.size(); i = TestData::find_trade(orders, i + 3)) {
+        if (orders[i].ts_event % INTERVAL == INTERVAL - 1000) {
+            for (size_t j = i + 1; j <= i + 2; ++j) {
+                orders[j].ts_event += 1000;
+                orders[j].ts_recv += 1000;
+            }
+            split_trades++;
+        }
+    }
+    REQUIRE(split_trades > 5);
+    
+    // Expected: the last row of each bucket, bucketed by the event that produced it
+    std::vector<OrderBook::MBPRow> rows;
+    OrderBook book(DEFAULT_LADDER, false);
+    int64_t bucket = 0;
+    bool held = false;
+    for (const Order& order : orders) {
+        int64_t order_bucket = order.ts_event / INTERVAL;
+        if (held && order_bucket > bucket) {
+            rows.push_back(book.get_last_mbp_row());
+            held = false;
+        }
+        bucket = order_bucket;
+        held |= book.process_order(order) != nullptr;
+    }
+    if (held) {
+        rows.push_back(book.get_last_mbp_row());
+    }
+    
+    std::string csv = TestHarness::temp_path("reconstruction_conflate.csv");
+    std::vector<std::string> expected = TestData::csv_lines<Utils::MAX_DEPTH>(csv, rows);
+    REQUIRE(count_trade_rows(expected) > 0);
+    
+    RunSetup setup;
+    setup.conflate_interval_ns = INTERVAL;
+    CHECK(run_in_memory(orders, setup, csv) == expected);
+}
+
+TEST_CASE(book_manager_matches_per_instrument_books_with_trades) {
+    // Two instruments interleaved, each with its own trades
+    std::vector<Order> first = TestData::generate_orders(3000, 1);
+    std::vector<Order> second = TestData::generate_orders(3000, 2);
+    std::vector<Order> orders;
+    for (size_t i = 0; i < first.size(); ++i) {
+        orders.push_back(first[i]);
+        second[i].instrument_id = 2208;
+        orders.push_back(second[i]);
+    }
+    
+    std::unordered_map<uint32_t, OrderBook> books;
+    std::vector<OrderBook::MBPRow> rows;
+    for (const Order& order : orders) {
+        auto iter = books.try_emplace(order.instrument_id, DEFAULT_LADDER, false).first;
+        if (const OrderBook::MBPRow* row = iter->second.process_order(order)) {
+            rows.push_back(*row);
+        }
+    }
+    
+    std::string csv = TestHarness::temp_path("reconstruction_books.csv");
+    std::vector<std::string> expected = TestData::csv_lines<Utils::MAX_DEPTH>(csv, rows);
+    REQUIRE(count_trade_rows(expected) > 10);
+    
+    // Odd chunks, so trades keep straddling chunk boundaries
+    {
+        CsvWriter writer(csv);
+        REQUIRE(writer.write_header());
+        BookManager manager(2, DEFAULT_LADDER, writer);
+        for (size_t begin = 0; begin < orders.size(); begin += 7) {
+            std::vector<Order> chunk(orders.begin() + static_cast<std::ptrdiff_t>(begin),
+                                     orders.begin() + static_cast<std::ptrdiff_t>(std::min(begin + 7, orders.size())));
+            REQUIRE(manager.process_orders(chunk));
+        }
+        REQUIRE(manager.finish());
+        REQUIRE(writer.flush());
+    }
+    CHECK(TestData::data_lines(csv) == expected);
+    std::remove(csv.c_str());
+}
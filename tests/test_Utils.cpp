@@ -0,0 +1,185 @@
+#include "TestHarness.hpp"
+#include "TestData.hpp"
+#include "Utils.hpp"
+#include <iterator>
+#include <string>
+
+/**
+ * @file test_Utils.cpp
+ * @brief Table tests for the fixed-point price and timestamp parsers
+ */
+
+namespace {
+    struct PriceCase {
+        const char* text;
+        uint64_t expected;
+    };
+}
+
+TEST_CASE(parse_price_scaled_table) {
+    const PriceCase cases[] = {
+        // Feed layout, 9 decimals (fast path)
+        {"5.510000000", 5510000000ULL},
+        {"21.330000000", 21330000000ULL},
+        {"0.000000001", 1ULL},
+        {".123456789", 123456789ULL},
+        {"9999999999.999999999", 9999999999999999999ULL},
+        {"5.51000000x", 0},
+        {"5.5100000.0", 0},
+        
+        // Shorter and missing fractions (general path)
+        {"5.51", 5510000000ULL},
+        {"5.5", 5500000000ULL},
+        {"5", 5000000000ULL},
+        {"5.", 5000000000ULL},
+        {".5", 500000000ULL},
+        {"0", 0},
+        
+        // 10th decimal rounds half-up; later digits are ignored
+        {"1.0000000004", 1000000000ULL},
+        {"1.0000000005", 1000000001ULL},
+        {"1.00000000049999", 1000000000ULL},
+        {"1.9999999995", 2000000000ULL},
+        
+        // Signs
+        {"+5.51", 5510000000ULL},
+        {"+5.510000000", 5510000000ULL},
+        {"+", 0},
+        {"+.", 0},
+        {"-5.51", 0},
+        {"++5", 0},
+        
+        // Malformed
+        {"", 0},
+        {".", 0},
+        {"5.5.5", 0},
+        {"5,51", 0},
+        {"1e9", 0},
+        {"5.51 ", 0},
+        {"abc", 0},
+        
+        // Integer part limited to 10 digits so the scaled value cannot wrap
+        {"9999999999", 9999999999000000000ULL},
+        {"18446744074", 0},
+        {"12345678901.5", 0},
+        {"12345678901.000000000", 0},
+        {"00000000001", 0},
+    };
+    
+    for (const PriceCase& test : cases) {
+        uint64_t parsed = Utils::parse_price_scaled(test.text);
+        if (parsed != test.expected) {
+            TestHarness::record_failure(__FILE__, __LINE__, std::string("parse_price_scaled(\"") + test.text + "\") = " +
+                                        std::to_string(parsed) + ", expected " + std::to_string(test.expected));
+        }
+    }
+}
+
+namespace {
+    struct TimestampCase {
+        const char* text;
+        int64_t expected;
+    };
+    
+    constexpr int64_t SECOND = 1000000000LL;
+    constexpr int64_t DAY = 86400 * SECOND;
+    
+    void check_timestamps(const TimestampCase* begin, const TimestampCase* end, int line) {
+        for (const TimestampCase* test = begin; test != end; ++test) {
+            int64_t parsed = Utils::parse_timestamp_ns(test->text);
+            if (parsed != test->expected) {
+                TestHarness::record_failure(__FILE__, line, std::string("parse_timestamp_ns(\"") + test->text +
+                                            "\") = " + std::to_string(parsed) + ", expected " +
+                                            std::to_string(test->expected));
+            }
+        }
+    }
+}
+
+TEST_CASE(parse_timestamp_ns_fixed_layout_table) {
+    const int64_t start = TestData::START_TS;
+    const TimestampCase cases[] = {
+        // 9 decimals, 30 characters
+        {"2025-07-17T08:00:00.000000000Z", start},
+        {"2025-07-17T08:00:00.000000001Z", start + 1},
+        {"2025-07-17T08:00:00.123456789Z", start + 123456789},
+        {"2025-07-17T08:00:01.999999999Z", start + 2 * SECOND - 1},
+        {"1970-01-01T00:00:00.000000001Z", 1},
+        
+        // Day of month, leap years included
+        {"2024-02-29T00:00:00.000000000Z", Utils::parse_timestamp_ns("2024-03-01T00:00:00.000000000Z") - DAY},
+        {"2000-02-29T00:00:00.000000000Z", Utils::parse_timestamp_ns("2000-03-01T00:00:00.000000000Z") - DAY},
+        {"2025-07-31T08:00:00.000000000Z", start + 14 * DAY},
+        {"2025-02-29T00:00:00.000000000Z", 0},
+        {"1900-02-29T00:00:00.000000000Z", 0},
+        {"2024-02-30T00:00:00.000000000Z", 0},
+        {"2025-02-31T00:00:00.000000000Z", 0},
+        {"2025-04-31T00:00:00.000000000Z", 0},
+        {"2025-07-32T00:00:00.000000000Z", 0},
+        {"2025-07-00T00:00:00.000000000Z", 0},
+        {"2025-00-17T00:00:00.000000000Z", 0},
+        {"2025-13-17T00:00:00.000000000Z", 0},
+        
+        // Leap second folds into the next minute; :61 does not exist
+        {"2025-07-17T07:59:60.000000000Z", start},
+        {"2025-07-17T07:59:61.000000000Z", 0},
+        {"2025-07-17T24:00:00.000000000Z", 0},
+        {"2025-07-17T08:60:00.000000000Z", 0},
+        
+        // Malformed separators and digits
+        {"2025/07/17T08:00:00.000000000Z", 0},
+        {"2025-07-17 08:00:00.000000000Z", 0},
+        {"2025-07-17T08-00-00.000000000Z", 0},
+        {"2025-07-17T08:00:00,000000000Z", 0},
+        {"2025-07-17T08:00:00.000000000z", 0},
+        {"2025-07-17T08:00:00.0000000000", 0},
+        {"2025-07-17T08:00:00.0000000x0Z", 0},
+        {"+025-07-17T08:00:00.000000000Z", 0},
+        {"2025-+7-17T08:00:00.000000000Z", 0},
+    };
+    
+    check_timestamps(std::begin(cases), std::end(cases), __LINE__);
+}
+
+TEST_CASE(parse_timestamp_ns_general_layout_table) {
+    const int64_t start = TestData::START_TS;
+    const TimestampCase cases[] = {
+        // Shorter fractions and none at all
+        {"2025-07-17T08:00:00.12345678Z", start + 123456780},
+        {"2025-07-17T08:00:00.5Z", start + 500000000},
+        {"2025-07-17T08:00:00Z", start},
+        {"2025-07-17T07:59:59.9Z", start - 100000000},
+        
+        // Day of month, leap years included
+        {"2024-02-29T00:00:00Z", Utils::parse_timestamp_ns("2024-03-01T00:00:00Z") - DAY},
+        {"2024-02-29T00:00:00.5Z", Utils::parse_timestamp_ns("2024-03-01T00:00:00Z") - DAY + 500000000},
+        {"2025-02-29T00:00:00Z", 0},
+        {"1900-02-29T00:00:00.5Z", 0},
+        {"2025-02-31T00:00:00Z", 0},
+        {"2025-04-31T00:00:00.25Z", 0},
+        
+        // Leap second
+        {"2025-07-17T07:59:60Z", start},
+        {"2025-07-17T07:59:60.5Z", start + 500000000},
+        {"2025-07-17T07:59:61Z", 0},
+        
+        // A '.' needs at least one digit, and at most 9
+        {"2025-07-17T08:00:00.Z", 0},
+        {"2025-07-17T08:00:00.1234567890Z", 0},
+        {"2025-07-17T08:00:00.+5Z", 0},
+        {"2025-07-17T08:00:00.-5Z", 0},
+        
+        // Malformed separators
+        {"2025/07/17T08:00:00Z", 0},
+        {"2025-07-17 08:00:00Z", 0},
+        {"2025-07-17T08:00:00", 0},
+        {"2025-07-17T08:00:00.5", 0},
+        {"2025-07-17T08:00:00,5Z", 0},
+        {"2025-07-17T08.00:00Z", 0},
+        {"+2025-07-17T08:00:00Z", 0},
+        {"2025-07-17", 0},
+        {"", 0},
+    };
+    
+    check_timestamps(std::begin(cases), std::end(cases), __LINE__);
+}
@@ -0,0 +1,81 @@
+#include "TestHarness.hpp"
+#include <filesystem>
+#include <exception>
+#include <streambuf>
+
+/**
+ * @file test_main.cpp
+ * @brief Test runner: executes every TEST_CASE and reports failures
+ * 
+ * The components under test log to std::cout; that output is discarded
+ * while a test runs so the report stays readable. Failures go to std::cerr.
+ * 
+ * Usage: ./run_tests [name_filter]
+ */
+
+namespace {
+    /**
+     * @brief Stream buffer that drops everything written to it
+     */
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int character) override { return character; }
+        std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+    };
+    
+    const char* current_test = "";
+    size_t current_failures = 0;
+}
+
+namespace TestHarness {
+    std::vector<TestCase>& registry() {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+    
+    void record_failure(const char* file, int line, const std::string& message) {
+        current_failures++;
+        std::cerr << "  FAILED " << current_test << " at " << file << ":" << line << ": " << message << std::endl;
+    }
+    
+    std::string temp_path(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / ("mbp_test_" + name)).string();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter = argc >= 2 ? argv[1] : "";
+    
+    NullBuffer null_buffer;
+    std::streambuf* console = std::cout.rdbuf();
+    size_t run = 0;
+    size_t failed = 0;
+    
+    for (const TestHarness::TestCase& test : TestHarness::registry()) {
+        if (!filter.empty() && std::string(test.name).find(filter) == std::string::npos) {
+            continue;
+        }
+        
+        current_test = test.name;
+        current_failures = 0;
+        
+        std::cout.rdbuf(&null_buffer);
+        try {
+            test.function();
+        } catch (const TestHarness::RequireFailed&) {
+            // Already recorded
+        } catch (const std::exception& e) {
+            TestHarness::record_failure(__FILE__, __LINE__, std::string("unexpected exception: ") + e.what());
+        }
+        std::cout.rdbuf(console);
+        
+        run++;
+        if (current_failures != 0) {
+            failed++;
+        }
+        std::cout << (current_failures == 0 ? "[ OK ] " : "[FAIL] ") << test.name << std::endl;
+    }
+    
+    std::cout << "\n" << run - failed << "/" << run << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}